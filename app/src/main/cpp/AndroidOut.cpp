@@ -1,4 +0,0 @@
-#include "AndroidOut.h"
-
-AndroidOut androidOut("AO");
-std::ostream aout(&androidOut);
\ No newline at end of file
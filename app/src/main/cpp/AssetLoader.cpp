@@ -0,0 +1,90 @@
+#include "AssetLoader.h"
+
+AssetLoader::AssetLoader() : worker_(&AssetLoader::workerLoop, this) {}
+
+AssetLoader::~AssetLoader() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        jobs_.clear();
+        uploads_.clear();
+    }
+    wake_.notify_all();
+    worker_.join();
+}
+
+AssetHandle AssetLoader::load(DecodeFunction decode, UploadFunction upload) {
+    AssetHandle handle;
+    handle.state_ = std::make_shared<AssetHandle::State>();
+
+    pending_.fetch_add(1, std::memory_order_acq_rel);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        jobs_.push_back({std::move(decode), std::move(upload), handle.state_});
+    }
+    wake_.notify_one();
+    return handle;
+}
+
+size_t AssetLoader::pumpUploads(size_t maxUploads) {
+    size_t done = 0;
+    while (done < maxUploads) {
+        Job job;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (uploads_.empty()) {
+                break;
+            }
+            job = std::move(uploads_.front());
+            uploads_.pop_front();
+        }
+
+        job.upload();
+        finish(job, AssetHandle::Status::LOADED);
+        done++;
+    }
+    return done;
+}
+
+void AssetLoader::waitForDecodes() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this] { return stopping_ || (jobs_.empty() && !decoding_); });
+}
+
+void AssetLoader::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        wake_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+        if (stopping_) {
+            break;
+        }
+
+        Job job = std::move(jobs_.front());
+        jobs_.pop_front();
+        decoding_ = true;
+
+        // Dekodieren ohne Lock, damit der Render-Thread weiter Aufträge einreihen und Uploads holen kann
+        lock.unlock();
+        bool ok = job.decode ? job.decode() : true;
+        lock.lock();
+
+        decoding_ = false;
+        if (!ok) {
+            finish(job, AssetHandle::Status::FAILED);
+        } else if (job.upload) {
+            uploads_.push_back(std::move(job));
+        } else {
+            finish(job, AssetHandle::Status::LOADED);
+        }
+
+        if (jobs_.empty()) {
+            idle_.notify_all();
+        }
+    }
+    idle_.notify_all();
+}
+
+void AssetLoader::finish(Job& job, AssetHandle::Status status) {
+    job.state->status.store(status, std::memory_order_release);
+    pending_.fetch_sub(1, std::memory_order_acq_rel);
+}
@@ -0,0 +1,107 @@
+#ifndef CODINI_ASSET_LOADER_H
+#define CODINI_ASSET_LOADER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+/*!
+ * Handle auf einen Ladeauftrag, das Spiel fragt damit pro Frame den Stand ab.
+ */
+class AssetHandle {
+public:
+    enum class Status : uint8_t {
+        PENDING,  // Wird gelesen/dekodiert oder wartet auf den Upload
+        LOADED,   // Fertig und benutzbar
+        FAILED    // Dekodieren fehlgeschlagen, es gab keinen Upload
+    };
+
+    bool isValid() const { return state_ != nullptr; }
+    Status getStatus() const { return state_ ? state_->status.load(std::memory_order_acquire) : Status::FAILED; }
+    bool isDone() const { return getStatus() != Status::PENDING; }
+    bool isLoaded() const { return getStatus() == Status::LOADED; }
+
+private:
+    friend class AssetLoader;
+
+    struct State {
+        std::atomic<Status> status{Status::PENDING};
+    };
+
+    std::shared_ptr<State> state_;
+};
+
+/*!
+ * Lädt Assets auf einem eigenen Worker-Thread. Ein Auftrag besteht aus zwei Teilen: decode läuft
+ * auf dem Worker (Datei lesen, PNG/WAV dekodieren, Atlas zusammensetzen) und upload danach auf dem
+ * Render-Thread, wenn dieser pumpUploads aufruft (GL-Upload, Ergebnis veröffentlichen). So bleiben
+ * alle GL-Aufrufe auf dem Thread mit dem Kontext und der Frame wartet nie auf Datei-I/O.
+ *
+ * Beim Zerstören werden noch nicht begonnene Aufträge verworfen; ein laufender decode wird
+ * abgewartet, ausstehende Uploads verfallen.
+ */
+class AssetLoader {
+public:
+    using DecodeFunction = std::function<bool()>;
+    using UploadFunction = std::function<void()>;
+
+    AssetLoader();
+    ~AssetLoader();
+
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+
+    /*!
+     * Reiht einen Ladeauftrag ein.
+     * @param decode läuft auf dem Worker, false markiert den Auftrag als fehlgeschlagen
+     * @param upload läuft nach erfolgreichem decode im nächsten pumpUploads, darf leer sein
+     */
+    AssetHandle load(DecodeFunction decode, UploadFunction upload = nullptr);
+
+    /*!
+     * Führt fertige Uploads auf dem aufrufenden (Render-)Thread aus.
+     * @param maxUploads Obergrenze pro Aufruf, damit große Uploads sich auf Frames verteilen
+     * @return Anzahl ausgeführter Uploads
+     */
+    size_t pumpUploads(size_t maxUploads = SIZE_MAX);
+
+    /*!
+     * Blockiert, bis der Worker alle Aufträge dekodiert hat. Uploads bleiben liegen.
+     */
+    void waitForDecodes();
+
+    /*!
+     * @return Aufträge, die noch nicht LOADED oder FAILED sind
+     */
+    size_t getPendingCount() const { return pending_.load(std::memory_order_acquire); }
+
+private:
+    struct Job {
+        DecodeFunction decode;
+        UploadFunction upload;
+        std::shared_ptr<AssetHandle::State> state;
+    };
+
+    void workerLoop();
+    void finish(Job& job, AssetHandle::Status status);
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable idle_;
+    std::deque<Job> jobs_;
+    std::deque<Job> uploads_;
+    bool decoding_ = false;
+    bool stopping_ = false;
+    std::atomic<size_t> pending_{0};
+
+    // Zuletzt, damit alle anderen Member beim Start des Threads schon existieren
+    std::thread worker_;
+};
+
+#endif //CODINI_ASSET_LOADER_H
@@ -0,0 +1,145 @@
+#include "AudioManager.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "Log.h"
+
+namespace {
+    constexpr int32_t kOutputChannels = 2;
+
+    bool readAsset(AAssetManager* assetManager, const std::string& path, std::vector<uint8_t>& out) {
+        AAsset* asset = AAssetManager_open(assetManager, path.c_str(), AASSET_MODE_BUFFER);
+        if (!asset) {
+            return false;
+        }
+        out.resize(static_cast<size_t>(AAsset_getLength64(asset)));
+        bool ok = AAsset_read(asset, out.data(), out.size()) == static_cast<int>(out.size());
+        AAsset_close(asset);
+        return ok;
+    }
+}
+
+AudioManager::AudioManager(AAssetManager* assetManager, AssetLoader& loader)
+        : assetManager_(assetManager), loader_(loader) {
+    AAudioStreamBuilder* builder = nullptr;
+    if (AAudio_createStreamBuilder(&builder) != AAUDIO_OK) {
+        LOG_W("AAudio not available, sounds are disabled");
+        return;
+    }
+    AAudioStreamBuilder_setFormat(builder, AAUDIO_FORMAT_PCM_I16);
+    AAudioStreamBuilder_setChannelCount(builder, kOutputChannels);
+    AAudioStreamBuilder_setPerformanceMode(builder, AAUDIO_PERFORMANCE_MODE_LOW_LATENCY);
+    AAudioStreamBuilder_setDataCallback(builder, &AudioManager::dataCallback, this);
+
+    if (AAudioStreamBuilder_openStream(builder, &stream_) == AAUDIO_OK) {
+        sampleRate_ = AAudioStream_getSampleRate(stream_);
+        AAudioStream_requestStart(stream_);
+    } else {
+        LOG_E("Failed to open audio stream");
+        stream_ = nullptr;
+    }
+    AAudioStreamBuilder_delete(builder);
+}
+
+AudioManager::~AudioManager() {
+    if (stream_) {
+        AAudioStream_requestStop(stream_);
+        AAudioStream_close(stream_);
+        stream_ = nullptr;
+    }
+}
+
+AssetHandle AudioManager::loadSound(const std::string& name, const std::string& assetPath) {
+    auto sound = std::make_shared<Sound>();
+    AAssetManager* assetManager = assetManager_;
+    return loader_.load(
+            [assetManager, assetPath, sound]() {
+                std::vector<uint8_t> bytes;
+                return readAsset(assetManager, assetPath, bytes)
+                       && decodeWav(bytes.data(), bytes.size(), *sound);
+            },
+            [this, name, sound]() {
+                sounds_[name] = sound;
+            });
+}
+
+void AudioManager::playSound(const std::string& name, float volume, float delay) {
+    auto it = sounds_.find(name);
+    if (it == sounds_.end() || !stream_) {
+        return;
+    }
+
+    Voice voice;
+    voice.sound = it->second;
+    voice.step = (static_cast<uint64_t>(it->second->sampleRate) << 32) / static_cast<uint64_t>(sampleRate_);
+    voice.delayFrames = static_cast<int32_t>(std::max(delay, 0.0f) * sampleRate_);
+    voice.volume = std::min(std::max(volume, 0.0f), 1.0f);
+    voice.active = true;
+
+    // Abgelaufene Sounds werden hier auf dem Spiel-Thread freigegeben, erst nach dem Entsperren,
+    // damit der Callback nicht länger als nötig auf die Stimmen wartet
+    std::array<std::shared_ptr<const Sound>, kMaxVoices> released;
+    std::lock_guard<std::mutex> lock(voiceMutex_);
+    // Freie Stimme nehmen, sonst die am weitesten fortgeschrittene ersetzen
+    size_t target = 0;
+    for (size_t i = 0; i < voices_.size(); i++) {
+        Voice& slot = voices_[i];
+        if (!slot.active) {
+            released[i] = std::move(slot.sound);
+            if (voices_[target].active) {
+                target = i;
+            }
+        } else if (voices_[target].active && slot.position > voices_[target].position) {
+            target = i;
+        }
+    }
+    released[target] = std::move(voices_[target].sound);
+    voices_[target] = std::move(voice);
+}
+
+aaudio_data_callback_result_t AudioManager::dataCallback(AAudioStream*, void* userData,
+                                                         void* audioData, int32_t numFrames) {
+    static_cast<AudioManager*>(userData)->mix(static_cast<int16_t*>(audioData), numFrames);
+    return AAUDIO_CALLBACK_RESULT_CONTINUE;
+}
+
+void AudioManager::mix(int16_t* output, int32_t frames) {
+    std::memset(output, 0, sizeof(int16_t) * frames * kOutputChannels);
+
+    // Nicht auf den Spiel-Thread warten, dann bleibt dieser Block eben still
+    std::unique_lock<std::mutex> lock(voiceMutex_, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        return;
+    }
+
+    for (auto& voice : voices_) {
+        if (!voice.active) {
+            continue;
+        }
+        const Sound& sound = *voice.sound;
+        const size_t frameCount = sound.getFrameCount();
+        const int32_t gain = static_cast<int32_t>(voice.volume * 256.0f);
+
+        for (int32_t i = 0; i < frames; i++) {
+            if (voice.delayFrames > 0) {
+                voice.delayFrames--;
+                continue;
+            }
+            size_t frame = static_cast<size_t>(voice.position >> 32);
+            if (frame >= frameCount) {
+                // Nur abmelden, den Sound gibt playSound auf dem Spiel-Thread frei
+                voice.active = false;
+                break;
+            }
+            int32_t left = sound.samples[frame * sound.channels];
+            int32_t right = sound.channels > 1 ? sound.samples[frame * sound.channels + 1] : left;
+
+            int16_t* out = output + i * kOutputChannels;
+            out[0] = static_cast<int16_t>(std::clamp(out[0] + (left * gain >> 8), -32768, 32767));
+            out[1] = static_cast<int16_t>(std::clamp(out[1] + (right * gain >> 8), -32768, 32767));
+            voice.position += voice.step;
+        }
+    }
+}
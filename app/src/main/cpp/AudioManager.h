@@ -0,0 +1,73 @@
+#ifndef CODINI_AUDIO_MANAGER_H
+#define CODINI_AUDIO_MANAGER_H
+
+#include <aaudio/AAudio.h>
+#include <android/asset_manager.h>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "AssetLoader.h"
+#include "WavDecoder.h"
+
+/*!
+ * Spielt kurze Soundeffekte über einen AAudio-Stream. WAV-Dateien werden über den AssetLoader im
+ * Hintergrund gelesen und dekodiert; ein Sound, der noch lädt, wird beim Abspielen übersprungen.
+ * Bis zu kMaxVoices Sounds werden gleichzeitig gemischt.
+ */
+class AudioManager {
+public:
+    static constexpr size_t kMaxVoices = 16;
+
+    AudioManager(AAssetManager* assetManager, AssetLoader& loader);
+    ~AudioManager();
+
+    AudioManager(const AudioManager&) = delete;
+    AudioManager& operator=(const AudioManager&) = delete;
+
+    /*!
+     * Lädt einen Sound im Hintergrund, kehrt sofort zurück.
+     */
+    AssetHandle loadSound(const std::string& name, const std::string& assetPath);
+
+    /*!
+     * @param volume Lautstärke 0..1
+     * @param delay Verzögerung in Sekunden
+     */
+    void playSound(const std::string& name, float volume = 1.0f, float delay = 0.0f);
+
+    bool isLoaded(const std::string& name) const { return sounds_.count(name) != 0; }
+
+private:
+    // Der Audio-Callback setzt nur active zurück. sound gibt allein der Spiel-Thread frei, sonst
+    // könnte das letzte shared_ptr auf einen ersetzten Sound im Echtzeit-Thread verschwinden.
+    struct Voice {
+        std::shared_ptr<const Sound> sound;
+        bool active = false;
+        uint64_t position = 0;  // 32.32 Festkomma, in Frames des Sounds
+        uint64_t step = 0;      // Vorschub pro Ausgabe-Frame
+        int32_t delayFrames = 0;
+        float volume = 1.0f;
+    };
+
+    static aaudio_data_callback_result_t dataCallback(AAudioStream* stream, void* userData,
+                                                      void* audioData, int32_t numFrames);
+    void mix(int16_t* output, int32_t frames);
+
+    AAssetManager* assetManager_;
+    AssetLoader& loader_;
+
+    // Nur auf dem Spiel-Thread benutzt, die Sounds selbst sind unveränderlich
+    std::unordered_map<std::string, std::shared_ptr<const Sound>> sounds_;
+
+    std::mutex voiceMutex_;
+    std::array<Voice, kMaxVoices> voices_;
+
+    AAudioStream* stream_ = nullptr;
+    int32_t sampleRate_ = 48000;
+};
+
+#endif //CODINI_AUDIO_MANAGER_H
@@ -0,0 +1,202 @@
+#include "Bytecode.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+// Aufrufstelle im Bytecode und die volle Funktionsnummer, die in Instruction::arg nicht passt
+using CallSite = std::pair<size_t, int>;
+
+struct FunctionBody {
+    int id;
+    size_t begin;  // Index des ersten Befehls nach FUNCTION_DEF
+    size_t end;    // Index von FUNCTION_END
+    uint16_t entry;
+};
+
+bool isAction(CommandType type) {
+    switch (type) {
+        case CommandType::MOVE_FORWARD:
+        case CommandType::TURN_LEFT:
+        case CommandType::TURN_RIGHT:
+        case CommandType::JUMP:
+        case CommandType::MOVE_BACKWARD:
+        case CommandType::PICK_ITEM:
+        case CommandType::USE_ITEM:
+        case CommandType::TELEPORT:
+        case CommandType::CREATE_BRIDGE:
+        case CommandType::ACTIVATE_SWITCH:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/*!
+ * Übersetzt einen zusammenhängenden Abschnitt (Hauptprogramm oder Funktionsrumpf). Schleifen und
+ * If-Blöcke müssen innerhalb des Abschnitts geschlossen werden.
+ */
+bool emitSegment(const std::vector<Command>& commands, size_t begin, size_t end,
+                 std::vector<Instruction>& code, std::vector<CallSite>& callSites,
+                 std::string& error) {
+    // Offene Blöcke: Index der öffnenden Instruktion
+    std::vector<std::pair<CommandType, size_t>> openBlocks;
+
+    for (size_t i = begin; i < end; i++) {
+        const Command& cmd = commands[i];
+
+        if (isAction(cmd.type)) {
+            code.push_back({OpCode::ACTION, static_cast<int16_t>(cmd.type), 0});
+            continue;
+        }
+
+        switch (cmd.type) {
+            case CommandType::LOOP_START:
+                if (cmd.loopCount < 0 || cmd.loopCount > ProgramCompiler::kMaxLoopCount) {
+                    error = "Ungültige Anzahl Wiederholungen";
+                    return false;
+                }
+                if (openBlocks.size() >= ProgramVM::kMaxLoopDepth) {
+                    error = "Zu tief verschachtelt";
+                    return false;
+                }
+                openBlocks.emplace_back(CommandType::LOOP_START, code.size());
+                code.push_back({OpCode::LOOP_ENTER, static_cast<int16_t>(cmd.loopCount), 0});
+                break;
+
+            case CommandType::LOOP_END: {
+                if (openBlocks.empty() || openBlocks.back().first != CommandType::LOOP_START) {
+                    error = "Schleifenende ohne Schleifenbeginn";
+                    return false;
+                }
+                size_t enter = openBlocks.back().second;
+                openBlocks.pop_back();
+                code.push_back({OpCode::LOOP_NEXT, 0, static_cast<uint16_t>(enter + 1)});
+                code[enter].target = static_cast<uint16_t>(code.size());
+                break;
+            }
+
+            case CommandType::IF_PATH_AHEAD:
+            case CommandType::IF_TARGET_NEARBY:
+                openBlocks.emplace_back(cmd.type, code.size());
+                code.push_back({cmd.type == CommandType::IF_PATH_AHEAD
+                                ? OpCode::BRANCH_UNLESS_PATH
+                                : OpCode::BRANCH_UNLESS_TARGET, 0, 0});
+                break;
+
+            case CommandType::IF_END: {
+                if (openBlocks.empty() || openBlocks.back().first == CommandType::LOOP_START) {
+                    error = "If-Ende ohne Bedingung";
+                    return false;
+                }
+                code[openBlocks.back().second].target = static_cast<uint16_t>(code.size());
+                openBlocks.pop_back();
+                break;
+            }
+
+            case CommandType::FUNCTION_CALL:
+                callSites.emplace_back(code.size(), cmd.functionId);
+                code.push_back({OpCode::CALL, 0, 0});
+                break;
+
+            case CommandType::FUNCTION_DEF:
+                error = "Funktionen dürfen nicht verschachtelt werden";
+                return false;
+
+            case CommandType::FUNCTION_END:
+                error = "Funktionsende ohne Funktionsdefinition";
+                return false;
+
+            default:
+                break;
+        }
+
+        if (code.size() >= ProgramCompiler::kMaxProgramSize) {
+            error = "Programm zu lang";
+            return false;
+        }
+    }
+
+    if (!openBlocks.empty()) {
+        error = openBlocks.back().first == CommandType::LOOP_START
+                ? "Schleife wurde nicht geschlossen"
+                : "Bedingung wurde nicht geschlossen";
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+bool ProgramCompiler::compile(const std::vector<Command>& commands, Program& outProgram) {
+    outProgram.code.clear();
+    outProgram.error.clear();
+    outProgram.sourceCommandCount = static_cast<int>(commands.size());
+
+    // Funktionsrümpfe aus dem Hauptprogramm heraustrennen
+    std::vector<FunctionBody> functions;
+    std::vector<std::pair<size_t, size_t>> mainRanges;
+    size_t rangeBegin = 0;
+    for (size_t i = 0; i < commands.size(); i++) {
+        if (commands[i].type != CommandType::FUNCTION_DEF) {
+            continue;
+        }
+        size_t end = i + 1;
+        while (end < commands.size() &&
+               commands[end].type != CommandType::FUNCTION_END &&
+               commands[end].type != CommandType::FUNCTION_DEF) {
+            end++;
+        }
+        if (end == commands.size() || commands[end].type != CommandType::FUNCTION_END) {
+            outProgram.error = "Funktion wurde nicht geschlossen";
+            return false;
+        }
+        int id = commands[i].functionId;
+        if (std::any_of(functions.begin(), functions.end(),
+                        [id](const FunctionBody& f) { return f.id == id; })) {
+            outProgram.error = "Funktion mehrfach definiert";
+            return false;
+        }
+        functions.push_back({id, i + 1, end, 0});
+        mainRanges.emplace_back(rangeBegin, i);
+        rangeBegin = end + 1;
+        i = end;
+    }
+    mainRanges.emplace_back(rangeBegin, commands.size());
+
+    std::vector<CallSite> callSites;
+    for (const auto& range : mainRanges) {
+        if (!emitSegment(commands, range.first, range.second,
+                         outProgram.code, callSites, outProgram.error)) {
+            outProgram.code.clear();
+            return false;
+        }
+    }
+    outProgram.code.push_back({OpCode::HALT, 0, 0});
+
+    for (auto& function : functions) {
+        function.entry = static_cast<uint16_t>(outProgram.code.size());
+        if (!emitSegment(commands, function.begin, function.end,
+                         outProgram.code, callSites, outProgram.error)) {
+            outProgram.code.clear();
+            return false;
+        }
+        outProgram.code.push_back({OpCode::RETURN, 0, 0});
+    }
+
+    // Aufrufe auf die Einsprungadressen auflösen
+    for (const CallSite& site : callSites) {
+        int id = site.second;
+        auto it = std::find_if(functions.begin(), functions.end(),
+                               [id](const FunctionBody& f) { return f.id == id; });
+        if (it == functions.end()) {
+            outProgram.error = "Aufruf einer unbekannten Funktion";
+            outProgram.code.clear();
+            return false;
+        }
+        outProgram.code[site.first].target = it->entry;
+    }
+
+    return true;
+}
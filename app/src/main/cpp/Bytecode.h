@@ -0,0 +1,177 @@
+#ifndef CODINI_BYTECODE_H
+#define CODINI_BYTECODE_H
+
+#include "Command.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Befehlssatz der Codini-VM
+enum class OpCode : uint8_t {
+    ACTION,          // Bewegungs-/Aktionsbefehl ausführen (arg = CommandType)
+    LOOP_ENTER,      // Schleifenzähler anlegen (arg = Anzahl, target = hinter LOOP_NEXT)
+    LOOP_NEXT,       // Zähler verringern, bei > 0 nach target springen
+    BRANCH_UNLESS_PATH,   // Nach target springen, wenn kein Weg frei ist
+    BRANCH_UNLESS_TARGET, // Nach target springen, wenn kein Ziel in der Nähe ist
+    CALL,            // Funktion aufrufen (target = Einsprung)
+    RETURN,          // Aus Funktion zurückkehren
+    HALT             // Programmende
+};
+
+struct Instruction {
+    OpCode op;
+    int16_t arg;
+    uint16_t target;
+};
+
+// Übersetztes Programm: Hauptprogramm, HALT, danach alle Funktionsrümpfe
+struct Program {
+    std::vector<Instruction> code;
+    int sourceCommandCount = 0;  // Anzahl eingegebener Befehle (für die Punktewertung)
+    std::string error;           // Fehlermeldung, falls die Übersetzung fehlschlug
+};
+
+class ProgramCompiler {
+public:
+    static constexpr int kMaxLoopCount = 999;
+    static constexpr size_t kMaxProgramSize = 0xFFFF;
+
+    /*!
+     * Übersetzt eine Befehlsliste in Bytecode. Schleifen, If-Blöcke und Funktionsaufrufe werden
+     * zu Sprüngen mit aufgelösten Zieladressen.
+     *
+     * @param commands die eingegebenen Befehle
+     * @param outProgram wird mit dem Bytecode gefüllt, bei Fehlern steht der Grund in error
+     * @return true, wenn das Programm gültig ist
+     */
+    static bool compile(const std::vector<Command>& commands, Program& outProgram);
+};
+
+/*!
+ * Kleine Stack-VM für übersetzte Programme. Der gesamte Zustand liegt in festen Arrays, ein
+ * Schritt allokiert also keinen Speicher. Kontrollbefehle (Schleifen, Bedingungen, Aufrufe)
+ * werden innerhalb von next() abgearbeitet, bis die nächste Aktion feststeht.
+ */
+class ProgramVM {
+public:
+    static constexpr int kMaxLoopDepth = 16;
+    static constexpr int kMaxCallDepth = 16;
+    // Kontrollbefehle pro next() ohne Aktion, darüber gilt das Programm als Endlosschleife
+    static constexpr int kMaxControlSteps = 100000;
+
+    enum class State : uint8_t {
+        IDLE,       // Kein Programm geladen
+        RUNNING,    // Programm läuft
+        FINISHED,   // HALT erreicht
+        FAULTED     // Stacküberlauf (z.B. endlose Rekursion) oder Schleifen ohne Aktion
+    };
+
+    void reset(const Program& program) {
+        code_ = program.code.data();
+        pc_ = 0;
+        loopDepth_ = 0;
+        callDepth_ = 0;
+        executedActions_ = 0;
+        state_ = program.code.empty() ? State::IDLE : State::RUNNING;
+    }
+
+    void halt() {
+        code_ = nullptr;
+        state_ = State::IDLE;
+    }
+
+    /*!
+     * Führt Kontrollbefehle aus, bis die nächste Aktion erreicht ist. Folgen mehr als
+     * kMaxControlSteps Kontrollbefehle ohne Aktion (z.B. verschachtelte Schleifen um einen
+     * leeren Rumpf), bricht die VM mit FAULTED ab, statt den Aufrufer zu blockieren.
+     *
+     * @param env liefert die Bedingungen, braucht isPathAhead() und isTargetNearby()
+     * @param outAction die auszuführende Aktion
+     * @return false, wenn das Programm beendet ist
+     */
+    template<typename Env>
+    bool next(Env& env, CommandType& outAction) {
+        if (state_ != State::RUNNING) {
+            return false;
+        }
+
+        for (int steps = 0;; steps++) {
+            if (steps == kMaxControlSteps) {
+                state_ = State::FAULTED;
+                return false;
+            }
+            const Instruction& in = code_[pc_];
+            switch (in.op) {
+                case OpCode::ACTION:
+                    outAction = static_cast<CommandType>(in.arg);
+                    ++pc_;
+                    ++executedActions_;
+                    return true;
+
+                case OpCode::LOOP_ENTER:
+                    if (in.arg <= 0) {
+                        pc_ = in.target;
+                        break;
+                    }
+                    if (loopDepth_ == kMaxLoopDepth) {
+                        state_ = State::FAULTED;
+                        return false;
+                    }
+                    loopCounters_[loopDepth_++] = in.arg;
+                    ++pc_;
+                    break;
+
+                case OpCode::LOOP_NEXT:
+                    if (--loopCounters_[loopDepth_ - 1] > 0) {
+                        pc_ = in.target;
+                    } else {
+                        --loopDepth_;
+                        ++pc_;
+                    }
+                    break;
+
+                case OpCode::BRANCH_UNLESS_PATH:
+                    pc_ = env.isPathAhead() ? pc_ + 1 : in.target;
+                    break;
+
+                case OpCode::BRANCH_UNLESS_TARGET:
+                    pc_ = env.isTargetNearby() ? pc_ + 1 : in.target;
+                    break;
+
+                case OpCode::CALL:
+                    if (callDepth_ == kMaxCallDepth) {
+                        state_ = State::FAULTED;
+                        return false;
+                    }
+                    callStack_[callDepth_++] = static_cast<uint16_t>(pc_ + 1);
+                    pc_ = in.target;
+                    break;
+
+                case OpCode::RETURN:
+                    pc_ = callStack_[--callDepth_];
+                    break;
+
+                case OpCode::HALT:
+                    state_ = State::FINISHED;
+                    return false;
+            }
+        }
+    }
+
+    State getState() const { return state_; }
+    bool isRunning() const { return state_ == State::RUNNING; }
+    bool hasFaulted() const { return state_ == State::FAULTED; }
+    int getExecutedActions() const { return executedActions_; }
+
+private:
+    const Instruction* code_ = nullptr;
+    uint32_t pc_ = 0;
+    int loopDepth_ = 0;
+    int callDepth_ = 0;
+    int executedActions_ = 0;
+    State state_ = State::IDLE;
+    int loopCounters_[kMaxLoopDepth];
+    uint16_t callStack_[kMaxCallDepth];
+};
+
+#endif //CODINI_BYTECODE_H
@@ -0,0 +1,115 @@
+#include "Command.h"
+
+#include <cstdlib>
+#include <sstream>
+#include <string_view>
+#include <unordered_map>
+
+#include "StringTable.h"
+
+namespace {
+
+struct CommandAlias {
+    const char* name;
+    CommandType type;
+};
+
+// Namen in der Reihenfolge von CommandType
+const char* const kCommandNames[] = {
+        "MOVE_FORWARD",
+        "TURN_LEFT",
+        "TURN_RIGHT",
+        "LOOP_START",
+        "LOOP_END",
+        "FUNCTION_DEF",
+        "FUNCTION_CALL",
+        "FUNCTION_END",
+        "IF_PATH_AHEAD",
+        "IF_TARGET_NEARBY",
+        "IF_END",
+        "JUMP",
+        "MOVE_BACKWARD",
+        "PICK_ITEM",
+        "USE_ITEM",
+        "TELEPORT",
+        "CREATE_BRIDGE",
+        "ACTIVATE_SWITCH"
+};
+
+constexpr size_t kCommandCount = sizeof(kCommandNames) / sizeof(kCommandNames[0]);
+static_assert(kCommandCount == static_cast<size_t>(CommandType::ACTIVATE_SWITCH) + 1,
+              "kCommandNames muss zu CommandType passen");
+
+// Kurznamen aus dem Befehlseditor
+const CommandAlias kAliases[] = {
+        {"vorwärts", CommandType::MOVE_FORWARD},
+        {"links", CommandType::TURN_LEFT},
+        {"rechts", CommandType::TURN_RIGHT},
+        {"wiederholen", CommandType::LOOP_START},
+        {"schleife", CommandType::LOOP_START}
+};
+
+// Befehl zu jedem internierten Namen, einmalig aufgebaut
+const std::unordered_map<StringId, CommandType>& commandsByNameId() {
+    static const auto table = [] {
+        std::unordered_map<StringId, CommandType> commands;
+        for (size_t i = 0; i < kCommandCount; i++) {
+            commands.emplace(intern(kCommandNames[i]), static_cast<CommandType>(i));
+        }
+        for (const auto& alias : kAliases) {
+            commands.emplace(intern(alias.name), alias.type);
+        }
+        return commands;
+    }();
+    return table;
+}
+
+} // namespace
+
+const char* commandName(CommandType type) {
+    auto index = static_cast<size_t>(type);
+    return index < kCommandCount ? kCommandNames[index] : "UNKNOWN";
+}
+
+bool parseCommand(const std::string& token, Command& outCommand) {
+    std::string_view name = token;
+    int argument = 0;
+
+    size_t colon = token.find(':');
+    if (colon != std::string::npos) {
+        name = name.substr(0, colon);
+        const char* begin = token.c_str() + colon + 1;
+        char* end = nullptr;
+        argument = static_cast<int>(std::strtol(begin, &end, 10));
+        if (end == begin || *end != '\0') {
+            return false;
+        }
+    }
+
+    // Unbekannte Texte werden nicht interniert, sonst füllt jede Eingabe die Tabelle
+    const auto& commands = commandsByNameId();
+    StringId id = kEmptyStringId;
+    if (!StringTable::global().find(name, id) || commands.count(id) == 0) {
+        return false;
+    }
+    outCommand.type = commands.at(id);
+
+    outCommand.loopCount = outCommand.type == CommandType::LOOP_START ? argument : 0;
+    outCommand.functionId = (outCommand.type == CommandType::FUNCTION_DEF ||
+                             outCommand.type == CommandType::FUNCTION_CALL) ? argument : 0;
+    return true;
+}
+
+bool parseProgram(const std::string& text, std::vector<Command>& outCommands) {
+    outCommands.clear();
+    std::istringstream stream(text);
+    std::string token;
+    while (stream >> token) {
+        Command command{CommandType::MOVE_FORWARD};
+        if (!parseCommand(token, command)) {
+            return false;
+        }
+        outCommands.push_back(command);
+    }
+    return true;
+}
@@ -0,0 +1,67 @@
+#ifndef CODINI_COMMAND_H
+#define CODINI_COMMAND_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Grundlegende Befehle (Level 1)
+enum class CommandType : uint8_t {
+    // Level 1 - Grundbewegungen
+    MOVE_FORWARD,    // Vorwärts bewegen
+    TURN_LEFT,       // Links drehen
+    TURN_RIGHT,      // Rechts drehen
+
+    // Level 2 - Schleifen
+    LOOP_START,      // Schleifenbeginn
+    LOOP_END,        // Schleifenende
+
+    // Level 3 - Funktionen
+    FUNCTION_DEF,    // Funktionsdefinition
+    FUNCTION_CALL,   // Funktionsaufruf
+    FUNCTION_END,    // Ende der Funktionsdefinition
+
+    // Level 4 - Bedingungen
+    IF_PATH_AHEAD,   // Wenn Weg voraus
+    IF_TARGET_NEARBY,// Wenn Ziel in der Nähe
+    IF_END,          // Ende der If-Anweisung
+
+    // Level 5 - Erweiterte Bewegungen
+    JUMP,           // Springen
+    MOVE_BACKWARD,  // Rückwärts bewegen
+    PICK_ITEM,      // Gegenstand aufheben
+    USE_ITEM,       // Gegenstand benutzen
+
+    // Level 6 - Spezielle Befehle
+    TELEPORT,       // Teleportieren
+    CREATE_BRIDGE,   // Brücke erstellen
+    ACTIVATE_SWITCH  // Schalter aktivieren
+};
+
+// Ein vom Spieler eingegebener Befehl
+struct Command {
+    CommandType type;
+    int loopCount = 0;   // Anzahl Wiederholungen für LOOP_START
+    int functionId = 0;  // Funktionsnummer für FUNCTION_DEF/FUNCTION_CALL
+};
+
+/*!
+ * @return den Namen eines Befehls, z.B. "MOVE_FORWARD"
+ */
+const char* commandName(CommandType type);
+
+/*!
+ * Liest einen einzelnen Befehl. Parameter werden mit Doppelpunkt angehängt
+ * ("LOOP_START:3", "FUNCTION_CALL:1"), die deutschen Kurznamen aus dem Editor
+ * ("vorwärts", "links", "rechts", "wiederholen") werden ebenfalls akzeptiert.
+ * @return false, wenn der Befehl unbekannt ist
+ */
+bool parseCommand(const std::string& token, Command& outCommand);
+
+/*!
+ * Liest ein Programm aus durch Leerzeichen getrennten Befehlen.
+ * @return false, wenn ein Befehl unbekannt ist
+ */
+bool parseProgram(const std::string& text, std::vector<Command>& outCommands);
+
+#endif //CODINI_COMMAND_H
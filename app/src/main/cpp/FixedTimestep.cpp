@@ -0,0 +1,36 @@
+#include "FixedTimestep.h"
+
+#include <algorithm>
+#include <cmath>
+
+FixedTimestep::FixedTimestep(int stepsPerSecond) : rate_(kDefaultRate), stepSeconds_(1.0 / kDefaultRate) {
+    setRate(stepsPerSecond);
+}
+
+void FixedTimestep::setRate(int stepsPerSecond) {
+    rate_ = std::max(1, stepsPerSecond);
+    stepSeconds_ = 1.0 / rate_;
+    accumulator_ = 0.0;
+}
+
+int FixedTimestep::advance(float frameSeconds) {
+    if (!(frameSeconds > 0.0f)) {
+        return 0;
+    }
+    accumulator_ += std::min(frameSeconds, kMaxFrameSeconds);
+
+    // Kleine Toleranz, damit Rundungsfehler keinen fast vollen Schritt liegen lassen
+    int count = static_cast<int>(accumulator_ / stepSeconds_ + 1e-6);
+    accumulator_ = std::max(accumulator_ - count * stepSeconds_, 0.0);
+    steps_ += static_cast<uint64_t>(count);
+    return count;
+}
+
+int FixedTimestep::stepsFor(float seconds) const {
+    return std::max(1, static_cast<int>(std::lround(seconds * rate_)));
+}
+
+void FixedTimestep::reset() {
+    accumulator_ = 0.0;
+    steps_ = 0;
+}
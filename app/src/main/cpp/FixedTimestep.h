@@ -0,0 +1,61 @@
+#ifndef CODINI_FIXED_TIMESTEP_H
+#define CODINI_FIXED_TIMESTEP_H
+
+#include <cstdint>
+
+/*!
+ * Akkumulator für eine feste Simulationsrate. Die vergangene Echtzeit eines Frames wird gesammelt
+ * und in ganze Simulationsschritte umgerechnet; der Rest bleibt für den nächsten Frame liegen und
+ * ergibt den Interpolationsfaktor für das Rendern. So hängt der Spielablauf nur von der Anzahl
+ * Schritte ab, nicht von der Bildrate des Geräts.
+ *
+ * Lange Frames (z.B. nach dem Pausieren der App) werden auf kMaxFrameSeconds gekürzt, damit die
+ * Simulation nicht versucht, Sekunden auf einmal nachzuholen.
+ */
+class FixedTimestep {
+public:
+    static constexpr int kDefaultRate = 60;
+    static constexpr float kMaxFrameSeconds = 0.25f;
+
+    explicit FixedTimestep(int stepsPerSecond = kDefaultRate);
+
+    /*!
+     * Ändert die Simulationsrate. Der angesammelte Rest wird verworfen.
+     */
+    void setRate(int stepsPerSecond);
+    int getRate() const { return rate_; }
+
+    float getStepSeconds() const { return static_cast<float>(stepSeconds_); }
+
+    /*!
+     * Rechnet die Echtzeit eines Frames ein.
+     * @return Anzahl Simulationsschritte, die jetzt ausgeführt werden müssen
+     */
+    int advance(float frameSeconds);
+
+    /*!
+     * @return Anteil des nächsten Schritts, der schon vergangen ist (0..1), zum Interpolieren
+     *         zwischen vorletztem und letztem Simulationszustand
+     */
+    float getAlpha() const { return static_cast<float>(accumulator_ / stepSeconds_); }
+
+    /*!
+     * @return Anzahl aller bisher ausgeführten Schritte
+     */
+    uint64_t getStepCount() const { return steps_; }
+
+    /*!
+     * @return Anzahl Schritte, die einer Dauer entsprechen (mindestens 1)
+     */
+    int stepsFor(float seconds) const;
+
+    void reset();
+
+private:
+    int rate_;
+    double stepSeconds_;
+    double accumulator_ = 0.0;
+    uint64_t steps_ = 0;
+};
+
+#endif //CODINI_FIXED_TIMESTEP_H
@@ -0,0 +1,60 @@
+#ifndef CODINI_GL_BACKEND_H
+#define CODINI_GL_BACKEND_H
+
+#include <cstddef>
+#include <cstdint>
+
+enum class BufferTarget : uint8_t {
+    VERTEX,  // GL_ARRAY_BUFFER
+    INDEX    // GL_ELEMENT_ARRAY_BUFFER
+};
+
+enum class BufferUsage : uint8_t {
+    STATIC,  // GL_STATIC_DRAW
+    STREAM   // GL_STREAM_DRAW
+};
+
+enum class AttribType : uint8_t {
+    FLOAT,
+    UNSIGNED_BYTE
+};
+
+enum class BlendMode : uint8_t {
+    ALPHA,    // SRC_ALPHA, ONE_MINUS_SRC_ALPHA
+    ADDITIVE  // SRC_ALPHA, ONE
+};
+
+/*!
+ * Die wenigen GL-Aufrufe, die der SpriteBatch braucht. Auf Android leitet GLES3Backend sie an
+ * OpenGL ES 3 weiter, auf dem Host zeichnet RecordingGLBackend sie nur auf. So lässt sich das
+ * Batching ohne GL-Kontext prüfen.
+ */
+class GLBackend {
+public:
+    virtual ~GLBackend() = default;
+
+    virtual uint32_t createVertexArray() = 0;
+    virtual void deleteVertexArray(uint32_t vertexArray) = 0;
+    virtual void bindVertexArray(uint32_t vertexArray) = 0;
+
+    virtual uint32_t createBuffer() = 0;
+    virtual void deleteBuffer(uint32_t buffer) = 0;
+    virtual void bindBuffer(BufferTarget target, uint32_t buffer) = 0;
+    virtual void bufferData(BufferTarget target, size_t size, const void* data, BufferUsage usage) = 0;
+    virtual void bufferSubData(BufferTarget target, size_t offset, size_t size, const void* data) = 0;
+
+    virtual void vertexAttribPointer(uint32_t location, int components, AttribType type,
+                                     bool normalized, size_t stride, size_t offset) = 0;
+    virtual void enableVertexAttribArray(uint32_t location) = 0;
+
+    virtual void bindTexture(uint32_t texture) = 0;
+    virtual void setBlendMode(BlendMode mode) = 0;
+
+    /*!
+     * Zeichnet Dreiecke aus dem gebundenen Indexpuffer (16-Bit-Indizes).
+     * @param indexOffset erster Index, nicht in Bytes
+     */
+    virtual void drawTriangles(size_t indexCount, size_t indexOffset) = 0;
+};
+
+#endif //CODINI_GL_BACKEND_H
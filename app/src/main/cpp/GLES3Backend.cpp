@@ -0,0 +1,79 @@
+#include "GLES3Backend.h"
+
+#include <GLES3/gl3.h>
+
+namespace {
+    GLenum toGL(BufferTarget target) {
+        return target == BufferTarget::VERTEX ? GL_ARRAY_BUFFER : GL_ELEMENT_ARRAY_BUFFER;
+    }
+
+    GLenum toGL(BufferUsage usage) {
+        return usage == BufferUsage::STATIC ? GL_STATIC_DRAW : GL_STREAM_DRAW;
+    }
+
+    GLenum toGL(AttribType type) {
+        return type == AttribType::FLOAT ? GL_FLOAT : GL_UNSIGNED_BYTE;
+    }
+}
+
+uint32_t GLES3Backend::createVertexArray() {
+    GLuint vertexArray = 0;
+    glGenVertexArrays(1, &vertexArray);
+    return vertexArray;
+}
+
+void GLES3Backend::deleteVertexArray(uint32_t vertexArray) {
+    GLuint name = vertexArray;
+    glDeleteVertexArrays(1, &name);
+}
+
+void GLES3Backend::bindVertexArray(uint32_t vertexArray) {
+    glBindVertexArray(vertexArray);
+}
+
+uint32_t GLES3Backend::createBuffer() {
+    GLuint buffer = 0;
+    glGenBuffers(1, &buffer);
+    return buffer;
+}
+
+void GLES3Backend::deleteBuffer(uint32_t buffer) {
+    GLuint name = buffer;
+    glDeleteBuffers(1, &name);
+}
+
+void GLES3Backend::bindBuffer(BufferTarget target, uint32_t buffer) {
+    glBindBuffer(toGL(target), buffer);
+}
+
+void GLES3Backend::bufferData(BufferTarget target, size_t size, const void* data, BufferUsage usage) {
+    glBufferData(toGL(target), static_cast<GLsizeiptr>(size), data, toGL(usage));
+}
+
+void GLES3Backend::bufferSubData(BufferTarget target, size_t offset, size_t size, const void* data) {
+    glBufferSubData(toGL(target), static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), data);
+}
+
+void GLES3Backend::vertexAttribPointer(uint32_t location, int components, AttribType type,
+                                       bool normalized, size_t stride, size_t offset) {
+    glVertexAttribPointer(location, components, toGL(type), normalized ? GL_TRUE : GL_FALSE,
+                          static_cast<GLsizei>(stride), reinterpret_cast<const void*>(offset));
+}
+
+void GLES3Backend::enableVertexAttribArray(uint32_t location) {
+    glEnableVertexAttribArray(location);
+}
+
+void GLES3Backend::bindTexture(uint32_t texture) {
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, texture);
+}
+
+void GLES3Backend::setBlendMode(BlendMode mode) {
+    glBlendFunc(GL_SRC_ALPHA, mode == BlendMode::ADDITIVE ? GL_ONE : GL_ONE_MINUS_SRC_ALPHA);
+}
+
+void GLES3Backend::drawTriangles(size_t indexCount, size_t indexOffset) {
+    glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indexCount), GL_UNSIGNED_SHORT,
+                   reinterpret_cast<const void*>(indexOffset * sizeof(GLushort)));
+}
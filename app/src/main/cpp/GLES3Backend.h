@@ -0,0 +1,30 @@
+#ifndef CODINI_GLES3_BACKEND_H
+#define CODINI_GLES3_BACKEND_H
+
+#include "GLBackend.h"
+
+/*!
+ * GLBackend, der direkt OpenGL ES 3 aufruft. Setzt einen aktuellen GL-Kontext voraus.
+ */
+class GLES3Backend : public GLBackend {
+public:
+    uint32_t createVertexArray() override;
+    void deleteVertexArray(uint32_t vertexArray) override;
+    void bindVertexArray(uint32_t vertexArray) override;
+
+    uint32_t createBuffer() override;
+    void deleteBuffer(uint32_t buffer) override;
+    void bindBuffer(BufferTarget target, uint32_t buffer) override;
+    void bufferData(BufferTarget target, size_t size, const void* data, BufferUsage usage) override;
+    void bufferSubData(BufferTarget target, size_t offset, size_t size, const void* data) override;
+
+    void vertexAttribPointer(uint32_t location, int components, AttribType type,
+                             bool normalized, size_t stride, size_t offset) override;
+    void enableVertexAttribArray(uint32_t location) override;
+
+    void bindTexture(uint32_t texture) override;
+    void setBlendMode(BlendMode mode) override;
+    void drawTriangles(size_t indexCount, size_t indexOffset) override;
+};
+
+#endif //CODINI_GLES3_BACKEND_H
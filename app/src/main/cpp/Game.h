@@ -2,12 +2,19 @@
 #define CODINI_GAME_H
 
 #include "Model.h"
+#include "AssetLoader.h"
+#include "Command.h"
+#include "FixedTimestep.h"
+#include "Simulation.h"
 #include "Renderer.h"
 #include "ParticleSystem.h"
+#include "Profiler.h"
+#include "ReplayLog.h"
+#include "Tween.h"
 #include "AudioManager.h"  // Header für Audio-Management
 #include <memory>
+#include <string>
 #include <vector>
-#include <queue>
 #include <cmath>
 
 // Spielzustände
@@ -21,82 +28,106 @@ enum class GameState {
     PAUSED         // Pause
 };
 
-// Grundlegende Befehle (Level 1)
-enum class CommandType {
-    // Level 1 - Grundbewegungen
-    MOVE_FORWARD,    // Vorwärts bewegen
-    TURN_LEFT,       // Links drehen
-    TURN_RIGHT,      // Rechts drehen
-    
-    // Level 2 - Schleifen
-    LOOP_START,      // Schleifenbeginn
-    LOOP_END,        // Schleifenende
-    
-    // Level 3 - Funktionen
-    FUNCTION_DEF,    // Funktionsdefinition
-    FUNCTION_CALL,   // Funktionsaufruf
-    
-    // Level 4 - Bedingungen
-    IF_PATH_AHEAD,   // Wenn Weg voraus
-    IF_TARGET_NEARBY,// Wenn Ziel in der Nähe
-    IF_END,          // Ende der If-Anweisung
-    
-    // Level 5 - Erweiterte Bewegungen
-    JUMP,           // Springen
-    MOVE_BACKWARD,  // Rückwärts bewegen
-    PICK_ITEM,      // Gegenstand aufheben
-    USE_ITEM,       // Gegenstand benutzen
-    
-    // Level 6 - Spezielle Befehle
-    TELEPORT,       // Teleportieren
-    CREATE_BRIDGE,   // Brücke erstellen
-    ACTIVATE_SWITCH  // Schalter aktivieren
-};
-
 // Struktur für Befehlsgruppen
 struct CommandGroup {
-<<<<<<< HEAD
-    std::string name;               // Grup adı
-    std::string description;        // Açıklama
-    std::vector<CommandType> commands; // Gruptaki komutlar
-    int unlockedAtLevel;           // Auf welchem Level wird freigeschaltet
-=======
     std::string name;               // Gruppenname
     std::string description;        // Beschreibung
     std::vector<CommandType> commands; // Befehle in der Gruppe
     int unlockedAtLevel;           // In welchem Level wird es freigeschaltet
->>>>>>> bf23b1a (4. Commit)
 };
 
 class Game {
 public:
     Game(android_app* app) : app_(app), gameState_(GameState::MENU) {
         model_ = std::make_unique<GameModel>();
-        renderer_ = std::make_unique<Renderer>(app);
+        // Fortschritt liegt im internen App-Speicher, ohne ihn läuft das Spiel nur flüchtig
+        model_->openProgressStore(app->activity->internalDataPath);
+        replayPath_ = std::string(app->activity->internalDataPath) + "/last_session.crpl";
+        tracePath_ = std::string(app->activity->internalDataPath) + "/last_session.trace.json";
+        replay_.begin(timestep_.getRate());
+        renderer_ = std::make_unique<Renderer>(app, assetLoader_);
         particleSystem_ = std::make_unique<ParticleSystem>();
-        audioManager_ = std::make_unique<AudioManager>();
+        audioManager_ = std::make_unique<AudioManager>(app->activity->assetManager, assetLoader_);
         initializeCommandGroups();
         initializeGame();
+
+        // Sounds und Theme-Atlas laden im Hintergrund, der erste Frame wartet nicht darauf
         loadSoundEffects();
+        renderer_->preloadTheme(model_->getThemeForLevel(currentLevel_));
     }
 
     void initializeGame() {
         currentLevel_ = 1;
         model_->initializeLevel(currentLevel_);
-        commandQueue_.clear();
+        replay_.levelStarted(timestep_.getStepCount(), currentLevel_, model_->getLevelSeed());
+        clearCommands();
+    }
+
+    /*!
+     * Ein Frame: die vergangene Echtzeit in feste Simulationsschritte umrechnen, diese ausführen
+     * und danach zwischen den letzten beiden Zuständen interpoliert rendern.
+     */
+    void runFrame(float frameSeconds) {
+        PROFILE_ZONE("Game::runFrame");
+        Profiler::global().markFrame(frameSeconds);
+
+        int steps = timestep_.advance(frameSeconds);
+        for (int i = 0; i < steps; i++) {
+            savePreviousState();
+            update(timestep_.getStepSeconds());
+        }
+        render(timestep_.getAlpha());
+    }
+
+    /*!
+     * Die App verliert ihr Fenster und kann danach jederzeit beendet werden: ausstehenden
+     * Fortschritt dauerhaft schreiben. Es wird ohnehin nicht mehr gerendert.
+     */
+    void flushProgress() {
+        model_->flushProgress();
+        replay_.save(replayPath_);
+        if (Profiler::global().isEnabled()) {
+            Profiler::global().writeChromeTrace(tracePath_);
+        }
     }
 
+    /*!
+     * Blendet das Histogramm der Framezeiten ein, z.B. zur Suche nach Rucklern auf einem Tablet.
+     * Im Spiel schaltet Tippen mit drei Fingern es zusammen mit den Messpunkten um (handleInput).
+     */
+    void setFrameHistogramVisible(bool visible) {
+        showFrameHistogram_ = visible;
+    }
+
+    /*!
+     * Zeichnet Messpunkte auf, beim Verlieren des Fensters wird ein Chrome-Trace geschrieben.
+     * Standardmäßig aus, in Release-Builds ohne Messpunkte wirkungslos.
+     */
+    void setProfilingEnabled(bool enabled) {
+        Profiler::global().setEnabled(enabled);
+    }
+
+    /*!
+     * Ändert die Simulationsrate (Schritte pro Sekunde). Der Befehlstakt bleibt in Sekunden gleich.
+     */
+    void setSimulationRate(int stepsPerSecond) {
+        timestep_.setRate(stepsPerSecond);
+    }
+
+    // Ein fester Simulationsschritt
     void update(float deltaTime) {
+        PROFILE_ZONE("Game::update");
+
         // Partikelsystem aktualisieren
         particleSystem_->update(deltaTime);
 
+        // Animationen laufen in jedem Zustand weiter, alle Spuren in einem Durchgang
+        updateAnimation(deltaTime);
+
         switch (gameState_) {
             case GameState::PLAYING:
                 updateGameplay(deltaTime);
                 break;
-            case GameState::ANIMATING:
-                updateAnimation(deltaTime);
-                break;
             case GameState::CODING:
                 updateCodeExecution(deltaTime);
                 break;
@@ -106,6 +137,15 @@ public:
     }
 
     void handleInput(const GameActivityMotionEvent* event) {
+        // Debug-Geste: ein dritter Finger schaltet Messpunkte und Framezeit-Histogramm um
+        if ((event->action & AMOTION_EVENT_ACTION_MASK) == AMOTION_EVENT_ACTION_POINTER_DOWN &&
+            event->pointerCount == 3) {
+            bool enabled = !showFrameHistogram_;
+            setProfilingEnabled(enabled);
+            setFrameHistogramVisible(enabled);
+            return;
+        }
+
         switch (gameState_) {
             case GameState::MENU:
                 handleMenuInput(event);
@@ -121,14 +161,19 @@ public:
         }
     }
 
-    void render() {
+    void render(float alpha = 1.0f) {
+        PROFILE_ZONE("Game::render");
+
+        // Fertig dekodierte Assets hochladen, begrenzt damit kein Frame mehrere Atlanten schultert
+        assetLoader_.pumpUploads(kMaxUploadsPerFrame);
+
         renderer_->beginFrame();
 
         // Hintergrund basierend auf aktuellem Theme rendern
         renderer_->renderBackground(model_->getCurrentTheme());
 
         // Spielobjekte rendern
-        for (const auto& box : model_->getBoxes()) {
+        for (const auto& box : interpolatedBoxes(alpha)) {
             renderer_->renderBox(box);
         }
         for (const auto& target : model_->getTargets()) {
@@ -139,10 +184,10 @@ public:
         }
 
         // Partikeleffekte rendern
-        for (const auto& emitter : particleSystem_->getEmitters()) {
-            for (const auto& particle : emitter->getParticles()) {
-                renderer_->renderParticle(particle, emitter->getTextureName());
-            }
+        for (size_t t = 0; t < static_cast<size_t>(ParticleTexture::COUNT); t++) {
+            auto texture = static_cast<ParticleTexture>(t);
+            renderer_->renderParticles(particleSystem_->getParticles(texture),
+                                       particleTextureId(texture));
         }
 
         // UI-Elemente basierend auf GameState rendern
@@ -160,17 +205,17 @@ public:
                 break;
         }
 
+        if (showFrameHistogram_) {
+            renderer_->renderFrameHistogram(Profiler::global().getFrameHistogram());
+        }
+
         renderer_->endFrame();
     }
 
 private:
     void initializeCommandGroups() {
         commandGroups_ = {
-<<<<<<< HEAD
-            // Level 1 - Grundbewegung
-=======
             // Level 1 - Grundbewegungen
->>>>>>> bf23b1a (4. Commit)
             CommandGroup{
                 "Grundbewegungen",
                 "Lerne die grundlegenden Bewegungsbefehle",
@@ -190,7 +235,7 @@ private:
             CommandGroup{
                 "Funktionen",
                 "Erstelle und verwende eigene Funktionen",
-                {CommandType::FUNCTION_DEF, CommandType::FUNCTION_CALL},
+                {CommandType::FUNCTION_DEF, CommandType::FUNCTION_CALL, CommandType::FUNCTION_END},
                 3
             },
             
@@ -221,8 +266,10 @@ private:
     }
 
     void updateGameplay(float deltaTime) {
-        // Spiellogik-Update
-        if (!commandQueue_.empty() && !isAnimating_) {
+        // Fester Takt wie im Grader, die Animationen eines Takts passen in das Intervall
+        if (simulation_.isRunning() &&
+            ++ticksSinceCommand_ >= timestep_.stepsFor(commandExecutionInterval_)) {
+            ticksSinceCommand_ = 0;
             executeNextCommand();
         }
         
@@ -230,41 +277,102 @@ private:
         checkCollisions();
         
         // Überprüfen, ob Level abgeschlossen
-        if (model_->checkWinCondition()) {
+        if (simulation_.checkWinCondition()) {
             completeLevelWithSolution();
         }
     }
 
     void updateAnimation(float deltaTime) {
-        if (currentAnimation_) {
-            if (currentAnimation_->update(deltaTime)) {
-                currentAnimation_ = nullptr;
-                isAnimating_ = false;
-                if (commandQueue_.empty()) {
-                    checkLevelCompletion();
-                }
+        if (tweens_.empty()) {
+            return;
+        }
+
+        auto& boxes = model_->getBoxes();
+        tweens_.update(deltaTime, boxes.data(), boxes.size());
+        for (const TweenCueEvent& cue : tweens_.getCues()) {
+            const GameObject& box = boxes[cue.object];
+            Vector2 position{box.position.x, box.position.y};
+            switch (cue.cue) {
+                case TweenCue::JUMP_DUST:
+                    // Staub nur nahe dem höchsten Punkt
+                    if (box.position.z > kJumpHeight * 0.7f) {
+                        particleSystem_->addJumpEffect(position);
+                    }
+                    break;
+                case TweenCue::TELEPORT_TRAIL:
+                    if (cue.progress < 0.8f) {
+                        particleSystem_->addTeleportTrail(position);
+                    }
+                    break;
+                case TweenCue::TELEPORT_ARRIVE:
+                    particleSystem_->addTeleportEffect(position, false);
+                    break;
+                case TweenCue::NONE:
+                    break;
             }
         }
+
+        if (tweens_.empty() && !simulation_.isRunning()) {
+            checkLevelCompletion();
+        }
+    }
+
+    // Startet eine Spur auf einer Box; ist der Pool voll, springt die Eigenschaft gleich ans Ziel
+    void tween(int boxIndex, TweenProperty property, float from, float to, float duration,
+               Easing easing, float delay = 0.0f, TweenCue cue = TweenCue::NONE) {
+        if (!tweens_.animate(static_cast<uint16_t>(boxIndex), property, from, to, duration,
+                             easing, delay, cue)) {
+            TweenSystem::set(model_->getBoxes()[boxIndex], property, to);
+        }
     }
 
     void updateCodeExecution(float deltaTime) {
-        executionTimer_ += deltaTime;
-        if (executionTimer_ >= commandExecutionInterval_) {
-            executionTimer_ = 0.0f;
-            if (!commandQueue_.empty()) {
+        // Befehlstakt in ganzen Schritten, damit Hänger im Frame das Tempo nicht verändern
+        if (++ticksSinceCommand_ >= timestep_.stepsFor(commandExecutionInterval_)) {
+            ticksSinceCommand_ = 0;
+            if (simulation_.isRunning()) {
                 executeNextCommand();
             }
         }
     }
 
+    // Zustand vor einem Simulationsschritt merken, zum Interpolieren beim Rendern
+    void savePreviousState() {
+        previousBoxes_ = model_->getBoxes();
+    }
+
+    /*!
+     * @return die Boxen zwischen vorletztem (alpha = 0) und letztem Schritt (alpha = 1)
+     */
+    const std::vector<GameObject>& interpolatedBoxes(float alpha) {
+        const auto& current = model_->getBoxes();
+        if (previousBoxes_.size() != current.size()) {
+            return current;
+        }
+
+        renderBoxes_.resize(current.size());
+        for (size_t i = 0; i < current.size(); i++) {
+            const GameObject& from = previousBoxes_[i];
+            const GameObject& to = current[i];
+            GameObject& box = renderBoxes_[i];
+            box = to;
+            box.position.x = from.position.x + (to.position.x - from.position.x) * alpha;
+            box.position.y = from.position.y + (to.position.y - from.position.y) * alpha;
+            box.position.z = from.position.z + (to.position.z - from.position.z) * alpha;
+            box.scale = from.scale + (to.scale - from.scale) * alpha;
+            box.alpha = from.alpha + (to.alpha - from.alpha) * alpha;
+
+            // Drehung über den kürzeren Weg
+            float turn = std::fmod(to.rotation - from.rotation + 540.0f, 360.0f) - 180.0f;
+            box.rotation = from.rotation + turn * alpha;
+        }
+        return renderBoxes_;
+    }
+
     std::vector<CommandType> getAvailableCommands() {
         std::vector<CommandType> available;
         
-<<<<<<< HEAD
-        // Verfügbare Befehle für das aktuelle Level sammeln
-=======
         // Verfügbare Befehle für aktuelles Level sammeln
->>>>>>> bf23b1a (4. Commit)
         for (const auto& group : commandGroups_) {
             if (group.unlockedAtLevel <= currentLevel_) {
                 available.insert(available.end(), 
@@ -277,169 +385,102 @@ private:
     }
 
     void executeNextCommand() {
-        if (commandQueue_.empty()) return;
-        
-        Command cmd = commandQueue_.front();
-        commandQueue_.pop();
-        
-        // Effekt beim Ausführen des Befehls
-        if (auto* box = getSelectedBox()) {
-            particleSystem_->addCodeEffect(Vector2{box->position.x, box->position.y});
+        PROFILE_ZONE("Game::executeNextCommand");
+
+        // Die Simulation wertet den Takt sofort aus, hier werden nur die Ergebnisse animiert.
+        // Im Parallelbetrieb bewegen sich dabei alle Boxen gleichzeitig.
+        stepEvents_.clear();
+        int actions = simulation_.stepRound(&stepEvents_);
+        if (actions == 0) return;
+        actionsExecuted_ += actions;
+        roundsExecuted_++;
+
+        for (const StepEvent& event : stepEvents_) {
+            animateStep(event);
         }
-        
-        switch (cmd.type) {
-            // Grundbewegungsbefehle
+    }
+
+    void animateStep(const StepEvent& event) {
+        const GameObject& box = model_->getBoxes()[event.boxIndex];
+
+        // Effekt beim Ausführen des Befehls
+        particleSystem_->addCodeEffect(Vector2{box.position.x, box.position.y});
+
+        // Blockierte Bewegungen werden nicht animiert
+        if (!event.moved) return;
+
+        switch (event.action) {
             case CommandType::MOVE_FORWARD:
-                moveSelectedBox();
+            case CommandType::MOVE_BACKWARD:
+                animateMove(event.boxIndex, event);
                 break;
             case CommandType::TURN_LEFT:
-                rotateSelectedBox(-90.0f);
-                break;
             case CommandType::TURN_RIGHT:
-                rotateSelectedBox(90.0f);
-                break;
-                
-            // Schleifenbefehle
-            case CommandType::LOOP_START:
-                pushLoopContext(cmd.loopCount);
+                animateRotation(event.boxIndex, event);
                 break;
-            case CommandType::LOOP_END:
-                processLoopEnd();
-                break;
-                
-            // Bedingungsbefehle
-            case CommandType::IF_PATH_AHEAD:
-                executeIfPathAhead();
-                break;
-            case CommandType::IF_TARGET_NEARBY:
-                executeIfTargetNearby();
-                break;
-            case CommandType::IF_END:
-                processIfEnd();
-                break;
-                
-            // Erweiterte Bewegungsbefehle
             case CommandType::JUMP:
-                executeJump();
-                break;
-            case CommandType::MOVE_BACKWARD:
-                moveSelectedBoxBackward();
-                break;
-            case CommandType::PICK_ITEM:
-                executePickItem();
-                break;
-            case CommandType::USE_ITEM:
-                executeUseItem();
+                animateJump(event.boxIndex, event);
                 break;
-                
-            // Spezielle Befehle
             case CommandType::TELEPORT:
-                executeTeleport();
+                animateTeleport(event.boxIndex, event);
                 break;
-            case CommandType::CREATE_BRIDGE:
-                executeCreateBridge();
-                break;
-            case CommandType::ACTIVATE_SWITCH:
-                executeActivateSwitch();
+            default:
+                // Aktionen ohne Bewegung (Gegenstände, Schalter)
                 break;
         }
     }
 
-    // Neue Befehlsimplementierungen
-    void executeIfPathAhead() {
-        if (auto* box = getSelectedBox()) {
-            float angle = box->rotation * M_PI / 180.0f;
-            float checkX = box->position.x + cos(angle);
-            float checkY = box->position.y + sin(angle);
-            
-            if (isValidPosition(checkX, checkY)) {
-                // Wenn Weg frei ist, nächsten Befehl ausführen
-                executeNextCommand();
-            } else {
-                // Wenn Weg blockiert ist, if-Block überspringen
-                skipToIfEnd();
-            }
-        }
-    }
-
-    void executeIfTargetNearby() {
-        if (auto* box = getSelectedBox()) {
-            bool targetNearby = false;
-            
-            // Nächstes Ziel prüfen
-            for (const auto& target : model_->getTargets()) {
-                float dx = target.position.x - box->position.x;
-                float dy = target.position.y - box->position.y;
-                float distance = sqrt(dx*dx + dy*dy);
-                
-                if (distance < 2.0f) { // Innerhalb von 2 Einheiten Entfernung
-                    targetNearby = true;
-                    break;
-                }
-            }
-            
-            if (targetNearby) {
-                executeNextCommand();
-            } else {
-                skipToIfEnd();
-            }
-        }
-    }
-
-    void executeJump() {
-        if (auto* box = getSelectedBox()) {
-            float angle = box->rotation * M_PI / 180.0f;
-            float targetX = box->position.x + 2.0f * cos(angle);
-            float targetY = box->position.y + 2.0f * sin(angle);
-            
-            // Sprunganimation mit Sound starten
-            audioManager_->playSound("jump", 1.0f);
-            currentAnimation_ = std::make_unique<JumpAnimation>(*box, targetX, targetY, 0.5f);
-            isAnimating_ = true;
-        }
+    void animateJump(int boxIndex, const StepEvent& event) {
+        // Sprunganimation mit Sound starten
+        audioManager_->playSound("jump", 1.0f);
+
+        // Vorwärts mit leichtem Überschwingen, die Höhe folgt einem Bogen und landet weich
+        const GameObject& box = model_->getBoxes()[boxIndex];
+        Position to = positionOf(event.to);
+        tween(boxIndex, TweenProperty::POSITION_X, box.position.x, to.x, 0.5f, Easing::OUT_BACK);
+        tween(boxIndex, TweenProperty::POSITION_Y, box.position.y, to.y, 0.5f, Easing::OUT_BACK);
+        tween(boxIndex, TweenProperty::POSITION_Z, 0.0f, kJumpHeight, 0.5f, Easing::JUMP_ARC, 0.0f,
+              TweenCue::JUMP_DUST);
     }
 
-    void executeTeleport() {
-        if (auto* box = getSelectedBox()) {
-            // Ersten Teleport-Sound abspielen
-            audioManager_->playSound("teleport_start", 0.8f);
-            
-            float angle = box->rotation * M_PI / 180.0f;
-            float targetX = box->position.x + 3.0f * cos(angle);
-            float targetY = box->position.y + 3.0f * sin(angle);
-            
-            currentAnimation_ = std::make_unique<TeleportAnimation>(*box, targetX, targetY, 0.7f);
-            isAnimating_ = true;
-            
-            // Zweiten Teleport-Sound mit Verzögerung abspielen
-            audioManager_->playSound("teleport_end", 0.8f, 0.35f);
-        }
+    void animateTeleport(int boxIndex, const StepEvent& event) {
+        // Ersten Teleport-Sound abspielen
+        audioManager_->playSound("teleport_start", 0.8f);
+
+        // Erst schrumpfen und verblassen, zur Hälfte des Takts versetzen, dann am Ziel wieder wachsen
+        const GameObject& box = model_->getBoxes()[boxIndex];
+        particleSystem_->addTeleportEffect(Vector2{box.position.x, box.position.y}, true);
+        const float half = commandExecutionInterval_ * 0.5f;
+        Position to = positionOf(event.to);
+        tween(boxIndex, TweenProperty::SCALE, 1.0f, 0.0f, half, Easing::IN_EXPO, 0.0f,
+              TweenCue::TELEPORT_TRAIL);
+        tween(boxIndex, TweenProperty::ALPHA, 1.0f, 0.0f, half, Easing::IN_EXPO);
+        tween(boxIndex, TweenProperty::POSITION_X, to.x, to.x, 0.0f, Easing::LINEAR, half);
+        tween(boxIndex, TweenProperty::POSITION_Y, to.y, to.y, 0.0f, Easing::LINEAR, half,
+              TweenCue::TELEPORT_ARRIVE);
+        tween(boxIndex, TweenProperty::SCALE, 0.0f, 1.0f, half, Easing::OUT_EXPO, half);
+        tween(boxIndex, TweenProperty::ALPHA, 0.0f, 1.0f, half, Easing::OUT_EXPO, half);
+
+        // Zweiten Teleport-Sound mit Verzögerung abspielen
+        audioManager_->playSound("teleport_end", 0.8f, half);
     }
 
     void checkCollisions() {
-        // Kollisionserkennung zwischen Boxen und Hindernissen
-        for (auto& box : model_->getBoxes()) {
-            for (const auto& target : model_->getTargets()) {
-                if (checkBoxTargetCollision(box, target)) {
-                    // Kollisionsbehandlung
-                }
-            }
+        // Kollisionserkennung zwischen Boxen und Zielen, über das Raster der Simulation
+        const int boxCount = static_cast<int>(simulation_.getBoxes().size());
+        for (int box = 0; box < boxCount; box++) {
+            simulation_.forEachTargetTouching(box, [](int target) {
+                // Kollisionsbehandlung
+            });
         }
     }
 
-    bool checkBoxTargetCollision(const GameObject& box, const GameObject& target) {
-        // AABB Kollisionserkennung
-        return (box.position.x < target.position.x + target.width &&
-                box.position.x + box.width > target.position.x &&
-                box.position.y < target.position.y + target.height &&
-                box.position.y + box.height > target.position.y);
-    }
-
     void completeLevelWithSolution() {
         gameState_ = GameState::LEVEL_COMPLETE;
+        replay_.levelCompleted(timestep_.getStepCount(), actionsExecuted_, simulation_.stateHash());
         LevelCompletion completion = model_->completeLevelWithSolution(
-            getCurrentCommandList(), 
-            executionTimer_
+            commandList_,
+            Simulation::secondsFor(roundsExecuted_)
         );
 
         // Erfolgs-Sterneneffekte
@@ -449,12 +490,9 @@ private:
 
         // Level-Abschluss-Animation
         startLevelCompleteAnimation(completion);
-    }
 
-    std::vector<std::string> getCurrentCommandList() {
-        std::vector<std::string> commands;
-        // Konvertiere ausgeführte Befehle in Strings
-        return commands;
+        // Während der Abschlussbildschirm läuft, das Theme des nächsten Levels vorbereiten
+        renderer_->preloadTheme(model_->getThemeForLevel(currentLevel_ + 1));
     }
 
     android_app* app_;
@@ -462,255 +500,40 @@ private:
     std::unique_ptr<Renderer> renderer_;
     std::unique_ptr<ParticleSystem> particleSystem_;
     std::unique_ptr<AudioManager> audioManager_;
+    // Nach Renderer und AudioManager deklariert, damit der Worker vor ihnen beendet wird
+    AssetLoader assetLoader_;
+    static constexpr size_t kMaxUploadsPerFrame = 2;
     GameState gameState_;
     int currentLevel_;
-    std::queue<Command> commandQueue_;
-    bool isAnimating_ = false;
-    float executionTimer_ = 0.0f;
-    const float commandExecutionInterval_ = 0.5f; // Sekunden zwischen Befehlen
-    std::unique_ptr<Animation> currentAnimation_;
-    std::vector<std::pair<int, int>> loopStack_; // Loop-Kontext (Zähler, Start-Index)
-
-    // Animation-System
-    class Animation {
-    public:
-        virtual bool update(float deltaTime) = 0;
-        virtual ~Animation() = default;
-    };
-
-    class MoveAnimation : public Animation {
-    public:
-        MoveAnimation(GameObject& obj, float targetX, float targetY, float duration)
-            : object_(obj), 
-              startX_(obj.position.x), startY_(obj.position.y),
-              targetX_(targetX), targetY_(targetY),
-              duration_(duration), currentTime_(0) {}
-
-        bool update(float deltaTime) override {
-            currentTime_ += deltaTime;
-            float progress = std::min(currentTime_ / duration_, 1.0f);
-            
-            // Easing-Funktion für smoothe Bewegung
-            progress = easeInOutQuad(progress);
-            
-            object_.position.x = startX_ + (targetX_ - startX_) * progress;
-            object_.position.y = startY_ + (targetY_ - startY_) * progress;
-            
-            return progress >= 1.0f;
-        }
-
-    private:
-        float easeInOutQuad(float t) {
-            return t < 0.5f ? 2.0f * t * t : -1.0f + (4.0f - 2.0f * t) * t;
-        }
-
-        GameObject& object_;
-        float startX_, startY_;
-        float targetX_, targetY_;
-        float duration_;
-        float currentTime_;
-    };
-
-    class RotateAnimation : public Animation {
-    public:
-        RotateAnimation(GameObject& obj, float targetAngle, float duration)
-            : object_(obj),
-              startAngle_(obj.rotation),
-              targetAngle_(targetAngle),
-              duration_(duration), currentTime_(0) {}
-
-        bool update(float deltaTime) override {
-            currentTime_ += deltaTime;
-            float progress = std::min(currentTime_ / duration_, 1.0f);
-            
-            // Easing-Funktion für smoothe Rotation
-            progress = easeInOutQuad(progress);
-            
-            object_.rotation = startAngle_ + (targetAngle_ - startAngle_) * progress;
-            return progress >= 1.0f;
-        }
-
-    private:
-        float easeInOutQuad(float t) {
-            return t < 0.5f ? 2.0f * t * t : -1.0f + (4.0f - 2.0f * t) * t;
-        }
-
-        GameObject& object_;
-        float startAngle_;
-        float targetAngle_;
-        float duration_;
-        float currentTime_;
-    };
-
-    class JumpAnimation : public Animation {
-    public:
-        JumpAnimation(GameObject& obj, float targetX, float targetY, float duration)
-            : object_(obj), 
-              startX_(obj.position.x), startY_(obj.position.y),
-              targetX_(targetX), targetY_(targetY),
-              duration_(duration), currentTime_(0) {}
-
-        bool update(float deltaTime) override {
-            currentTime_ += deltaTime;
-            float progress = std::min(currentTime_ / duration_, 1.0f);
-            
-            // Easing für geschmeidigere Bewegung
-            float easedProgress = easeOutBack(progress);
-            
-            // Parabelförmige Sprungbewegung mit verstärktem Höheneffekt
-            float jumpHeight = 2.0f; // Erhöhte maximale Sprunghöhe
-            float verticalProgress = sin(easedProgress * M_PI); // 0 -> 1 -> 0
-            verticalProgress = easeOutQuad(verticalProgress); // Sanftere Landung
-            
-            // Horizontale Bewegung mit leichtem "Überschwingen"
-            object_.position.x = startX_ + (targetX_ - startX_) * easedProgress;
-            object_.position.y = startY_ + (targetY_ - startY_) * easedProgress;
-            object_.position.z = jumpHeight * verticalProgress;
-            
-            // Partikeleffekt während des Sprungs
-            if (verticalProgress > 0.7f) {
-                particleSystem_->addJumpEffect(Vector2{object_.position.x, object_.position.y});
-            }
-            
-            return progress >= 1.0f;
-        }
-
-    private:
-        float easeOutBack(float t) {
-            const float c1 = 1.70158f;
-            const float c3 = c1 + 1.0f;
-            return 1.0f + c3 * pow(t - 1.0f, 3.0f) + c1 * pow(t - 1.0f, 2.0f);
-        }
-        
-        float easeOutQuad(float t) {
-            return 1.0f - (1.0f - t) * (1.0f - t);
-        }
-
-        GameObject& object_;
-        float startX_, startY_;
-        float targetX_, targetY_;
-        float duration_;
-        float currentTime_;
-    };
-
-    class TeleportAnimation : public Animation {
-    public:
-        TeleportAnimation(GameObject& obj, float targetX, float targetY, float duration)
-            : object_(obj), 
-              startX_(obj.position.x), startY_(obj.position.y),
-              targetX_(targetX), targetY_(targetY),
-              duration_(duration), currentTime_(0) {
-            // Initialer Teleport-Effekt an Startposition
-            particleSystem_->addTeleportEffect(Vector2{startX_, startY_}, true);
-        }
-
-        bool update(float deltaTime) override {
-            currentTime_ += deltaTime;
-            float progress = std::min(currentTime_ / duration_, 1.0f);
-            
-            // Easing für geschmeidigere Animation
-            float easedProgress = easeInOutExpo(progress);
-            
-            // Teleporteffekt: Erst schrumpfen, dann wachsen mit Farbeffekt
-            if (progress < 0.5f) {
-                // Schrumpfen und verblassen
-                float scale = 1.0f - easedProgress * 2.0f;
-                object_.scale = scale;
-                object_.alpha = scale; // Transparenz hinzufügen
-                
-                // Kontinuierliche Partikel während des Verschwindens
-                if (progress < 0.4f) {
-                    particleSystem_->addTeleportTrail(
-                        Vector2{object_.position.x, object_.position.y}
-                    );
-                }
-            } else {
-                // An neuer Position erscheinen
-                if (!hasTelepported_) {
-                    object_.position.x = targetX_;
-                    object_.position.y = targetY_;
-                    // Teleport-Effekt an Zielposition
-                    particleSystem_->addTeleportEffect(
-                        Vector2{targetX_, targetY_}, 
-                        false
-                    );
-                    hasTelepported_ = true;
-                }
-                
-                // Wachsen und erscheinen
-                float scale = (easedProgress - 0.5f) * 2.0f;
-                object_.scale = scale;
-                object_.alpha = scale;
-            }
-            
-            return progress >= 1.0f;
-        }
-
-    private:
-        float easeInOutExpo(float t) {
-            if (t == 0.0f || t == 1.0f) return t;
-            
-            if (t < 0.5f) {
-                return pow(2.0f, 20.0f * t - 10.0f) / 2.0f;
-            }
-            return (2.0f - pow(2.0f, -20.0f * t + 10.0f)) / 2.0f;
-        }
-
-        GameObject& object_;
-        float startX_, startY_;
-        float targetX_, targetY_;
-        float duration_;
-        float currentTime_;
-        bool hasTelepported_ = false;
-    };
-
-    void moveSelectedBox() {
-        if (auto* box = getSelectedBox()) {
-            // Bewegungsrichtung basierend auf Rotation berechnen
-            float angle = box->rotation * M_PI / 180.0f;
-            float targetX = box->position.x + cos(angle);
-            float targetY = box->position.y + sin(angle);
-            
-            // Kollisionsprüfung für neue Position
-            if (isValidPosition(targetX, targetY)) {
-                currentAnimation_ = std::make_unique<MoveAnimation>(*box, targetX, targetY, 0.3f);
-                isAnimating_ = true;
-            }
-        }
+    std::vector<Command> commandList_;   // Vom Spieler eingegebenes Programm
+    Simulation simulation_;              // Spielregeln und Programmausführung
+    std::vector<StepEvent> stepEvents_;  // Ereignisse des letzten Takts, wiederverwendet
+    FixedTimestep timestep_;                 // Feste Simulationsrate
+    int ticksSinceCommand_ = 0;              // Schritte seit dem letzten Befehl
+    int roundsExecuted_ = 0;                 // Takte seit Programmstart, ergibt timeSpent
+    int actionsExecuted_ = 0;                // Aktionen seit Programmstart, für die Aufzeichnung
+    ReplayRecorder replay_;                  // Eingaben der Sitzung, zum Nachrechnen
+    std::string replayPath_;
+    std::string tracePath_;                  // Chrome-Trace der letzten Frames
+    bool showFrameHistogram_ = false;
+    std::vector<GameObject> previousBoxes_;  // Boxen vor dem letzten Schritt
+    std::vector<GameObject> renderBoxes_;    // Interpolierte Boxen, wird pro Frame wiederverwendet
+    const float commandExecutionInterval_ = Simulation::kSecondsPerAction; // Sekunden zwischen Befehlen
+    TweenSystem tweens_;                     // Laufende Animationen aller Boxen
+    static constexpr float kJumpHeight = 2.0f;
+
+    void animateMove(int boxIndex, const StepEvent& event) {
+        const GameObject& box = model_->getBoxes()[boxIndex];
+        Position to = positionOf(event.to);
+        tween(boxIndex, TweenProperty::POSITION_X, box.position.x, to.x, 0.3f, Easing::IN_OUT_QUAD);
+        tween(boxIndex, TweenProperty::POSITION_Y, box.position.y, to.y, 0.3f, Easing::IN_OUT_QUAD);
     }
 
-    void rotateSelectedBox(float angle) {
-        if (auto* box = getSelectedBox()) {
-            float targetAngle = box->rotation + angle;
-            currentAnimation_ = std::make_unique<RotateAnimation>(*box, targetAngle, 0.2f);
-            isAnimating_ = true;
-        }
-    }
-
-    GameObject* getSelectedBox() {
-        auto& boxes = model_->getBoxes();
-        auto it = std::find_if(boxes.begin(), boxes.end(),
-                             [](const GameObject& box) { return box.isSelected; });
-        return it != boxes.end() ? &(*it) : nullptr;
-    }
-
-    bool isValidPosition(float x, float y) {
-        // Spielfeldgrenzen prüfen
-        if (x < 0 || x > FIELD_WIDTH || y < 0 || y > FIELD_HEIGHT) {
-            return false;
-        }
-
-        // Kollision mit anderen Boxen prüfen
-        const auto& boxes = model_->getBoxes();
-        for (const auto& box : boxes) {
-            if (!box.isSelected && // Ignoriere ausgewählte Box
-                std::abs(x - box.position.x) < 1.0f &&
-                std::abs(y - box.position.y) < 1.0f) {
-                return false;
-            }
-        }
-
-        return true;
+    void animateRotation(int boxIndex, const StepEvent& event) {
+        // Vierteldrehung ab der angezeigten Rotation, damit die Box nicht von 270° auf 0° zurückdreht
+        float turn = std::fmod(rotationOf(event.toFacing) - rotationOf(event.fromFacing) + 540.0f, 360.0f) - 180.0f;
+        float rotation = model_->getBoxes()[boxIndex].rotation;
+        tween(boxIndex, TweenProperty::ROTATION, rotation, rotation + turn, 0.2f, Easing::IN_OUT_QUAD);
     }
 
     void handleMenuInput(const GameActivityMotionEvent* event) {
@@ -752,13 +575,40 @@ private:
         }
     }
 
+    // Alle Änderungen am Programm laufen hier durch, damit die Aufzeichnung vollständig ist
+    void addCommandToQueue(const Command& command) {
+        commandList_.push_back(command);
+        replay_.commandAdded(timestep_.getStepCount(), command);
+    }
+
+    void clearCommands() {
+        commandList_.clear();
+        replay_.programCleared(timestep_.getStepCount());
+    }
+
     void startCodeExecution() {
-        if (gameState_ != GameState::CODING || !commandQueue_.empty()) {
+        if (gameState_ != GameState::CODING || commandList_.empty()) {
+            return;
+        }
+
+        // Programm übersetzen, fehlerhafte Programme gar nicht erst starten
+        simulation_.loadLevel(model_->getLevel());
+        // Mit mehreren Boxen führen alle das Programm gleichzeitig aus. Eine Box auswählen
+        // kann man im Spiel nicht, sonst bliebe nur die erste Box lenkbar.
+        bool parallel = simulation_.getBoxes().size() > 1;
+        bool loaded = parallel ? simulation_.loadParallelPrograms({commandList_})
+                               : simulation_.loadProgram(commandList_);
+        if (!loaded) {
+            audioManager_->playSound("error", 1.0f);
             return;
         }
         
         gameState_ = GameState::PLAYING;
-        executionTimer_ = 0.0f;
+        ticksSinceCommand_ = 0;
+        roundsExecuted_ = 0;
+        actionsExecuted_ = 0;
+        replay_.executionStarted(timestep_.getStepCount(), parallel);
+        savePreviousState();
         executeNextCommand();
     }
 
@@ -768,17 +618,22 @@ private:
         }
         
         gameState_ = GameState::CODING;
-        commandQueue_ = std::queue<Command>(); // Queue leeren
+        replay_.executionStopped(timestep_.getStepCount(), actionsExecuted_);
+        simulation_.stopProgram(); // Programm anhalten
+        tweens_.clear();           // Laufende Spuren würden die Boxen sonst wieder verschieben
         resetBoxPositions();
     }
 
     void resetLevel() {
         stopCodeExecution();
-        model_->initializeLevel(currentLevel_);
-        commandQueue_ = std::queue<Command>();
-        isAnimating_ = false;
-        currentAnimation_ = nullptr;
-        executionTimer_ = 0.0f;
+        // Gleicher Startwert, damit sich die Dekoration beim Zurücksetzen nicht verschiebt
+        model_->initializeLevel(currentLevel_, model_->getLevelSeed());
+        replay_.levelReset(timestep_.getStepCount());
+        simulation_.loadLevel(model_->getLevel());
+        tweens_.clear();
+        ticksSinceCommand_ = 0;
+        roundsExecuted_ = 0;
+        savePreviousState();
     }
 
     void loadSoundEffects() {
@@ -791,8 +646,6 @@ private:
         audioManager_->loadSound("error", "sounds/error.wav");
     }
 
-    static constexpr float FIELD_WIDTH = 8.0f;
-    static constexpr float FIELD_HEIGHT = 8.0f;
     Rect playButtonRect_;
     Rect stopButtonRect_;
     Rect resetButtonRect_;
@@ -0,0 +1,67 @@
+#include "Grader.h"
+
+#include "Simulation.h"
+#include <memory>
+
+Grader::Grader(ThreadPool& pool) : pool_(pool) {}
+
+const Level& Grader::getLevel(int levelNumber) {
+    auto it = levels_.find(levelNumber);
+    if (it == levels_.end()) {
+        it = levels_.emplace(levelNumber, levelSource_.createLevel(levelNumber)).first;
+    }
+    return it->second;
+}
+
+std::vector<GradeResult> Grader::grade(const std::vector<Submission>& submissions) {
+    std::vector<GradeResult> results(submissions.size());
+
+    // Alle Level vorher bauen, während der Bewertung wird levels_ nur gelesen
+    for (const auto& submission : submissions) {
+        getLevel(submission.levelNumber);
+    }
+
+    // Eine Simulation pro Worker, damit Speicher zwischen den Lösungen wiederverwendet wird
+    struct WorkerState {
+        Simulation simulation;
+        int loadedLevel = -1;
+    };
+    std::vector<std::unique_ptr<WorkerState>> workers;
+    for (unsigned i = 0; i < pool_.getWorkerCount(); i++) {
+        workers.push_back(std::make_unique<WorkerState>());
+    }
+
+    pool_.parallelFor(submissions.size(), 64, [&](size_t begin, size_t end, unsigned worker) {
+        WorkerState& state = *workers[worker];
+        for (size_t i = begin; i < end; i++) {
+            const Submission& submission = submissions[i];
+            const Level& level = levels_.find(submission.levelNumber)->second;
+            GradeResult& result = results[i];
+            int commandCount = static_cast<int>(submission.program.size());
+
+            if (state.loadedLevel != submission.levelNumber) {
+                state.simulation.loadLevel(level);
+                state.loadedLevel = submission.levelNumber;
+            }
+
+            result.compiled = submission.parallel
+                    ? state.simulation.loadParallelPrograms({submission.program})
+                    : state.simulation.loadProgram(submission.program);
+            if (!result.compiled) {
+                result.solved = false;
+                result.completion = LevelCompletion{0, 0, commandCount, 0.0f, false};
+                continue;
+            }
+
+            state.simulation.reset();
+            RunResult run = state.simulation.run();
+            float timeSpent = Simulation::secondsFor(run.rounds);
+            result.solved = run.solved;
+            result.completion = run.solved
+                    ? GameModel::scoreSolution(level, commandCount, timeSpent)
+                    : LevelCompletion{0, 0, commandCount, timeSpent, false};
+        }
+    });
+
+    return results;
+}
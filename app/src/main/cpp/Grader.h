@@ -0,0 +1,53 @@
+#ifndef CODINI_GRADER_H
+#define CODINI_GRADER_H
+
+#include "Command.h"
+#include "Model.h"
+#include "ThreadPool.h"
+#include <map>
+#include <vector>
+
+// Eine eingereichte Lösung
+struct Submission {
+    int levelNumber;
+    std::vector<Command> program;
+    bool parallel = false;  // Alle Boxen führen das Programm gleichzeitig aus
+};
+
+// Bewertung einer Lösung
+struct GradeResult {
+    LevelCompletion completion;  // Punkte wie in GameModel::completeLevelWithSolution
+    bool compiled;               // Programm war gültig
+    bool solved;                 // Alle Ziele erreicht
+};
+
+/*!
+ * Bewertet viele Lösungen parallel und ohne Animationen. Jede Lösung wird in einer Simulation
+ * ausgeführt und bei Erfolg nach denselben Regeln wie im Spiel gewertet. Die Zeit ergibt sich
+ * deterministisch aus der Anzahl der Takte (Simulation::secondsFor), im Einzelbetrieb ist das
+ * eine Aktion pro Takt.
+ */
+class Grader {
+public:
+    /*!
+     * @param pool Thread-Pool für die Bewertung
+     */
+    explicit Grader(ThreadPool& pool);
+
+    /*!
+     * Bewertet alle Lösungen, das Ergebnis hat dieselbe Reihenfolge wie submissions.
+     */
+    std::vector<GradeResult> grade(const std::vector<Submission>& submissions);
+
+    /*!
+     * @return das Level zur Nummer, wird beim ersten Zugriff gebaut
+     */
+    const Level& getLevel(int levelNumber);
+
+private:
+    ThreadPool& pool_;
+    GameModel levelSource_;
+    std::map<int, Level> levels_;
+};
+
+#endif //CODINI_GRADER_H
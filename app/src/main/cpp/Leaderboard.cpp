@@ -0,0 +1,107 @@
+#include "Leaderboard.h"
+
+#include <algorithm>
+#include <mutex>
+
+#include "UserRegistry.h"
+
+void Leaderboard::Board::set(const std::string& username, int score) {
+    auto it = scores.find(username);
+    if (it != scores.end()) {
+        if (it->second == score) {
+            return;
+        }
+        order.erase(ScoreKey{it->second, username});
+        it->second = score;
+    } else {
+        scores.emplace(username, score);
+    }
+    order.insert(ScoreKey{score, username});
+}
+
+int Leaderboard::Board::rankOf(const std::string& username) const {
+    auto it = scores.find(username);
+    if (it == scores.end()) {
+        return 0;
+    }
+    // Der leere Name steht bei gleicher Punktzahl vorn: gezählt werden nur echt Bessere
+    return static_cast<int>(order.rank(ScoreKey{it->second, std::string()})) + 1;
+}
+
+std::vector<LeaderboardEntry> Leaderboard::Board::top(size_t count) const {
+    std::vector<LeaderboardEntry> entries;
+    entries.reserve(std::min(count, order.size()));
+    order.forEachFirst(count, [&](const ScoreKey& key) {
+        int rank = static_cast<int>(entries.size()) + 1;
+        if (!entries.empty() && entries.back().score == key.score) {
+            rank = entries.back().rank;
+        }
+        entries.push_back(LeaderboardEntry{key.username, key.score, rank});
+    });
+    return entries;
+}
+
+void Leaderboard::apply(const UserProfile& profile) {
+    total_.set(profile.username, profile.progress.totalScore);
+}
+
+void Leaderboard::rebuild(const UserRegistry& users) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    total_ = Board();
+    levels_.clear();
+    users.forEach([&](const UserProfile& profile) {
+        apply(profile);
+        for (const auto& level : profile.progress.levelScores) {
+            levels_[level.first].set(profile.username, level.second);
+        }
+    });
+}
+
+void Leaderboard::update(const UserProfile& profile) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    apply(profile);
+}
+
+void Leaderboard::update(const UserProfile& profile, int levelNumber) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    apply(profile);
+    auto score = profile.progress.levelScores.find(levelNumber);
+    if (score != profile.progress.levelScores.end()) {
+        levels_[levelNumber].set(profile.username, score->second);
+    }
+}
+
+void Leaderboard::updateAllLevels(const UserProfile& profile) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    apply(profile);
+    for (const auto& level : profile.progress.levelScores) {
+        levels_[level.first].set(profile.username, level.second);
+    }
+}
+
+std::vector<LeaderboardEntry> Leaderboard::top(size_t count) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return total_.top(count);
+}
+
+std::vector<LeaderboardEntry> Leaderboard::topForLevel(int levelNumber, size_t count) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = levels_.find(levelNumber);
+    return it != levels_.end() ? it->second.top(count) : std::vector<LeaderboardEntry>();
+}
+
+int Leaderboard::rankOf(const std::string& username) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return total_.rankOf(username);
+}
+
+int Leaderboard::rankForLevel(int levelNumber, const std::string& username) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = levels_.find(levelNumber);
+    return it != levels_.end() ? it->second.rankOf(username) : 0;
+}
+
+size_t Leaderboard::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return total_.order.size();
+}
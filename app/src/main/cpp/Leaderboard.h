@@ -0,0 +1,94 @@
+#ifndef CODINI_LEADERBOARD_H
+#define CODINI_LEADERBOARD_H
+
+#include <cstddef>
+#include <map>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "OrderStatisticTree.h"
+#include "UserProfile.h"
+
+class UserRegistry;
+
+struct LeaderboardEntry {
+    std::string username;
+    int score;
+    int rank;   // 1 = bester, gleiche Punkte ergeben den gleichen Rang
+};
+
+/*!
+ * Rangliste über die Gesamtpunkte und je Level über die Levelpunkte.
+ *
+ * Jede Liste ist ein OrderStatisticTree, sortiert nach Punkten absteigend und bei Gleichstand
+ * nach Namen. Eine Punkteänderung kostet O(log n), Top-K O(log n + K) und der Rang eines
+ * Benutzers O(log n); es wird nie die ganze Klasse sortiert.
+ *
+ * Threadsicher: Abfragen teilen sich eine Lesesperre, Änderungen sperren exklusiv.
+ */
+class Leaderboard {
+public:
+    /*!
+     * Baut alle Listen aus den Profilen neu auf (nach dem Laden).
+     */
+    void rebuild(const UserRegistry& users);
+
+    /*!
+     * Übernimmt die Gesamtpunkte des Profils (z.B. nach der Registrierung).
+     */
+    void update(const UserProfile& profile);
+
+    /*!
+     * Übernimmt die Gesamtpunkte und die Punkte des Levels levelNumber.
+     */
+    void update(const UserProfile& profile, int levelNumber);
+
+    /*!
+     * Übernimmt die Gesamtpunkte und die Punkte aller Level des Profils (z.B. nach einem Sync).
+     */
+    void updateAllLevels(const UserProfile& profile);
+
+    std::vector<LeaderboardEntry> top(size_t count) const;
+    std::vector<LeaderboardEntry> topForLevel(int levelNumber, size_t count) const;
+
+    /*!
+     * @return den Rang (1 = bester) oder 0, wenn der Benutzer nicht in der Liste steht
+     */
+    int rankOf(const std::string& username) const;
+    int rankForLevel(int levelNumber, const std::string& username) const;
+
+    size_t size() const;
+
+private:
+    struct ScoreKey {
+        int score = 0;
+        std::string username;
+    };
+
+    // Höhere Punkte zuerst, bei Gleichstand alphabetisch
+    struct ScoreOrder {
+        bool operator()(const ScoreKey& a, const ScoreKey& b) const {
+            if (a.score != b.score) return a.score > b.score;
+            return a.username < b.username;
+        }
+    };
+
+    struct Board {
+        OrderStatisticTree<ScoreKey, ScoreOrder> order;
+        std::unordered_map<std::string, int> scores;
+
+        void set(const std::string& username, int score);
+        int rankOf(const std::string& username) const;
+        std::vector<LeaderboardEntry> top(size_t count) const;
+    };
+
+    void apply(const UserProfile& profile);
+
+    mutable std::shared_mutex mutex_;
+    Board total_;
+    std::map<int, Board> levels_;
+};
+
+#endif //CODINI_LEADERBOARD_H
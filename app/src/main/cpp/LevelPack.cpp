@@ -0,0 +1,223 @@
+#include "LevelPack.h"
+
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace LevelPackFormat;
+
+namespace {
+    constexpr size_t kCommandTypeCount = static_cast<size_t>(CommandType::ACTIVATE_SWITCH) + 1;
+    constexpr size_t kObjectTypeCount = static_cast<size_t>(LevelObject::Type::OBSTACLE) + 1;
+    constexpr size_t kDifficultyCount = static_cast<size_t>(Difficulty::EXPERT) + 1;
+    constexpr size_t kThemeCount = static_cast<size_t>(ThemeType::ROBOT_LAB) + 1;
+
+    size_t align4(size_t value) {
+        return (value + 3) & ~size_t(3);
+    }
+
+    bool fail(std::string* error, const char* message) {
+        if (error) {
+            *error = message;
+        }
+        return false;
+    }
+
+    template<typename T>
+    PackArray<T> takeArray(const uint8_t*& cursor, size_t count) {
+        PackArray<T> array(reinterpret_cast<const T*>(cursor), count);
+        cursor += count * sizeof(T);
+        return array;
+    }
+}
+
+size_t LevelPackFormat::payloadSize(const LevelRecord& record) {
+    return (record.startCount + record.targetCount) * sizeof(TileRef)
+           + record.objectCount * sizeof(ObjectRecord)
+           + align4(record.commandCount)
+           + (record.requiredCount + record.tutorialCount + record.hintCount) * sizeof(StringRef);
+}
+
+std::string_view LevelView::string(const StringRef& ref) const {
+    if (ref.offset > strings_.size() || ref.length > strings_.size() - ref.offset) {
+        return {};
+    }
+    return strings_.substr(ref.offset, ref.length);
+}
+
+LevelDefinition LevelView::toDefinition() const {
+    LevelDefinition definition{};
+    definition.levelNumber = getLevelNumber();
+    definition.name = std::string(getName());
+    definition.description = std::string(getDescription());
+    definition.difficulty = getDifficulty();
+    definition.theme = getTheme();
+    for (const auto& tile : starts_) {
+        definition.startPositions.push_back({static_cast<float>(tile.x), static_cast<float>(tile.y)});
+    }
+    for (const auto& tile : targets_) {
+        definition.targetPositions.push_back({static_cast<float>(tile.x), static_cast<float>(tile.y)});
+    }
+    for (const auto& object : objects_) {
+        definition.objects.push_back({
+            static_cast<LevelObject::Type>(object.type),
+            {static_cast<float>(object.tile.x), static_cast<float>(object.tile.y)},
+            object.isActive != 0,
+            object.linkedId,
+            std::string(string(object.texture))
+        });
+    }
+    definition.availableCommands.assign(commands_.begin(), commands_.end());
+    definition.criteria.maxCommands = getMaxCommands();
+    definition.criteria.timeLimit = getTimeLimit();
+    definition.criteria.minItemsCollected = getMinItemsCollected();
+    definition.criteria.requireOptimalPath = requiresOptimalPath();
+    for (const auto& ref : required_) {
+        definition.criteria.requiredCommands.emplace_back(string(ref));
+    }
+    for (const auto& ref : tutorials_) {
+        definition.tutorials.emplace_back(string(ref));
+    }
+    for (const auto& ref : hints_) {
+        definition.hints.emplace_back(string(ref));
+    }
+    return definition;
+}
+
+bool LevelPack::open(const void* data, size_t size, std::shared_ptr<const void> owner,
+                     std::string* error) {
+    close();
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    if (!bytes || size < sizeof(Header)) {
+        return fail(error, "level pack too small");
+    }
+    if (reinterpret_cast<uintptr_t>(bytes) % alignof(Header) != 0) {
+        return fail(error, "level pack is not aligned");
+    }
+
+    const auto* header = reinterpret_cast<const Header*>(bytes);
+    if (std::memcmp(header->magic, kMagic, sizeof(kMagic)) != 0) {
+        return fail(error, "not a level pack");
+    }
+    if (header->version != kVersion || header->headerSize != sizeof(Header)) {
+        return fail(error, "unsupported level pack version");
+    }
+    if (header->totalSize != size) {
+        return fail(error, "level pack size mismatch");
+    }
+    if (header->indexOffset % alignof(IndexEntry) != 0 || header->indexOffset > size ||
+        header->indexSlots > (size - header->indexOffset) / sizeof(IndexEntry)) {
+        return fail(error, "level pack index out of range");
+    }
+    if (header->stringsOffset > size || header->stringsSize > size - header->stringsOffset) {
+        return fail(error, "level pack strings out of range");
+    }
+
+    data_ = bytes;
+    size_ = size;
+    header_ = header;
+    index_ = reinterpret_cast<const IndexEntry*>(bytes + header->indexOffset);
+    strings_ = std::string_view(reinterpret_cast<const char*>(bytes + header->stringsOffset),
+                                header->stringsSize);
+    owner_ = std::move(owner);
+    return true;
+}
+
+bool LevelPack::openFile(const std::string& path, std::string* error) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return fail(error, "level pack can't be opened");
+    }
+    struct stat info{};
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        ::close(fd);
+        return fail(error, "level pack is empty");
+    }
+    size_t size = static_cast<size_t>(info.st_size);
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        return fail(error, "level pack can't be mapped");
+    }
+
+    std::shared_ptr<const void> owner(mapping, [size](const void* address) {
+        munmap(const_cast<void*>(address), size);
+    });
+    return open(mapping, size, std::move(owner), error);
+}
+
+void LevelPack::close() {
+    data_ = nullptr;
+    size_ = 0;
+    header_ = nullptr;
+    index_ = nullptr;
+    strings_ = {};
+    owner_.reset();
+}
+
+std::vector<int> LevelPack::getLevelNumbers() const {
+    std::vector<int> numbers;
+    if (!header_) {
+        return numbers;
+    }
+    for (uint32_t slot = 0; slot < header_->indexSlots; slot++) {
+        if (index_[slot].size != 0) {
+            numbers.push_back(header_->firstLevelNumber + static_cast<int>(slot));
+        }
+    }
+    return numbers;
+}
+
+bool LevelPack::find(int levelNumber, LevelView& outView) const {
+    if (!header_) {
+        return false;
+    }
+    int64_t slot = static_cast<int64_t>(levelNumber) - header_->firstLevelNumber;
+    if (slot < 0 || slot >= header_->indexSlots) {
+        return false;
+    }
+    const IndexEntry& entry = index_[slot];
+    if (entry.size < sizeof(LevelRecord) || entry.offset % alignof(LevelRecord) != 0 ||
+        entry.offset > size_ || entry.size > size_ - entry.offset) {
+        return false;
+    }
+
+    // Nur dieses Level prüfen, der Rest des Pakets wird nicht angefasst
+    const auto* record = reinterpret_cast<const LevelRecord*>(data_ + entry.offset);
+    if (record->levelNumber != levelNumber ||
+        record->difficulty >= kDifficultyCount || record->theme >= kThemeCount ||
+        sizeof(LevelRecord) + payloadSize(*record) > entry.size) {
+        return false;
+    }
+
+    LevelView view;
+    view.record_ = record;
+    view.strings_ = strings_;
+    const uint8_t* cursor = data_ + entry.offset + sizeof(LevelRecord);
+    view.starts_ = takeArray<TileRef>(cursor, record->startCount);
+    view.targets_ = takeArray<TileRef>(cursor, record->targetCount);
+    view.objects_ = takeArray<ObjectRecord>(cursor, record->objectCount);
+    const uint8_t* commands = cursor;
+    view.commands_ = PackArray<CommandType>(reinterpret_cast<const CommandType*>(commands),
+                                            record->commandCount);
+    cursor += align4(record->commandCount);
+    view.required_ = takeArray<StringRef>(cursor, record->requiredCount);
+    view.tutorials_ = takeArray<StringRef>(cursor, record->tutorialCount);
+    view.hints_ = takeArray<StringRef>(cursor, record->hintCount);
+
+    for (uint16_t i = 0; i < record->commandCount; i++) {
+        if (commands[i] >= kCommandTypeCount) {
+            return false;
+        }
+    }
+    for (const auto& object : view.objects_) {
+        if (object.type >= kObjectTypeCount) {
+            return false;
+        }
+    }
+
+    outView = view;
+    return true;
+}
@@ -0,0 +1,214 @@
+#ifndef CODINI_LEVEL_PACK_H
+#define CODINI_LEVEL_PACK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Command.h"
+#include "LevelDefinitions.h"
+
+/*
+ * Binäres Level-Paket (Version 1), little-endian, alle Abschnitte auf 4 Byte ausgerichtet:
+ *
+ *   Header
+ *   IndexEntry[indexSlots]     Level firstLevelNumber + i, size == 0 für Lücken
+ *   LevelRecord ...            jeweils gefolgt von seinen Arrays (siehe LevelRecord)
+ *   Zeichenketten              UTF-8 ohne Nullterminator, über StringRef adressiert
+ *
+ * Das Paket wird nie geparst: LevelView zeigt direkt in den Speicher (mmap oder
+ * AAsset_getBuffer), nur das angefragte Level wird beim Zugriff auf Grenzen geprüft.
+ */
+namespace LevelPackFormat {
+    constexpr char kMagic[4] = {'C', 'L', 'V', 'P'};
+    constexpr uint16_t kVersion = 1;
+
+    struct Header {
+        char magic[4];
+        uint16_t version;
+        uint16_t headerSize;
+        uint32_t totalSize;
+        uint32_t levelCount;
+        int32_t firstLevelNumber;
+        uint32_t indexSlots;
+        uint32_t indexOffset;
+        uint32_t stringsOffset;
+        uint32_t stringsSize;
+    };
+
+    struct IndexEntry {
+        uint32_t offset;
+        uint32_t size;
+    };
+
+    struct StringRef {
+        uint32_t offset;  // relativ zum Zeichenkettenblock
+        uint32_t length;
+    };
+
+    struct TileRef {
+        int16_t x;
+        int16_t y;
+    };
+
+    struct ObjectRecord {
+        uint8_t type;      // LevelObject::Type
+        uint8_t isActive;
+        int16_t linkedId;
+        TileRef tile;
+        StringRef texture;
+    };
+
+    /*
+     * Auf den Record folgen in dieser Reihenfolge:
+     *   TileRef starts[startCount], TileRef targets[targetCount], ObjectRecord objects[objectCount],
+     *   uint8_t commands[commandCount] (auf 4 Byte aufgefüllt),
+     *   StringRef required[requiredCount], tutorials[tutorialCount], hints[hintCount]
+     */
+    struct LevelRecord {
+        int32_t levelNumber;
+        uint8_t difficulty;
+        uint8_t theme;
+        uint8_t requireOptimalPath;
+        uint8_t reserved;
+        StringRef name;
+        StringRef description;
+        int32_t maxCommands;
+        float timeLimit;
+        int32_t minItemsCollected;
+        uint16_t startCount;
+        uint16_t targetCount;
+        uint16_t objectCount;
+        uint16_t commandCount;
+        uint16_t requiredCount;
+        uint16_t tutorialCount;
+        uint16_t hintCount;
+        uint16_t reserved2;
+    };
+
+    static_assert(sizeof(Header) == 36, "Header layout");
+    static_assert(sizeof(IndexEntry) == 8, "IndexEntry layout");
+    static_assert(sizeof(ObjectRecord) == 16, "ObjectRecord layout");
+    static_assert(sizeof(LevelRecord) == 52, "LevelRecord layout");
+
+    /*!
+     * @return die Größe der Arrays hinter einem Record in Bytes
+     */
+    size_t payloadSize(const LevelRecord& record);
+}
+
+// Nur lesende Sicht auf ein zusammenhängendes Array im Paket
+template<typename T>
+class PackArray {
+public:
+    PackArray() = default;
+    PackArray(const T* data, size_t size) : data_(data), size_(size) {}
+
+    const T* begin() const { return data_; }
+    const T* end() const { return data_ + size_; }
+    const T& operator[](size_t index) const { return data_[index]; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+private:
+    const T* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+/*!
+ * Ein Level im Paket. Alle Zugriffe lesen direkt aus dem Paketspeicher, die Sicht ist nur
+ * gültig, solange das LevelPack lebt.
+ */
+class LevelView {
+public:
+    int getLevelNumber() const { return record_->levelNumber; }
+    std::string_view getName() const { return string(record_->name); }
+    std::string_view getDescription() const { return string(record_->description); }
+    Difficulty getDifficulty() const { return static_cast<Difficulty>(record_->difficulty); }
+    ThemeType getTheme() const { return static_cast<ThemeType>(record_->theme); }
+
+    PackArray<LevelPackFormat::TileRef> getStarts() const { return starts_; }
+    PackArray<LevelPackFormat::TileRef> getTargets() const { return targets_; }
+    PackArray<LevelPackFormat::ObjectRecord> getObjects() const { return objects_; }
+    PackArray<CommandType> getAvailableCommands() const { return commands_; }
+
+    int getMaxCommands() const { return record_->maxCommands; }
+    float getTimeLimit() const { return record_->timeLimit; }
+    int getMinItemsCollected() const { return record_->minItemsCollected; }
+    bool requiresOptimalPath() const { return record_->requireOptimalPath != 0; }
+    PackArray<LevelPackFormat::StringRef> getRequiredCommands() const { return required_; }
+    PackArray<LevelPackFormat::StringRef> getTutorials() const { return tutorials_; }
+    PackArray<LevelPackFormat::StringRef> getHints() const { return hints_; }
+
+    /*!
+     * @return eine Zeichenkette aus dem Paket, leer bei ungültigem Verweis
+     */
+    std::string_view string(const LevelPackFormat::StringRef& ref) const;
+
+    /*!
+     * Kopiert das Level in eine LevelDefinition, z.B. für Werkzeuge und Tests.
+     */
+    LevelDefinition toDefinition() const;
+
+private:
+    friend class LevelPack;
+
+    const LevelPackFormat::LevelRecord* record_ = nullptr;
+    std::string_view strings_;
+    PackArray<LevelPackFormat::TileRef> starts_;
+    PackArray<LevelPackFormat::TileRef> targets_;
+    PackArray<LevelPackFormat::ObjectRecord> objects_;
+    PackArray<CommandType> commands_;
+    PackArray<LevelPackFormat::StringRef> required_;
+    PackArray<LevelPackFormat::StringRef> tutorials_;
+    PackArray<LevelPackFormat::StringRef> hints_;
+};
+
+/*!
+ * Geöffnetes Level-Paket. Der Speicher gehört dem Paket (über owner) oder dem Aufrufer, er wird
+ * nie kopiert. Zugriff auf ein Level über seine Nummer ist ein Indexzugriff.
+ */
+class LevelPack {
+public:
+    /*!
+     * Öffnet ein Paket im Speicher. owner hält den Speicher am Leben (z.B. munmap oder
+     * AAsset_close im Deleter) und darf nullptr sein, wenn der Aufrufer dafür sorgt.
+     * @return false mit Grund in error, wenn der Header ungültig ist
+     */
+    bool open(const void* data, size_t size, std::shared_ptr<const void> owner = nullptr,
+              std::string* error = nullptr);
+
+    /*!
+     * Blendet eine Paketdatei mit mmap ein.
+     */
+    bool openFile(const std::string& path, std::string* error = nullptr);
+
+    void close();
+
+    bool isOpen() const { return header_ != nullptr; }
+    size_t getLevelCount() const { return header_ ? header_->levelCount : 0; }
+
+    /*!
+     * @return alle Levelnummern im Paket, aufsteigend
+     */
+    std::vector<int> getLevelNumbers() const;
+
+    /*!
+     * Sucht ein Level über den Index.
+     * @return false, wenn es fehlt oder sein Eintrag außerhalb des Pakets liegt
+     */
+    bool find(int levelNumber, LevelView& outView) const;
+
+private:
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    const LevelPackFormat::Header* header_ = nullptr;
+    const LevelPackFormat::IndexEntry* index_ = nullptr;
+    std::string_view strings_;
+    std::shared_ptr<const void> owner_;
+};
+
+#endif //CODINI_LEVEL_PACK_H
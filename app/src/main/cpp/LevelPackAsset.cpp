@@ -0,0 +1,23 @@
+#include "LevelPackAsset.h"
+
+bool openLevelPackAsset(AAssetManager* assetManager, const std::string& path, LevelPack& pack,
+                        std::string* error) {
+    AAsset* asset = AAssetManager_open(assetManager, path.c_str(), AASSET_MODE_BUFFER);
+    if (!asset) {
+        if (error) *error = "level pack asset not found";
+        return false;
+    }
+
+    const void* buffer = AAsset_getBuffer(asset);
+    size_t size = static_cast<size_t>(AAsset_getLength64(asset));
+    if (!buffer) {
+        AAsset_close(asset);
+        if (error) *error = "level pack asset can't be mapped";
+        return false;
+    }
+
+    std::shared_ptr<const void> owner(asset, [](const void* handle) {
+        AAsset_close(static_cast<AAsset*>(const_cast<void*>(handle)));
+    });
+    return pack.open(buffer, size, std::move(owner), error);
+}
@@ -0,0 +1,17 @@
+#ifndef CODINI_LEVEL_PACK_ASSET_H
+#define CODINI_LEVEL_PACK_ASSET_H
+
+#include <android/asset_manager.h>
+#include <string>
+
+#include "LevelPack.h"
+
+/*!
+ * Öffnet ein Level-Paket aus den App-Assets. Das Asset bleibt offen, solange das Paket lebt;
+ * AAsset_getBuffer liefert bei unkomprimierten Assets direkt den eingeblendeten APK-Inhalt.
+ * @return false mit Grund in error, wenn das Asset fehlt oder kein gültiges Paket ist
+ */
+bool openLevelPackAsset(AAssetManager* assetManager, const std::string& path, LevelPack& pack,
+                        std::string* error = nullptr);
+
+#endif //CODINI_LEVEL_PACK_ASSET_H
@@ -0,0 +1,317 @@
+#include "LevelPackBuilder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <sstream>
+#include <unordered_map>
+
+#include "LevelPack.h"
+
+using namespace LevelPackFormat;
+
+namespace {
+    constexpr uint32_t kMaxIndexSlots = 1 << 16;
+
+    const char* const kDifficultyNames[] = {"EASY", "MEDIUM", "HARD", "EXPERT"};
+    const char* const kThemeNames[] = {"SPACE", "OCEAN", "FOREST", "ROBOT_LAB"};
+    const char* const kObjectNames[] = {
+        "WALL", "BRIDGE", "SWITCH", "DOOR", "ITEM", "TELEPORTER", "OBSTACLE"
+    };
+
+    template<size_t N>
+    bool lookup(const char* const (&names)[N], const std::string& name, int& outValue) {
+        for (size_t i = 0; i < N; i++) {
+            if (name == names[i]) {
+                outValue = static_cast<int>(i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Rest der Zeile nach dem Schlüsselwort, ohne führende Leerzeichen
+    std::string restOf(std::istringstream& stream) {
+        std::string rest;
+        std::getline(stream >> std::ws, rest);
+        while (!rest.empty() && (rest.back() == '\r' || rest.back() == ' ' || rest.back() == '\t')) {
+            rest.pop_back();
+        }
+        return rest;
+    }
+
+    bool readPosition(std::istringstream& stream, Position& outPosition) {
+        int x = 0;
+        int y = 0;
+        if (!(stream >> x >> y)) {
+            return false;
+        }
+        outPosition = Position{static_cast<float>(x), static_cast<float>(y)};
+        return true;
+    }
+
+    // Sammelt Zeichenketten, gleiche Texte werden nur einmal abgelegt
+    class PackStrings {
+    public:
+        StringRef add(const std::string& text) {
+            auto it = offsets_.find(text);
+            if (it == offsets_.end()) {
+                it = offsets_.emplace(text, static_cast<uint32_t>(data_.size())).first;
+                data_ += text;
+            }
+            return StringRef{it->second, static_cast<uint32_t>(text.size())};
+        }
+
+        const std::string& data() const { return data_; }
+
+    private:
+        std::string data_;
+        std::unordered_map<std::string, uint32_t> offsets_;
+    };
+
+    template<typename T>
+    void append(std::vector<uint8_t>& out, const T& value) {
+        const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+        out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
+
+    void padTo4(std::vector<uint8_t>& out) {
+        out.resize((out.size() + 3) & ~size_t(3), 0);
+    }
+
+    TileRef toTile(const Position& position) {
+        return TileRef{static_cast<int16_t>(std::lround(position.x)),
+                       static_cast<int16_t>(std::lround(position.y))};
+    }
+
+    bool fitsCount(size_t count) {
+        return count <= UINT16_MAX;
+    }
+}
+
+bool parseLevelSource(std::istream& input, std::vector<LevelDefinition>& outLevels,
+                      std::string& error) {
+    std::string line;
+    int lineNumber = 0;
+    LevelDefinition* level = nullptr;
+
+    auto failAt = [&](const std::string& message) {
+        error = "line " + std::to_string(lineNumber) + ": " + message;
+        return false;
+    };
+
+    while (std::getline(input, line)) {
+        lineNumber++;
+        std::istringstream stream(line);
+        std::string key;
+        if (!(stream >> key) || key[0] == '#') {
+            continue;
+        }
+
+        if (key == "level") {
+            LevelDefinition definition{};
+            definition.difficulty = Difficulty::EASY;
+            definition.theme = ThemeType::SPACE;
+            definition.criteria = LevelCriteria{0, 0.0f, 0, false, {}};
+            if (!(stream >> definition.levelNumber)) {
+                return failAt("level number expected");
+            }
+            outLevels.push_back(std::move(definition));
+            level = &outLevels.back();
+            continue;
+        }
+        if (!level) {
+            return failAt("'" + key + "' before the first level");
+        }
+
+        if (key == "name") {
+            level->name = restOf(stream);
+        } else if (key == "description") {
+            level->description = restOf(stream);
+        } else if (key == "difficulty" || key == "theme") {
+            std::string name;
+            int value = 0;
+            stream >> name;
+            bool found = key == "difficulty" ? lookup(kDifficultyNames, name, value)
+                                             : lookup(kThemeNames, name, value);
+            if (!found) {
+                return failAt("unknown " + key + " '" + name + "'");
+            }
+            if (key == "difficulty") {
+                level->difficulty = static_cast<Difficulty>(value);
+            } else {
+                level->theme = static_cast<ThemeType>(value);
+            }
+        } else if (key == "start" || key == "target") {
+            Position position{};
+            if (!readPosition(stream, position)) {
+                return failAt("position expected");
+            }
+            (key == "start" ? level->startPositions : level->targetPositions).push_back(position);
+        } else if (key == "object") {
+            std::string type;
+            std::string state;
+            int typeValue = 0;
+            LevelObject object{};
+            stream >> type;
+            if (!lookup(kObjectNames, type, typeValue)) {
+                return failAt("unknown object type '" + type + "'");
+            }
+            if (!readPosition(stream, object.position) || !(stream >> state >> object.linkedId) ||
+                (state != "on" && state != "off")) {
+                return failAt("expected: object <type> <x> <y> <on|off> <linkedId> [texture]");
+            }
+            object.type = static_cast<LevelObject::Type>(typeValue);
+            object.isActive = state == "on";
+            object.textureId = restOf(stream);
+            level->objects.push_back(std::move(object));
+        } else if (key == "commands") {
+            std::string token;
+            while (stream >> token) {
+                Command command{CommandType::MOVE_FORWARD};
+                if (!parseCommand(token, command)) {
+                    return failAt("unknown command '" + token + "'");
+                }
+                level->availableCommands.push_back(command.type);
+            }
+        } else if (key == "max_commands") {
+            if (!(stream >> level->criteria.maxCommands)) return failAt("number expected");
+        } else if (key == "time_limit") {
+            if (!(stream >> level->criteria.timeLimit)) return failAt("number expected");
+        } else if (key == "min_items") {
+            if (!(stream >> level->criteria.minItemsCollected)) return failAt("number expected");
+        } else if (key == "optimal_path") {
+            std::string value;
+            stream >> value;
+            if (value != "yes" && value != "no") {
+                return failAt("yes or no expected");
+            }
+            level->criteria.requireOptimalPath = value == "yes";
+        } else if (key == "required") {
+            std::string token;
+            while (stream >> token) {
+                level->criteria.requiredCommands.push_back(token);
+            }
+        } else if (key == "tutorial") {
+            level->tutorials.push_back(restOf(stream));
+        } else if (key == "hint") {
+            level->hints.push_back(restOf(stream));
+        } else {
+            return failAt("unknown key '" + key + "'");
+        }
+    }
+    return true;
+}
+
+bool buildLevelPack(const std::vector<LevelDefinition>& levels, std::vector<uint8_t>& outPack,
+                    std::string& error) {
+    // Nach Nummer sortiert, damit der Index ein einfaches Array wird
+    std::map<int, const LevelDefinition*> byNumber;
+    for (const auto& level : levels) {
+        if (!byNumber.emplace(level.levelNumber, &level).second) {
+            error = "level " + std::to_string(level.levelNumber) + " is defined twice";
+            return false;
+        }
+    }
+
+    Header header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.headerSize = sizeof(Header);
+    header.levelCount = static_cast<uint32_t>(byNumber.size());
+    if (!byNumber.empty()) {
+        int64_t slots = static_cast<int64_t>(byNumber.rbegin()->first) - byNumber.begin()->first + 1;
+        if (slots > kMaxIndexSlots) {
+            error = "level numbers are too far apart for the index";
+            return false;
+        }
+        header.firstLevelNumber = byNumber.begin()->first;
+        header.indexSlots = static_cast<uint32_t>(slots);
+    }
+    header.indexOffset = sizeof(Header);
+
+    std::vector<IndexEntry> index(header.indexSlots, IndexEntry{0, 0});
+    std::vector<uint8_t> body;
+    PackStrings strings;
+    const size_t bodyOffset = sizeof(Header) + index.size() * sizeof(IndexEntry);
+
+    for (const auto& entry : byNumber) {
+        const LevelDefinition& level = *entry.second;
+        const LevelCriteria& criteria = level.criteria;
+        if (!fitsCount(level.startPositions.size()) || !fitsCount(level.targetPositions.size()) ||
+            !fitsCount(level.objects.size()) || !fitsCount(level.availableCommands.size()) ||
+            !fitsCount(criteria.requiredCommands.size()) || !fitsCount(level.tutorials.size()) ||
+            !fitsCount(level.hints.size())) {
+            error = "level " + std::to_string(level.levelNumber) + " is too large";
+            return false;
+        }
+
+        size_t start = body.size();
+        LevelRecord record{};
+        record.levelNumber = level.levelNumber;
+        record.difficulty = static_cast<uint8_t>(level.difficulty);
+        record.theme = static_cast<uint8_t>(level.theme);
+        record.requireOptimalPath = criteria.requireOptimalPath ? 1 : 0;
+        record.name = strings.add(level.name);
+        record.description = strings.add(level.description);
+        record.maxCommands = criteria.maxCommands;
+        record.timeLimit = criteria.timeLimit;
+        record.minItemsCollected = criteria.minItemsCollected;
+        record.startCount = static_cast<uint16_t>(level.startPositions.size());
+        record.targetCount = static_cast<uint16_t>(level.targetPositions.size());
+        record.objectCount = static_cast<uint16_t>(level.objects.size());
+        record.commandCount = static_cast<uint16_t>(level.availableCommands.size());
+        record.requiredCount = static_cast<uint16_t>(criteria.requiredCommands.size());
+        record.tutorialCount = static_cast<uint16_t>(level.tutorials.size());
+        record.hintCount = static_cast<uint16_t>(level.hints.size());
+        append(body, record);
+
+        for (const auto& position : level.startPositions) {
+            append(body, toTile(position));
+        }
+        for (const auto& position : level.targetPositions) {
+            append(body, toTile(position));
+        }
+        for (const auto& object : level.objects) {
+            ObjectRecord packed{};
+            packed.type = static_cast<uint8_t>(object.type);
+            packed.isActive = object.isActive ? 1 : 0;
+            packed.linkedId = static_cast<int16_t>(object.linkedId);
+            packed.tile = toTile(object.position);
+            packed.texture = strings.add(object.textureId);
+            append(body, packed);
+        }
+        for (CommandType command : level.availableCommands) {
+            body.push_back(static_cast<uint8_t>(command));
+        }
+        padTo4(body);
+        for (const auto& name : criteria.requiredCommands) {
+            append(body, strings.add(name));
+        }
+        for (const auto& text : level.tutorials) {
+            append(body, strings.add(text));
+        }
+        for (const auto& text : level.hints) {
+            append(body, strings.add(text));
+        }
+
+        index[static_cast<size_t>(level.levelNumber - header.firstLevelNumber)] = IndexEntry{
+            static_cast<uint32_t>(bodyOffset + start), static_cast<uint32_t>(body.size() - start)
+        };
+    }
+
+    header.stringsOffset = static_cast<uint32_t>(bodyOffset + body.size());
+    header.stringsSize = static_cast<uint32_t>(strings.data().size());
+    header.totalSize = header.stringsOffset + header.stringsSize;
+
+    outPack.clear();
+    outPack.reserve(header.totalSize);
+    append(outPack, header);
+    for (const auto& entry : index) {
+        append(outPack, entry);
+    }
+    outPack.insert(outPack.end(), body.begin(), body.end());
+    outPack.insert(outPack.end(), strings.data().begin(), strings.data().end());
+    return true;
+}
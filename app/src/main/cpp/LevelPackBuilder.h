@@ -0,0 +1,45 @@
+#ifndef CODINI_LEVEL_PACK_BUILDER_H
+#define CODINI_LEVEL_PACK_BUILDER_H
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+#include "LevelDefinitions.h"
+
+/*!
+ * Liest Level aus der Textquelle. Jede Zeile beginnt mit einem Schlüsselwort, "level <Nummer>"
+ * beginnt ein neues Level, Leerzeilen und Zeilen mit '#' werden übersprungen:
+ *
+ *   level 1
+ *   name Erste Schritte
+ *   description Lerne die grundlegenden Bewegungsbefehle
+ *   difficulty EASY
+ *   theme ROBOT_LAB
+ *   start 1 1
+ *   target 4 1
+ *   object WALL 2 1 off -1 wall        (Typ, x, y, on/off, linkedId, Textur)
+ *   commands MOVE_FORWARD TURN_LEFT TURN_RIGHT
+ *   max_commands 5
+ *   time_limit 60
+ *   min_items 0
+ *   optimal_path yes
+ *   required MOVE_FORWARD
+ *   tutorial Willkommen beim Programmieren!
+ *   hint Versuche zuerst vorwärts zu gehen
+ *
+ * @return false mit Zeilennummer und Grund in error
+ */
+bool parseLevelSource(std::istream& input, std::vector<LevelDefinition>& outLevels,
+                      std::string& error);
+
+/*!
+ * Schreibt Level im Format aus LevelPack.h. Levelnummern müssen eindeutig sein, Positionen
+ * werden auf ganze Felder gerundet.
+ * @return false mit Grund in error
+ */
+bool buildLevelPack(const std::vector<LevelDefinition>& levels, std::vector<uint8_t>& outPack,
+                    std::string& error);
+
+#endif //CODINI_LEVEL_PACK_BUILDER_H
@@ -0,0 +1,263 @@
+#include "Log.h"
+
+#include <algorithm>
+#include <chrono>
+
+#ifdef __ANDROID__
+#include <android/log.h>
+#endif
+
+namespace {
+    // Der Thread schläft höchstens so lange, falls ein Wecken verloren geht
+    constexpr auto kIdleWait = std::chrono::milliseconds(100);
+
+#ifndef __ANDROID__
+    const char* levelLetter(LogLevel level) {
+        static const char* letters[] = {"V", "D", "I", "W", "E"};
+        return letters[static_cast<size_t>(level)];
+    }
+#endif
+}
+
+Logger::Logger() : cells_(new Cell[kCapacity]), startNs_(nowNs()) {
+    static_assert((kCapacity & (kCapacity - 1)) == 0, "kCapacity must be a power of two");
+    for (size_t i = 0; i < kCapacity; i++) {
+        cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+Logger::~Logger() {
+    if (thread_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_one();
+        thread_.join();
+    }
+    if (output_ != stderr) {
+        std::fclose(output_);
+    }
+}
+
+Logger& Logger::global() {
+    static Logger logger;
+    return logger;
+}
+
+uint64_t Logger::nowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+bool Logger::setOutputFile(const std::string& path) {
+    FILE* file = std::fopen(path.c_str(), "a");
+    if (!file) {
+        return false;
+    }
+    flush();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (output_ != stderr) {
+        std::fclose(output_);
+    }
+    output_ = file;
+    return true;
+}
+
+void Logger::start() {
+    std::call_once(started_, [this] {
+        thread_ = std::thread([this] { run(); });
+    });
+}
+
+bool Logger::reserve(LogRecord& record, LogArgType type, size_t size) {
+    if (record.argCount == LogRecord::kMaxArgs ||
+        LogRecord::kPayloadSize - record.payloadSize < size) {
+        return false;
+    }
+    record.types[record.argCount++] = type;
+    return true;
+}
+
+void Logger::encodeBytes(LogRecord& record, LogArgType type, const void* data, size_t size) {
+    if (reserve(record, type, size)) {
+        std::memcpy(record.payload + record.payloadSize, data, size);
+        record.payloadSize = static_cast<uint8_t>(record.payloadSize + size);
+    }
+}
+
+void Logger::encode(LogRecord& record, std::string_view text) {
+    // Ein Längenbyte, der Rest des Puffers steht für den Text zur Verfügung
+    size_t space = LogRecord::kPayloadSize - record.payloadSize;
+    if (space == 0 || !reserve(record, LogArgType::STRING, 1)) {
+        return;
+    }
+    size_t length = std::min({text.size(), space - 1, size_t{255}});
+    record.payload[record.payloadSize] = static_cast<uint8_t>(length);
+    std::memcpy(record.payload + record.payloadSize + 1, text.data(), length);
+    record.payloadSize = static_cast<uint8_t>(record.payloadSize + 1 + length);
+}
+
+void Logger::push(LogRecord& record) {
+    start();
+    record.timestampNs = nowNs();
+
+    // Begrenzte MPMC-Warteschlange nach Vyukov, jede Zelle trägt ihre eigene Sequenznummer
+    size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+    Cell* cell;
+    for (;;) {
+        cell = &cells_[pos & (kCapacity - 1)];
+        size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+        if (diff == 0) {
+            if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        } else {
+            pos = enqueuePos_.load(std::memory_order_relaxed);
+        }
+    }
+    cell->record = record;
+    cell->sequence.store(pos + 1, std::memory_order_release);
+
+    // Nur wecken, wenn der Thread wirklich wartet, sonst kostet der Eintrag keinen Systemaufruf
+    if (sleeping_.load(std::memory_order_relaxed)) {
+        wake_.notify_one();
+    }
+}
+
+bool Logger::pop(LogRecord& outRecord) {
+    Cell& cell = cells_[dequeuePos_ & (kCapacity - 1)];
+    if (cell.sequence.load(std::memory_order_acquire) != dequeuePos_ + 1) {
+        return false;
+    }
+    outRecord = cell.record;
+    cell.sequence.store(dequeuePos_ + kCapacity, std::memory_order_release);
+    dequeuePos_++;
+    return true;
+}
+
+void Logger::run() {
+    LogRecord record;
+    for (;;) {
+        // Das Lock schützt nur die Ausgabe gegen setOutputFile, Erzeuger nehmen es nie
+        std::unique_lock<std::mutex> lock(mutex_);
+        size_t count = 0;
+        while (pop(record)) {
+            write(record.site->level, record.timestampNs, format(record));
+            count++;
+        }
+
+        uint64_t dropped = dropped_.load(std::memory_order_relaxed);
+        if (dropped != reportedDropped_) {
+            write(LogLevel::WARN, nowNs(),
+                  std::to_string(dropped - reportedDropped_) + " log records dropped");
+            reportedDropped_ = dropped;
+        }
+
+        written_ += count;
+        if (count > 0) {
+            std::fflush(output_);
+        }
+        drained_.notify_all();
+        if (stopping_ && count == 0) {
+            return;
+        }
+        if (count == 0) {
+            sleeping_.store(true, std::memory_order_relaxed);
+            wake_.wait_for(lock, kIdleWait);
+            sleeping_.store(false, std::memory_order_relaxed);
+        }
+    }
+}
+
+void Logger::flush() {
+    if (!thread_.joinable()) {
+        return;
+    }
+    size_t target = enqueuePos_.load(std::memory_order_acquire);
+    std::unique_lock<std::mutex> lock(mutex_);
+    wake_.notify_one();
+    // Verworfene Einträge belegen keine Position, written_ holt enqueuePos_ also ein
+    drained_.wait(lock, [&] { return written_ >= target; });
+}
+
+void Logger::write(LogLevel level, uint64_t timestampNs, const std::string& text) {
+#ifdef __ANDROID__
+    static const int priorities[] = {ANDROID_LOG_VERBOSE, ANDROID_LOG_DEBUG, ANDROID_LOG_INFO,
+                                     ANDROID_LOG_WARN, ANDROID_LOG_ERROR};
+    (void) timestampNs;
+    __android_log_write(priorities[static_cast<size_t>(level)], kTag, text.c_str());
+#else
+    double seconds = static_cast<double>(timestampNs - startNs_) / 1e9;
+    std::fprintf(output_, "%10.3f %s/%s: %s\n", seconds, levelLetter(level), kTag, text.c_str());
+#endif
+}
+
+std::string Logger::format(const LogRecord& record) {
+    std::string text;
+    const char* format = record.site->format;
+    size_t offset = 0;
+    uint8_t arg = 0;
+    char buffer[32];
+
+    for (const char* c = format; *c; c++) {
+        if (c[0] != '{' || c[1] != '}') {
+            text += *c;
+            continue;
+        }
+        c++;
+        if (arg == record.argCount) {
+            text += "{}";
+            continue;
+        }
+
+        const uint8_t* data = record.payload + offset;
+        switch (record.types[arg++]) {
+            case LogArgType::INT: {
+                int64_t value;
+                std::memcpy(&value, data, sizeof(value));
+                std::snprintf(buffer, sizeof(buffer), "%lld", static_cast<long long>(value));
+                offset += sizeof(value);
+                text += buffer;
+                break;
+            }
+            case LogArgType::UINT: {
+                uint64_t value;
+                std::memcpy(&value, data, sizeof(value));
+                std::snprintf(buffer, sizeof(buffer), "%llu", static_cast<unsigned long long>(value));
+                offset += sizeof(value);
+                text += buffer;
+                break;
+            }
+            case LogArgType::DOUBLE: {
+                double value;
+                std::memcpy(&value, data, sizeof(value));
+                std::snprintf(buffer, sizeof(buffer), "%g", value);
+                offset += sizeof(value);
+                text += buffer;
+                break;
+            }
+            case LogArgType::BOOL:
+                text += *data ? "true" : "false";
+                offset += sizeof(bool);
+                break;
+            case LogArgType::STRING:
+                text.append(reinterpret_cast<const char*>(data + 1), data[0]);
+                offset += 1 + data[0];
+                break;
+            case LogArgType::POINTER: {
+                uintptr_t value;
+                std::memcpy(&value, data, sizeof(value));
+                std::snprintf(buffer, sizeof(buffer), "%p", reinterpret_cast<void*>(value));
+                offset += sizeof(value);
+                text += buffer;
+                break;
+            }
+        }
+    }
+    return text;
+}
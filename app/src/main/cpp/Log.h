@@ -0,0 +1,203 @@
+#ifndef CODINI_LOG_H
+#define CODINI_LOG_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+
+enum class LogLevel : uint8_t {
+    VERBOSE,
+    DEBUG,
+    INFO,
+    WARN,
+    ERROR
+};
+
+// Kleinste Stufe, die übersetzt wird. Alles darunter entfällt samt Auswertung der Argumente.
+#ifndef CODINI_LOG_LEVEL
+#ifdef NDEBUG
+#define CODINI_LOG_LEVEL 2  // INFO
+#else
+#define CODINI_LOG_LEVEL 1  // DEBUG
+#endif
+#endif
+
+// Eine Logzeile im Quelltext. Ihre Adresse ist die Id des Formats, der Text wird nie kopiert.
+struct LogSite {
+    LogLevel level;
+    const char* format;  // Platzhalter {} werden der Reihe nach durch die Argumente ersetzt
+};
+
+enum class LogArgType : uint8_t {
+    INT,
+    UINT,
+    DOUBLE,
+    BOOL,
+    STRING,   // Kopiert, mit vorangestellter Länge (ein Byte)
+    POINTER
+};
+
+/*!
+ * Binärer Logeintrag fester Größe: Format-Id, Zeitstempel und die gepackten Argumente. Zu lange
+ * Zeichenketten werden gekürzt, überzählige Argumente entfallen.
+ */
+struct LogRecord {
+    static constexpr size_t kMaxArgs = 8;
+    static constexpr size_t kPayloadSize = 96;
+
+    const LogSite* site;
+    uint64_t timestampNs;
+    uint8_t argCount;
+    uint8_t payloadSize;
+    LogArgType types[kMaxArgs];
+    uint8_t payload[kPayloadSize];
+};
+
+/*!
+ * Asynchroner Logger. Aufrufer packen nur Format-Id und Argumente in einen LogRecord und legen
+ * ihn in einen sperrfreien Ringpuffer (mehrere Erzeuger, ein Verbraucher); das Formatieren und
+ * Schreiben übernimmt ein Hintergrund-Thread. Auf Android geht die Ausgabe nach logcat, auf dem
+ * Host nach stderr oder in eine Datei.
+ *
+ * Ist der Puffer voll, wird der Eintrag verworfen und gezählt, der Aufrufer wartet nie. Die
+ * Anzahl verworfener Einträge erscheint als eigene Zeile, sobald wieder Platz ist.
+ *
+ * Die Makros LOG_V bis LOG_E prüfen die Stufe zur Übersetzungszeit (CODINI_LOG_LEVEL), abgeschaltete
+ * Zeilen erzeugen keinen Code.
+ */
+class Logger {
+public:
+    static constexpr size_t kCapacity = 1024;  // Einträge im Ringpuffer
+    static constexpr const char* kTag = "AO";
+
+    Logger();
+    ~Logger();
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    /*!
+     * @return den gemeinsamen Logger des Spiels, der Thread startet beim ersten Eintrag
+     */
+    static Logger& global();
+
+    /*!
+     * Schreibt ab jetzt in eine Datei statt auf stderr (nur Host, auf Android wirkungslos).
+     * @return false, wenn die Datei nicht geöffnet werden kann
+     */
+    bool setOutputFile(const std::string& path);
+
+    template<typename... Args>
+    void log(const LogSite& site, const Args&... args) {
+        LogRecord record;
+        record.site = &site;
+        record.argCount = 0;
+        record.payloadSize = 0;
+        (encode(record, args), ...);
+        push(record);
+    }
+
+    /*!
+     * Wartet, bis alle bisher eingereihten Einträge geschrieben sind, z.B. bevor die App beendet
+     * werden kann.
+     */
+    void flush();
+
+    uint64_t getDroppedCount() const { return dropped_.load(std::memory_order_relaxed); }
+
+    /*!
+     * Setzt einen Eintrag wieder zu Text zusammen (ohne Stufe und Zeitstempel).
+     */
+    static std::string format(const LogRecord& record);
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        LogRecord record;
+    };
+
+    static uint64_t nowNs();
+
+    void push(LogRecord& record);
+    void run();
+    bool pop(LogRecord& outRecord);
+    void write(LogLevel level, uint64_t timestampNs, const std::string& text);
+    void start();
+
+    // Argumente packen, je ein Typbyte und die Rohdaten
+    static bool reserve(LogRecord& record, LogArgType type, size_t size);
+    static void encodeBytes(LogRecord& record, LogArgType type, const void* data, size_t size);
+    static void encode(LogRecord& record, std::string_view text);
+    static void encode(LogRecord& record, const char* text) {
+        encode(record, std::string_view(text ? text : "(null)"));
+    }
+    static void encode(LogRecord& record, const std::string& text) {
+        encode(record, std::string_view(text));
+    }
+    static void encode(LogRecord& record, bool value) {
+        encodeBytes(record, LogArgType::BOOL, &value, sizeof(value));
+    }
+    template<typename T>
+    static void encode(LogRecord& record, const T& value) {
+        static_assert(std::is_arithmetic<T>::value || std::is_pointer<T>::value ||
+                      std::is_enum<T>::value, "unsupported log argument");
+        if constexpr (std::is_pointer<T>::value) {
+            auto address = reinterpret_cast<uintptr_t>(value);
+            encodeBytes(record, LogArgType::POINTER, &address, sizeof(address));
+        } else if constexpr (std::is_floating_point<T>::value) {
+            auto number = static_cast<double>(value);
+            encodeBytes(record, LogArgType::DOUBLE, &number, sizeof(number));
+        } else if constexpr (std::is_enum<T>::value) {
+            auto number = static_cast<int64_t>(value);
+            encodeBytes(record, LogArgType::INT, &number, sizeof(number));
+        } else if constexpr (std::is_signed<T>::value) {
+            auto number = static_cast<int64_t>(value);
+            encodeBytes(record, LogArgType::INT, &number, sizeof(number));
+        } else {
+            auto number = static_cast<uint64_t>(value);
+            encodeBytes(record, LogArgType::UINT, &number, sizeof(number));
+        }
+    }
+
+    std::unique_ptr<Cell[]> cells_;
+    alignas(64) std::atomic<size_t> enqueuePos_{0};
+    alignas(64) size_t dequeuePos_ = 0;
+    std::atomic<uint64_t> dropped_{0};
+    uint64_t reportedDropped_ = 0;
+
+    std::once_flag started_;
+    std::thread thread_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable drained_;
+    std::atomic<bool> sleeping_{false};
+    bool stopping_ = false;
+    size_t written_ = 0;               // Vom Thread geschriebene Einträge, unter mutex_
+    FILE* output_ = stderr;
+    uint64_t startNs_;
+};
+
+#define CODINI_LOG(level, format, ...)                                                  \
+    do {                                                                                \
+        if constexpr (static_cast<int>(level) >= CODINI_LOG_LEVEL) {                    \
+            static constexpr LogSite codiniLogSite_{level, format};                     \
+            Logger::global().log(codiniLogSite_, ##__VA_ARGS__);                        \
+        }                                                                               \
+    } while (false)
+
+#define LOG_V(format, ...) CODINI_LOG(LogLevel::VERBOSE, format, ##__VA_ARGS__)
+#define LOG_D(format, ...) CODINI_LOG(LogLevel::DEBUG, format, ##__VA_ARGS__)
+#define LOG_I(format, ...) CODINI_LOG(LogLevel::INFO, format, ##__VA_ARGS__)
+#define LOG_W(format, ...) CODINI_LOG(LogLevel::WARN, format, ##__VA_ARGS__)
+#define LOG_E(format, ...) CODINI_LOG(LogLevel::ERROR, format, ##__VA_ARGS__)
+
+#endif //CODINI_LOG_H
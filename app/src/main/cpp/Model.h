@@ -2,10 +2,27 @@
 #define ANDROIDGLINVESTIGATIONS_MODEL_H
 
 #include <vector>
-#include "TextureAsset.h"
 #include <string>
 #include <map>
+#include <memory>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
 #include <ctime>
+#include <random>
+#include <utility>
+
+#include "Command.h"
+#include "Leaderboard.h"
+#include "PasswordHash.h"
+#include "ProgressWriter.h"
+#include "Random.h"
+#include "StringTable.h"
+#include "UserProfile.h"
+#include "UserRegistry.h"
+
+// Nur vorwärts deklariert, damit die Spiellogik ohne GL-Header auskommt
+class TextureAsset;
 
 union Vector3 {
     struct {
@@ -69,6 +86,7 @@ private:
 struct Position {
     float x;
     float y;
+    float z = 0.0f;  // Höhe über dem Spielfeld (Sprung)
 };
 
 struct GameObject {
@@ -77,6 +95,9 @@ struct GameObject {
     float height;
     bool isTarget;
     bool isSelected;
+    float rotation = 0.0f;  // Blickrichtung in Grad, 0 = +x
+    float scale = 1.0f;
+    float alpha = 1.0f;
 };
 
 enum class ThemeType {
@@ -86,31 +107,13 @@ enum class ThemeType {
     ROBOT_LAB   // Roboterlabor: Roboter, Maschinen
 };
 
+// Texturnamen sind internierte Asset-Pfade, siehe StringTable
 struct Theme {
     ThemeType type;
-    std::string backgroundTexture;
-    std::string boxTexture;
-    std::string targetTexture;
-    std::vector<std::string> decorativeElements; // Dekorative Elemente spezifisch für jedes Thema
-};
-
-struct UserProgress {
-    int currentLevel;
-    int totalScore;
-    std::map<int, int> levelScores;  // Level-Nummer -> Punkte
-<<<<<<< HEAD
-    std::map<int, int> levelStars;   // level numarası -> yıldız sayısı (1-3)
-=======
-    std::map<int, int> levelStars;   // Level-Nummer -> Anzahl Sterne (1-3)
->>>>>>> bf23b1a (4. Commit)
-    std::time_t lastPlayTime;
-};
-
-struct UserProfile {
-    std::string username;
-    std::string passwordHash;  // SHA-256 Hash wird verwendet
-    UserProgress progress;
-    bool isLoggedIn;
+    StringId backgroundTexture;
+    StringId boxTexture;
+    StringId targetTexture;
+    std::vector<StringId> decorativeElements; // Dekorative Elemente spezifisch für jedes Thema
 };
 
 struct LevelCompletion {
@@ -124,46 +127,70 @@ struct LevelCompletion {
 struct Level {
     std::vector<GameObject> boxes;
     std::vector<GameObject> targets;
-    std::vector<std::string> availableCommands;
+    std::vector<CommandType> availableCommands;
     int minCommandCount;
     std::string description;
     Theme theme;
     std::vector<GameObject> decorations;
-<<<<<<< HEAD
-    int baseScore;           // Basis-Level-Punkte
-    int optimalCommandCount; // En iyi çözüm için gereken komut sayısı
-=======
     int baseScore;           // Grundpunkte des Levels
-    int optimalCommandCount; // Benötigte Befehle für optimale Lösung
->>>>>>> bf23b1a (4. Commit)
+    int optimalCommandCount; // Benötigte Befehle für optimale Lösung, geprüft mit codini_solve
 };
 
 class GameModel {
 public:
+    // Startwert von createLevel ohne Angabe, damit Werkzeuge immer dasselbe Level sehen
+    static constexpr uint64_t kDefaultLevelSeed = 0x853c49e6748fea9bULL;
+
     GameModel() {
         initializeThemes();
-        currentUser = nullptr;
+    }
+
+    /*!
+     * Öffnet den Fortschrittsspeicher im Verzeichnis (auf Android internalDataPath) und lädt
+     * alle Profile daraus. Ohne Speicher bleibt der Fortschritt nur bis zum Beenden erhalten.
+     */
+    bool openProgressStore(const std::string& directory, std::string* error = nullptr) {
+        currentUser = UserRegistry::Handle();
+        std::map<std::string, UserProfile> loaded;
+        bool opened = progressWriter_.open(directory, loaded, error);
+        users_.reset(std::move(loaded));
+        leaderboard_.rebuild(users_);
+        return opened;
+    }
+
+    // Wartet, bis aller Fortschritt auf dem Datenträger ist (App verliert ihr Fenster)
+    void flushProgress() {
+        progressWriter_.flush();
     }
 
     bool loginUser(const std::string& username, const std::string& password) {
-<<<<<<< HEAD
-        // Benutzerdaten überprüfen und anmelden
-=======
         // Benutzerdaten prüfen und anmelden
->>>>>>> bf23b1a (4. Commit)
-        std::string hashedPassword = hashPassword(password);
-        if (users_.find(username) != users_.end() && 
-            users_[username].passwordHash == hashedPassword) {
-            currentUser = &users_[username];
-            currentUser->isLoggedIn = true;
-            loadUserProgress();
-            return true;
+        UserRegistry::Handle user = users_.find(username);
+        if (!user.isValid() || !verifyPassword(password, user.read()->passwordHash)) {
+            return false;
         }
-        return false;
+
+        // Mit zu wenigen Iterationen gespeicherte Hashes beim Anmelden erneuern
+        std::string newHash;
+        if (passwordNeedsRehash(user.read()->passwordHash)) {
+            newHash = hashPassword(password);
+        }
+        users_.update(user, [&](UserProfile& changed) {
+            changed.isLoggedIn = true;
+            if (!newHash.empty()) {
+                changed.passwordHash = newHash;
+            }
+        }, [&](const UserProfile& published) {
+            if (!newHash.empty()) {
+                progressWriter_.publishProfile(published);
+            }
+        });
+        currentUser = user;
+        return true;
     }
 
     bool registerUser(const std::string& username, const std::string& password) {
-        if (users_.find(username) != users_.end()) {
+        if (users_.find(username).isValid()) {
             return false; // Benutzer existiert bereits
         }
 
@@ -173,193 +200,245 @@ public:
         newUser.isLoggedIn = false;
         newUser.progress = UserProgress{1, 0, {}, {}, std::time(nullptr)};
         
-        users_[username] = newUser;
-        return true;
+        // Bestenliste und Speicher unter der Sperre des Profils, ein Sync kann nicht dazwischen
+        UserRegistry::Handle user = users_.insert(newUser, [&](const UserProfile& published) {
+            progressWriter_.publishProfile(published);
+            leaderboard_.update(published);
+        });
+        return user.isValid(); // Sonst gleichzeitig von einem anderen Thread angelegt
     }
 
+    // Startet ein Level mit neuem Zufallsstartwert für die Dekoration
     void initializeLevel(int levelNumber) {
-        if (!currentUser || !currentUser->isLoggedIn) {
-<<<<<<< HEAD
-            return; // Benutzer ist nicht angemeldet
-=======
+        initializeLevel(levelNumber, newLevelSeed());
+    }
+
+    /*!
+     * Startet ein Level mit festem Startwert, gleicher Startwert ergibt das gleiche Level
+     * (z.B. beim Zurücksetzen oder beim Abspielen einer Aufzeichnung).
+     */
+    void initializeLevel(int levelNumber, uint64_t seed) {
+        if (!isUserLoggedIn()) {
             return; // Benutzer nicht angemeldet
->>>>>>> bf23b1a (4. Commit)
         }
 
         currentLevelNumber = levelNumber;
-        currentLevel = Level();
+        levelSeed_ = seed;
+        currentLevel = createLevel(levelNumber, seed);
+    }
 
-<<<<<<< HEAD
-        // Für jedes Level ein anderes Theme wählen
-=======
-        // Verschiedenes Thema für jedes Level wählen
->>>>>>> bf23b1a (4. Commit)
+    // Verschiedenes Thema für jedes Level
+    const Theme& getThemeForLevel(int levelNumber) {
         ThemeType levelTheme;
         switch(levelNumber % 4) {
             case 0: levelTheme = ThemeType::SPACE; break;
             case 1: levelTheme = ThemeType::OCEAN; break;
             case 2: levelTheme = ThemeType::FOREST; break;
-            case 3: levelTheme = ThemeType::ROBOT_LAB; break;
+            default: levelTheme = ThemeType::ROBOT_LAB; break;
         }
-        currentLevel.theme = themes_[levelTheme];
+        return themes_[levelTheme];
+    }
+
+    // Baut den Startzustand eines Levels, unabhängig vom angemeldeten Benutzer
+    Level createLevel(int levelNumber, uint64_t seed = kDefaultLevelSeed) {
+        FastRandom random(seed);
+        Level level{};
+        level.theme = getThemeForLevel(levelNumber);
 
         switch(levelNumber) {
             case 1:
-                currentLevel.description = "Bewege die Box zum roten Punkt!";
-                currentLevel.availableCommands = {"vorwärts", "rechts", "links"};
-                currentLevel.minCommandCount = 3;
-                currentLevel.baseScore = 100;
-                currentLevel.optimalCommandCount = 3;
-                currentLevel.boxes.push_back({Position{0.0f, 0.0f}, 1.0f, 1.0f, false, false});
-                currentLevel.targets.push_back({Position{3.0f, 3.0f}, 0.5f, 0.5f, true, false});
-                addDecorativeElements(3);
+                level.description = "Bewege die Box zum roten Punkt!";
+                level.availableCommands = {CommandType::MOVE_FORWARD, CommandType::TURN_RIGHT,
+                                           CommandType::TURN_LEFT};
+                level.minCommandCount = 3;
+                level.baseScore = 100;
+                level.optimalCommandCount = 7;
+                level.boxes.push_back({Position{0.0f, 0.0f}, 1.0f, 1.0f, false, false});
+                level.targets.push_back({Position{3.0f, 3.0f}, 0.5f, 0.5f, true, false});
+                addDecorativeElements(level, 3, random);
                 break;
             case 2:
-                currentLevel.description = "Bewege zwei Boxen zu ihren Zielpunkten!";
-                currentLevel.availableCommands = {"vorwärts", "rechts", "links", "wiederholen"};
-                currentLevel.minCommandCount = 5;
-                currentLevel.baseScore = 200;
-                currentLevel.optimalCommandCount = 5;
-                currentLevel.boxes.push_back({Position{0.0f, 0.0f}, 1.0f, 1.0f, false, false});
-                currentLevel.boxes.push_back({Position{0.0f, 2.0f}, 1.0f, 1.0f, false, false});
-                currentLevel.targets.push_back({Position{4.0f, 0.0f}, 0.5f, 0.5f, true, false});
-                currentLevel.targets.push_back({Position{4.0f, 2.0f}, 0.5f, 0.5f, true, false});
-                addDecorativeElements(4);
+                level.description = "Bewege zwei Boxen zu ihren Zielpunkten!";
+                level.availableCommands = {CommandType::MOVE_FORWARD, CommandType::TURN_RIGHT,
+                                           CommandType::TURN_LEFT, CommandType::LOOP_START};
+                level.minCommandCount = 5;
+                level.baseScore = 200;
+                level.optimalCommandCount = 3;  // Mehrere Boxen, im Spiel immer Parallelbetrieb
+                level.boxes.push_back({Position{0.0f, 0.0f}, 1.0f, 1.0f, false, false});
+                level.boxes.push_back({Position{0.0f, 2.0f}, 1.0f, 1.0f, false, false});
+                level.targets.push_back({Position{4.0f, 0.0f}, 0.5f, 0.5f, true, false});
+                level.targets.push_back({Position{4.0f, 2.0f}, 0.5f, 0.5f, true, false});
+                addDecorativeElements(level, 4, random);
                 break;
             case 3:
-                currentLevel.description = "Erstelle eine Schleife um die Boxen effizient zu bewegen!";
-                currentLevel.availableCommands = {"vorwärts", "rechts", "links", "wiederholen", "schleife"};
-                currentLevel.minCommandCount = 4;
-                currentLevel.baseScore = 300;
-                currentLevel.optimalCommandCount = 4;
-                currentLevel.boxes.push_back({Position{0.0f, 0.0f}, 1.0f, 1.0f, false, false});
-                currentLevel.boxes.push_back({Position{0.0f, 2.0f}, 1.0f, 1.0f, false, false});
-                currentLevel.boxes.push_back({Position{0.0f, 4.0f}, 1.0f, 1.0f, false, false});
-                currentLevel.targets.push_back({Position{5.0f, 0.0f}, 0.5f, 0.5f, true, false});
-                currentLevel.targets.push_back({Position{5.0f, 2.0f}, 0.5f, 0.5f, true, false});
-                currentLevel.targets.push_back({Position{5.0f, 4.0f}, 0.5f, 0.5f, true, false});
-                addDecorativeElements(5);
+                level.description = "Erstelle eine Schleife um die Boxen effizient zu bewegen!";
+                level.availableCommands = {CommandType::MOVE_FORWARD, CommandType::TURN_RIGHT,
+                                           CommandType::TURN_LEFT, CommandType::LOOP_START};
+                level.minCommandCount = 4;
+                level.baseScore = 300;
+                level.optimalCommandCount = 3;  // Mehrere Boxen, im Spiel immer Parallelbetrieb
+                level.boxes.push_back({Position{0.0f, 0.0f}, 1.0f, 1.0f, false, false});
+                level.boxes.push_back({Position{0.0f, 2.0f}, 1.0f, 1.0f, false, false});
+                level.boxes.push_back({Position{0.0f, 4.0f}, 1.0f, 1.0f, false, false});
+                level.targets.push_back({Position{5.0f, 0.0f}, 0.5f, 0.5f, true, false});
+                level.targets.push_back({Position{5.0f, 2.0f}, 0.5f, 0.5f, true, false});
+                level.targets.push_back({Position{5.0f, 4.0f}, 0.5f, 0.5f, true, false});
+                addDecorativeElements(level, 5, random);
                 break;
         }
+        return level;
     }
 
-    void addDecorativeElements(int count) {
+    void addDecorativeElements(Level& level, int count, FastRandom& random) {
         // Dekorative Elemente an zufälligen Positionen hinzufügen
         for(int i = 0; i < count; i++) {
-            float x = static_cast<float>(rand() % 8);
-            float y = static_cast<float>(rand() % 8);
-            currentLevel.decorations.push_back({
+            float x = static_cast<float>(random.rangeInt(0, 7));
+            float y = static_cast<float>(random.rangeInt(0, 7));
+            level.decorations.push_back({
                 Position{x, y},
                 0.5f, 0.5f, false, false
             });
         }
     }
 
-    LevelCompletion completeLevelWithSolution(const std::vector<std::string>& commands, float timeSpent) {
-        if (!currentUser || !currentUser->isLoggedIn) {
+    LevelCompletion completeLevelWithSolution(const std::vector<Command>& commands, float timeSpent) {
+        if (!isUserLoggedIn()) {
             return LevelCompletion{0, 0, 0, 0.0f, false};
         }
 
-        int commandCount = commands.size();
-        bool isOptimal = commandCount <= currentLevel.optimalCommandCount;
+        LevelCompletion completion = scoreSolution(
+                currentLevel, static_cast<int>(commands.size()), timeSpent);
+        int score = completion.score;
+        int stars = completion.stars;
+
+        // Benutzerfortschritt aktualisieren, gleichzeitige Schreiber (Sync) gehen nicht verloren.
+        // Speicher und Bestenliste folgen unter der Sperre des Profils, sonst könnte ein älterer
+        // Stand einen neueren überholen.
+        users_.update(currentUser, [&](UserProfile& changed) {
+            UserProgress& progress = changed.progress;
+            progress.levelScores[currentLevelNumber] = score;
+            progress.levelStars[currentLevelNumber] = stars;
+            progress.totalScore += score;
+            progress.lastPlayTime = std::time(nullptr);
+
+            if (currentLevelNumber == progress.currentLevel) {
+                progress.currentLevel++;  // Nächstes Level freischalten
+            }
+        }, [&](const UserProfile& published) {
+            saveUserProgress(published, currentLevelNumber);
+            leaderboard_.update(published, currentLevelNumber);
+        });
         
-<<<<<<< HEAD
+        return completion;
+    }
+
+    // Wertet eine Lösung nach den Punkteregeln aus, ohne den Benutzerfortschritt zu ändern
+    static LevelCompletion scoreSolution(const Level& level, int commandCount, float timeSpent) {
+        bool isOptimal = commandCount <= level.optimalCommandCount;
+
         // Punkteberechnung
-        float timeBonus = std::max(0.0f, 30.0f - timeSpent) * 2;  // 30 saniyeden hızlı bitirme bonusu
-        int commandBonus = isOptimal ? 50 : 0;  // Optimal çözüm bonusu
-=======
-        // Puan hesaplama
         float timeBonus = std::max(0.0f, 30.0f - timeSpent) * 2;  // Bonus für schnellere Fertigstellung als 30 Sekunden
         int commandBonus = isOptimal ? 50 : 0;  // Bonus für optimale Lösung
->>>>>>> bf23b1a (4. Commit)
-        
-        int score = currentLevel.baseScore + static_cast<int>(timeBonus) + commandBonus;
-        
+
+        int score = level.baseScore + static_cast<int>(timeBonus) + commandBonus;
+
         // Sterne-Berechnung (1-3)
         int stars = 1;  // Mindestens 1 Stern
         if (isOptimal) stars++;  // +1 Stern für optimale Lösung
         if (timeSpent < 20.0f) stars++;  // +1 Stern für schnelle Lösung
-        
-        // Benutzerfortschritt aktualisieren
-        currentUser->progress.levelScores[currentLevelNumber] = score;
-        currentUser->progress.levelStars[currentLevelNumber] = stars;
-        currentUser->progress.totalScore += score;
-        currentUser->progress.lastPlayTime = std::time(nullptr);
-        
-        if (currentLevelNumber == currentUser->progress.currentLevel) {
-            currentUser->progress.currentLevel++;  // Nächstes Level freischalten
-        }
-        
-        saveUserProgress();  // İlerlemeyi kaydet
-        
+
         return LevelCompletion{score, stars, commandCount, timeSpent, isOptimal};
     }
 
     // Getter metodları
-    bool isUserLoggedIn() const { return currentUser && currentUser->isLoggedIn; }
-    const UserProgress* getCurrentProgress() const { 
-        return currentUser ? &currentUser->progress : nullptr; 
+    bool isUserLoggedIn() const { return currentUser.isValid() && currentUser.read()->isLoggedIn; }
+    // Unveränderlicher Stand, bleibt gültig, auch wenn der Fortschritt sich danach ändert
+    std::shared_ptr<const UserProfile> getCurrentProfile() const {
+        return currentUser.isValid() ? currentUser.read() : nullptr;
     }
     int getCurrentLevel() const { 
-        return currentUser ? currentUser->progress.currentLevel : 1; 
+        return currentUser.isValid() ? currentUser.read()->progress.currentLevel : 1;
     }
     int getTotalScore() const { 
-        return currentUser ? currentUser->progress.totalScore : 0; 
+        return currentUser.isValid() ? currentUser.read()->progress.totalScore : 0;
+    }
+    // Für Threads außerhalb des Spiels, z.B. Sync; ungültig, wenn es den Namen nicht gibt
+    UserRegistry::Handle findUser(const std::string& username) const { return users_.find(username); }
+
+    /*!
+     * Ändert ein Profil, auch von anderen Threads aus (Sync): Registry, Bestenliste und
+     * Fortschrittsspeicher werden gemeinsam aktualisiert. mutate wie bei UserRegistry::update.
+     * @return den neuen Stand
+     */
+    template<typename Mutate>
+    std::shared_ptr<const UserProfile> updateUser(const UserRegistry::Handle& handle, Mutate&& mutate) {
+        return users_.update(handle, std::forward<Mutate>(mutate), [&](const UserProfile& published) {
+            progressWriter_.publishProfile(published);
+            leaderboard_.updateAllLevels(published);
+        });
     }
+    const Leaderboard& getLeaderboard() const { return leaderboard_; }
+    const Level& getLevel() const { return currentLevel; }
+    int getLevelNumber() const { return currentLevelNumber; }
+    uint64_t getLevelSeed() const { return levelSeed_; }
+    std::vector<GameObject>& getBoxes() { return currentLevel.boxes; }
+    const std::vector<GameObject>& getTargets() const { return currentLevel.targets; }
+    const std::vector<GameObject>& getDecorations() const { return currentLevel.decorations; }
+    const Theme& getCurrentTheme() const { return currentLevel.theme; }
 
 private:
     void initializeThemes() {
         themes_[ThemeType::SPACE] = {
             ThemeType::SPACE,
-            "space_background.png",
-            "astronaut.png",
-            "planet.png",
-            {"star.png", "meteor.png", "satellite.png"}
+            intern("space_background.png"),
+            intern("astronaut.png"),
+            intern("planet.png"),
+            {intern("star.png"), intern("meteor.png"), intern("satellite.png")}
         };
         
         themes_[ThemeType::OCEAN] = {
             ThemeType::OCEAN,
-            "ocean_background.png",
-            "submarine.png",
-            "treasure.png",
-            {"fish.png", "coral.png", "seaweed.png"}
+            intern("ocean_background.png"),
+            intern("submarine.png"),
+            intern("treasure.png"),
+            {intern("fish.png"), intern("coral.png"), intern("seaweed.png")}
         };
         
         themes_[ThemeType::FOREST] = {
             ThemeType::FOREST,
-            "forest_background.png",
-            "explorer.png",
-            "tree_house.png",
-            {"tree.png", "flower.png", "mushroom.png"}
+            intern("forest_background.png"),
+            intern("explorer.png"),
+            intern("tree_house.png"),
+            {intern("tree.png"), intern("flower.png"), intern("mushroom.png")}
         };
         
         themes_[ThemeType::ROBOT_LAB] = {
             ThemeType::ROBOT_LAB,
-            "lab_background.png",
-            "robot.png",
-            "charging_station.png",
-            {"gear.png", "circuit.png", "screen.png"}
+            intern("lab_background.png"),
+            intern("robot.png"),
+            intern("charging_station.png"),
+            {intern("gear.png"), intern("circuit.png"), intern("screen.png")}
         };
     }
 
-    std::string hashPassword(const std::string& password) {
-        // TODO: Implement SHA-256 hashing
-        return password; // Şimdilik basit impl.
-    }
-
-    void loadUserProgress() {
-        // TODO: Implement loading from persistent storage
+    static uint64_t newLevelSeed() {
+        std::random_device device;
+        return (static_cast<uint64_t>(device()) << 32) | device();
     }
 
-    void saveUserProgress() {
-        // TODO: Implement saving to persistent storage
+    // Übergibt das Levelergebnis an den Schreib-Thread, der Frame wartet nicht auf die Platte
+    void saveUserProgress(const UserProfile& profile, int levelNumber) {
+        progressWriter_.publishLevelResult(profile, levelNumber);
     }
 
     Level currentLevel;
-    int currentLevelNumber;
+    int currentLevelNumber = 0;
+    uint64_t levelSeed_ = kDefaultLevelSeed;
     std::map<ThemeType, Theme> themes_;
-    std::map<std::string, UserProfile> users_;
-    UserProfile* currentUser;
+    UserRegistry users_;
+    UserRegistry::Handle currentUser;
+    Leaderboard leaderboard_;
+    ProgressWriter progressWriter_;
 };
 
 #endif //ANDROIDGLINVESTIGATIONS_MODEL_H
\ No newline at end of file
@@ -0,0 +1,245 @@
+#ifndef CODINI_ORDER_STATISTIC_TREE_H
+#define CODINI_ORDER_STATISTIC_TREE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+/*!
+ * Sortierte Menge als AVL-Baum, in dem jeder Knoten die Größe seines Teilbaums kennt. Damit
+ * kosten Einfügen, Löschen, Rang eines Schlüssels und der i-te Schlüssel jeweils O(log n).
+ *
+ * Die Knoten liegen in einem Vektor und verweisen über Indizes aufeinander; gelöschte Plätze
+ * werden wiederverwendet, nach dem Aufwärmen allokiert der Baum nicht mehr.
+ */
+template<typename Key, typename Less = std::less<Key>>
+class OrderStatisticTree {
+public:
+    size_t size() const { return root_ < 0 ? 0 : static_cast<size_t>(nodes_[root_].size); }
+    bool empty() const { return root_ < 0; }
+
+    void clear() {
+        nodes_.clear();
+        free_.clear();
+        root_ = -1;
+    }
+
+    /*!
+     * @return false, wenn der Schlüssel schon enthalten ist
+     */
+    bool insert(const Key& key) {
+        bool inserted = false;
+        root_ = insertAt(root_, key, inserted);
+        return inserted;
+    }
+
+    /*!
+     * @return false, wenn der Schlüssel nicht enthalten war
+     */
+    bool erase(const Key& key) {
+        bool erased = false;
+        root_ = eraseAt(root_, key, erased);
+        return erased;
+    }
+
+    bool contains(const Key& key) const {
+        int32_t node = root_;
+        while (node >= 0) {
+            if (less_(key, nodes_[node].key)) node = nodes_[node].left;
+            else if (less_(nodes_[node].key, key)) node = nodes_[node].right;
+            else return true;
+        }
+        return false;
+    }
+
+    /*!
+     * @return die Anzahl der Schlüssel, die kleiner als key sind (key muss nicht enthalten sein)
+     */
+    size_t rank(const Key& key) const {
+        size_t smaller = 0;
+        int32_t node = root_;
+        while (node >= 0) {
+            if (less_(nodes_[node].key, key)) {
+                smaller += sizeOf(nodes_[node].left) + 1;
+                node = nodes_[node].right;
+            } else {
+                node = nodes_[node].left;
+            }
+        }
+        return smaller;
+    }
+
+    /*!
+     * @return den Schlüssel mit Rang index, index < size()
+     */
+    const Key& select(size_t index) const {
+        int32_t node = root_;
+        while (true) {
+            size_t leftSize = sizeOf(nodes_[node].left);
+            if (index < leftSize) {
+                node = nodes_[node].left;
+            } else if (index == leftSize) {
+                return nodes_[node].key;
+            } else {
+                index -= leftSize + 1;
+                node = nodes_[node].right;
+            }
+        }
+    }
+
+    /*!
+     * Ruft visit(const Key&) für die ersten count Schlüssel in Reihenfolge auf, O(log n + count).
+     */
+    template<typename Visit>
+    void forEachFirst(size_t count, Visit&& visit) const {
+        std::vector<int32_t> path;
+        int32_t node = root_;
+        while (count > 0 && (node >= 0 || !path.empty())) {
+            while (node >= 0) {
+                path.push_back(node);
+                node = nodes_[node].left;
+            }
+            node = path.back();
+            path.pop_back();
+            visit(nodes_[node].key);
+            count--;
+            node = nodes_[node].right;
+        }
+    }
+
+private:
+    struct Node {
+        Key key;
+        int32_t left = -1;
+        int32_t right = -1;
+        int32_t size = 1;
+        int32_t height = 1;
+    };
+
+    size_t sizeOf(int32_t node) const { return node < 0 ? 0 : static_cast<size_t>(nodes_[node].size); }
+    int32_t heightOf(int32_t node) const { return node < 0 ? 0 : nodes_[node].height; }
+
+    int32_t allocate(const Key& key) {
+        if (!free_.empty()) {
+            int32_t node = free_.back();
+            free_.pop_back();
+            nodes_[node] = Node{key};
+            return node;
+        }
+        nodes_.push_back(Node{key});
+        return static_cast<int32_t>(nodes_.size() - 1);
+    }
+
+    void release(int32_t node) {
+        nodes_[node].key = Key();
+        free_.push_back(node);
+    }
+
+    void refresh(int32_t node) {
+        Node& n = nodes_[node];
+        n.size = static_cast<int32_t>(sizeOf(n.left) + sizeOf(n.right) + 1);
+        n.height = std::max(heightOf(n.left), heightOf(n.right)) + 1;
+    }
+
+    int32_t rotateRight(int32_t node) {
+        int32_t pivot = nodes_[node].left;
+        nodes_[node].left = nodes_[pivot].right;
+        nodes_[pivot].right = node;
+        refresh(node);
+        refresh(pivot);
+        return pivot;
+    }
+
+    int32_t rotateLeft(int32_t node) {
+        int32_t pivot = nodes_[node].right;
+        nodes_[node].right = nodes_[pivot].left;
+        nodes_[pivot].left = node;
+        refresh(node);
+        refresh(pivot);
+        return pivot;
+    }
+
+    int32_t rebalance(int32_t node) {
+        refresh(node);
+        int32_t balance = heightOf(nodes_[node].left) - heightOf(nodes_[node].right);
+        if (balance > 1) {
+            int32_t left = nodes_[node].left;
+            if (heightOf(nodes_[left].left) < heightOf(nodes_[left].right)) {
+                nodes_[node].left = rotateLeft(left);
+            }
+            return rotateRight(node);
+        }
+        if (balance < -1) {
+            int32_t right = nodes_[node].right;
+            if (heightOf(nodes_[right].right) < heightOf(nodes_[right].left)) {
+                nodes_[node].right = rotateRight(right);
+            }
+            return rotateLeft(node);
+        }
+        return node;
+    }
+
+    // Indizes statt Referenzen: allocate kann nodes_ umziehen lassen
+    int32_t insertAt(int32_t node, const Key& key, bool& inserted) {
+        if (node < 0) {
+            inserted = true;
+            return allocate(key);
+        }
+        if (less_(key, nodes_[node].key)) {
+            int32_t child = insertAt(nodes_[node].left, key, inserted);
+            nodes_[node].left = child;
+        } else if (less_(nodes_[node].key, key)) {
+            int32_t child = insertAt(nodes_[node].right, key, inserted);
+            nodes_[node].right = child;
+        } else {
+            return node;
+        }
+        return inserted ? rebalance(node) : node;
+    }
+
+    int32_t eraseAt(int32_t node, const Key& key, bool& erased) {
+        if (node < 0) {
+            return node;
+        }
+        if (less_(key, nodes_[node].key)) {
+            nodes_[node].left = eraseAt(nodes_[node].left, key, erased);
+        } else if (less_(nodes_[node].key, key)) {
+            nodes_[node].right = eraseAt(nodes_[node].right, key, erased);
+        } else {
+            erased = true;
+            int32_t left = nodes_[node].left;
+            int32_t right = nodes_[node].right;
+            if (left < 0 || right < 0) {
+                release(node);
+                return left >= 0 ? left : right;
+            }
+            // Zwei Kinder: der kleinste Knoten rechts nimmt den Platz ein
+            int32_t successor = -1;
+            right = detachMin(right, successor);
+            nodes_[successor].left = left;
+            nodes_[successor].right = right;
+            release(node);
+            return rebalance(successor);
+        }
+        return erased ? rebalance(node) : node;
+    }
+
+    int32_t detachMin(int32_t node, int32_t& outMin) {
+        if (nodes_[node].left < 0) {
+            outMin = node;
+            return nodes_[node].right;
+        }
+        nodes_[node].left = detachMin(nodes_[node].left, outMin);
+        return rebalance(node);
+    }
+
+    std::vector<Node> nodes_;
+    std::vector<int32_t> free_;
+    int32_t root_ = -1;
+    Less less_;
+};
+
+#endif //CODINI_ORDER_STATISTIC_TREE_H
@@ -0,0 +1,155 @@
+#include "ParticleBuffer.h"
+
+#include <algorithm>
+
+#if !defined(CODINI_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#include <emmintrin.h>
+#define CODINI_PARTICLES_SSE 1
+#elif !defined(CODINI_NO_SIMD) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define CODINI_PARTICLES_NEON 1
+#endif
+
+void ParticleBuffer::reserve(size_t capacity) {
+    if (capacity > positionX_.size()) {
+        grow(capacity);
+    }
+}
+
+void ParticleBuffer::grow(size_t capacity) {
+    capacity = (capacity + kLanes - 1) / kLanes * kLanes;
+    for (auto* array : {&positionX_, &positionY_, &velocityX_, &velocityY_, &rotation_,
+                        &rotationSpeed_, &scale_, &life_, &inverseMaxLife_, &maxLife_,
+                        &alpha_, &colorR_, &colorG_, &colorB_}) {
+        array->resize(capacity, 0.0f);
+    }
+}
+
+void ParticleBuffer::push(const Particle& particle) {
+    if (count_ == positionX_.size()) {
+        grow(std::max<size_t>(16, positionX_.size() * 2));
+    }
+
+    size_t i = count_++;
+    positionX_[i] = particle.position.x;
+    positionY_[i] = particle.position.y;
+    velocityX_[i] = particle.velocity.x;
+    velocityY_[i] = particle.velocity.y;
+    rotation_[i] = particle.rotation;
+    rotationSpeed_[i] = particle.rotationSpeed;
+    scale_[i] = particle.scale;
+    life_[i] = particle.life;
+    maxLife_[i] = particle.maxLife;
+    inverseMaxLife_[i] = particle.maxLife > 0.0f ? 1.0f / particle.maxLife : 0.0f;
+    alpha_[i] = particle.alpha;
+    colorR_[i] = particle.color.x;
+    colorG_[i] = particle.color.y;
+    colorB_[i] = particle.color.z;
+}
+
+Particle ParticleBuffer::get(size_t i) const {
+    Particle particle;
+    particle.position = {positionX_[i], positionY_[i]};
+    particle.velocity = {velocityX_[i], velocityY_[i]};
+    particle.rotation = rotation_[i];
+    particle.rotationSpeed = rotationSpeed_[i];
+    particle.scale = scale_[i];
+    particle.life = life_[i];
+    particle.maxLife = maxLife_[i];
+    particle.color = {colorR_[i], colorG_[i], colorB_[i]};
+    particle.alpha = alpha_[i];
+    return particle;
+}
+
+void ParticleBuffer::moveParticle(size_t from, size_t to) {
+    positionX_[to] = positionX_[from];
+    positionY_[to] = positionY_[from];
+    velocityX_[to] = velocityX_[from];
+    velocityY_[to] = velocityY_[from];
+    rotation_[to] = rotation_[from];
+    rotationSpeed_[to] = rotationSpeed_[from];
+    scale_[to] = scale_[from];
+    life_[to] = life_[from];
+    inverseMaxLife_[to] = inverseMaxLife_[from];
+    maxLife_[to] = maxLife_[from];
+    alpha_[to] = alpha_[from];
+    colorR_[to] = colorR_[from];
+    colorG_[to] = colorG_[from];
+    colorB_[to] = colorB_[from];
+}
+
+void ParticleBuffer::removeDead() {
+    size_t i = 0;
+    while (i < count_) {
+        if (life_[i] <= 0.0f) {
+            // Letzten Partikel in die Lücke ziehen, i erneut prüfen
+            moveParticle(--count_, i);
+        } else {
+            ++i;
+        }
+    }
+}
+
+void integrateParticlesScalar(ParticleBuffer& buffer, float deltaTime) {
+    const size_t count = buffer.size();
+    float* positionX = buffer.positionX();
+    float* positionY = buffer.positionY();
+    const float* velocityX = buffer.velocityX();
+    const float* velocityY = buffer.velocityY();
+    float* rotation = buffer.rotation();
+    const float* rotationSpeed = buffer.rotationSpeed();
+    float* life = buffer.life();
+    const float* inverseMaxLife = buffer.inverseMaxLife();
+    float* alpha = buffer.alpha();
+
+    for (size_t i = 0; i < count; i++) {
+        life[i] -= deltaTime;
+        positionX[i] += velocityX[i] * deltaTime;
+        positionY[i] += velocityY[i] * deltaTime;
+        rotation[i] += rotationSpeed[i] * deltaTime;
+        alpha[i] = life[i] * inverseMaxLife[i];
+    }
+}
+
+void integrateParticles(ParticleBuffer& buffer, float deltaTime) {
+#if defined(CODINI_PARTICLES_SSE) || defined(CODINI_PARTICLES_NEON)
+    // Die Arrays sind auf kLanes aufgefüllt, die Auffüllung wird einfach mitgerechnet
+    const size_t count = buffer.paddedSize();
+    float* positionX = buffer.positionX();
+    float* positionY = buffer.positionY();
+    const float* velocityX = buffer.velocityX();
+    const float* velocityY = buffer.velocityY();
+    float* rotation = buffer.rotation();
+    const float* rotationSpeed = buffer.rotationSpeed();
+    float* life = buffer.life();
+    const float* inverseMaxLife = buffer.inverseMaxLife();
+    float* alpha = buffer.alpha();
+#endif
+
+#if defined(CODINI_PARTICLES_SSE)
+    const __m128 dt = _mm_set1_ps(deltaTime);
+    for (size_t i = 0; i < count; i += ParticleBuffer::kLanes) {
+        __m128 newLife = _mm_sub_ps(_mm_loadu_ps(life + i), dt);
+        _mm_storeu_ps(life + i, newLife);
+        _mm_storeu_ps(positionX + i, _mm_add_ps(_mm_loadu_ps(positionX + i),
+                                                _mm_mul_ps(_mm_loadu_ps(velocityX + i), dt)));
+        _mm_storeu_ps(positionY + i, _mm_add_ps(_mm_loadu_ps(positionY + i),
+                                                _mm_mul_ps(_mm_loadu_ps(velocityY + i), dt)));
+        _mm_storeu_ps(rotation + i, _mm_add_ps(_mm_loadu_ps(rotation + i),
+                                               _mm_mul_ps(_mm_loadu_ps(rotationSpeed + i), dt)));
+        _mm_storeu_ps(alpha + i, _mm_mul_ps(newLife, _mm_loadu_ps(inverseMaxLife + i)));
+    }
+#elif defined(CODINI_PARTICLES_NEON)
+    const float32x4_t dt = vdupq_n_f32(deltaTime);
+    for (size_t i = 0; i < count; i += ParticleBuffer::kLanes) {
+        float32x4_t newLife = vsubq_f32(vld1q_f32(life + i), dt);
+        vst1q_f32(life + i, newLife);
+        vst1q_f32(positionX + i, vmlaq_f32(vld1q_f32(positionX + i), vld1q_f32(velocityX + i), dt));
+        vst1q_f32(positionY + i, vmlaq_f32(vld1q_f32(positionY + i), vld1q_f32(velocityY + i), dt));
+        vst1q_f32(rotation + i, vmlaq_f32(vld1q_f32(rotation + i), vld1q_f32(rotationSpeed + i), dt));
+        vst1q_f32(alpha + i, vmulq_f32(newLife, vld1q_f32(inverseMaxLife + i)));
+    }
+#else
+    integrateParticlesScalar(buffer, deltaTime);
+#endif
+}
@@ -0,0 +1,111 @@
+#ifndef CODINI_PARTICLE_BUFFER_H
+#define CODINI_PARTICLE_BUFFER_H
+
+#include "Model.h"
+#include <cstddef>
+#include <vector>
+
+struct Particle {
+    Vector2 position;
+    Vector2 velocity;
+    float rotation;
+    float rotationSpeed;
+    float scale;
+    float life;
+    float maxLife;
+    Vector3 color;
+    float alpha;
+};
+
+/*!
+ * Partikelspeicher als Structure-of-Arrays. Jede Eigenschaft liegt in einem eigenen,
+ * zusammenhängenden Array, damit der Update-Kernel vier Partikel pro SIMD-Befehl bearbeiten
+ * kann. Die Arrays sind immer auf ein Vielfaches von kLanes aufgefüllt, der Kernel braucht
+ * also keine Restschleife. Tote Partikel werden per Swap-and-Pop entfernt (O(1) pro Partikel).
+ */
+class ParticleBuffer {
+public:
+    static constexpr size_t kLanes = 4;
+
+    size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+
+    void clear() { count_ = 0; }
+    void reserve(size_t capacity);
+
+    void push(const Particle& particle);
+
+    /*!
+     * Setzt einen Partikel wieder aus den Arrays zusammen (für Renderer und Debugging).
+     */
+    Particle get(size_t index) const;
+
+    /*!
+     * Entfernt alle Partikel mit life <= 0. Die Reihenfolge bleibt dabei nicht erhalten.
+     */
+    void removeDead();
+
+    // Roh-Arrays für Kernel und Renderer
+    float* positionX() { return positionX_.data(); }
+    float* positionY() { return positionY_.data(); }
+    float* velocityX() { return velocityX_.data(); }
+    float* velocityY() { return velocityY_.data(); }
+    float* rotation() { return rotation_.data(); }
+    float* rotationSpeed() { return rotationSpeed_.data(); }
+    float* life() { return life_.data(); }
+    float* inverseMaxLife() { return inverseMaxLife_.data(); }
+    float* alpha() { return alpha_.data(); }
+
+    const float* positionX() const { return positionX_.data(); }
+    const float* positionY() const { return positionY_.data(); }
+    const float* rotation() const { return rotation_.data(); }
+    const float* scale() const { return scale_.data(); }
+    const float* alpha() const { return alpha_.data(); }
+    const float* colorR() const { return colorR_.data(); }
+    const float* colorG() const { return colorG_.data(); }
+    const float* colorB() const { return colorB_.data(); }
+
+    // Anzahl Einträge inklusive Auffüllung, immer ein Vielfaches von kLanes
+    size_t paddedSize() const { return (count_ + kLanes - 1) / kLanes * kLanes; }
+
+private:
+    void grow(size_t capacity);
+    void moveParticle(size_t from, size_t to);
+
+    size_t count_ = 0;
+    std::vector<float> positionX_;
+    std::vector<float> positionY_;
+    std::vector<float> velocityX_;
+    std::vector<float> velocityY_;
+    std::vector<float> rotation_;
+    std::vector<float> rotationSpeed_;
+    std::vector<float> scale_;
+    std::vector<float> life_;
+    std::vector<float> inverseMaxLife_;
+    std::vector<float> maxLife_;
+    std::vector<float> alpha_;
+    std::vector<float> colorR_;
+    std::vector<float> colorG_;
+    std::vector<float> colorB_;
+};
+
+/*!
+ * Integriert Position, Rotation, Lebenszeit und Transparenz aller Partikel. Nutzt SSE auf x86,
+ * NEON auf ARM und sonst die skalare Variante. Mit CODINI_NO_SIMD wird immer skalar gerechnet.
+ */
+void integrateParticles(ParticleBuffer& buffer, float deltaTime);
+
+/*!
+ * Skalare Referenzimplementierung von integrateParticles (für Benchmarks und Vergleiche).
+ */
+void integrateParticlesScalar(ParticleBuffer& buffer, float deltaTime);
+
+/*!
+ * Integriert alle Partikel und entfernt anschließend die toten.
+ */
+inline void updateParticles(ParticleBuffer& buffer, float deltaTime) {
+    integrateParticles(buffer, deltaTime);
+    buffer.removeDead();
+}
+
+#endif //CODINI_PARTICLE_BUFFER_H
@@ -0,0 +1,136 @@
+#include "ParticleSystem.h"
+
+#include <cmath>
+
+#include "Profiler.h"
+
+namespace {
+    constexpr float kTwoPi = 6.28318530718f;
+}
+
+StringId particleTextureId(ParticleTexture texture) {
+    static const StringId ids[] = {
+        intern("star_particle.png"),
+        intern("code_particle.png"),
+    };
+    static_assert(sizeof(ids) / sizeof(ids[0]) == static_cast<size_t>(ParticleTexture::COUNT),
+                  "Texturnamen passen nicht zu ParticleTexture");
+    return ids[static_cast<size_t>(texture)];
+}
+
+namespace ParticleEffects {
+    // Kreisförmige Verteilung, gelb
+    const EmitterDescriptor kStarBurst = {
+        ParticleTexture::STAR, 20,
+        0.0f, kTwoPi, 2.0f, 5.0f,
+        0.0f, 0.0f, 0.0f, 0.0f,
+        0.0f, 360.0f, -180.0f, 180.0f,
+        0.3f, 0.6f, 0.5f, 1.5f,
+        {1.0f, 1.0f, 0.0f}
+    };
+
+    // Aufwärts fließend, Cyber-Blau
+    const EmitterDescriptor kCodeEffect = {
+        ParticleTexture::CODE, 10,
+        0.0f, 0.0f, 0.0f, 0.0f,
+        -1.0f, 1.0f, -3.0f, -1.0f,
+        0.0f, 0.0f, 0.0f, 0.0f,
+        0.2f, 0.4f, 0.8f, 2.0f,
+        {0.0f, 1.0f, 0.8f}
+    };
+
+    // Wenige kleine, langsame Sterne
+    const EmitterDescriptor kJump = {
+        ParticleTexture::STAR, 2,
+        0.0f, kTwoPi, 0.5f, 1.5f,
+        0.0f, 0.0f, 0.0f, 0.0f,
+        0.0f, 360.0f, -90.0f, 90.0f,
+        0.1f, 0.25f, 0.2f, 0.5f,
+        {1.0f, 1.0f, 1.0f}
+    };
+
+    const EmitterDescriptor kTeleportOut = {
+        ParticleTexture::STAR, 16,
+        0.0f, kTwoPi, 1.0f, 3.0f,
+        0.0f, 0.0f, 0.0f, 0.0f,
+        0.0f, 360.0f, -360.0f, 360.0f,
+        0.2f, 0.4f, 0.4f, 0.8f,
+        {0.8f, 0.2f, 1.0f}
+    };
+
+    const EmitterDescriptor kTeleportIn = {
+        ParticleTexture::STAR, 16,
+        0.0f, kTwoPi, 1.0f, 3.0f,
+        0.0f, 0.0f, 0.0f, 0.0f,
+        0.0f, 360.0f, -360.0f, 360.0f,
+        0.2f, 0.4f, 0.4f, 0.8f,
+        {0.2f, 0.8f, 1.0f}
+    };
+
+    const EmitterDescriptor kTeleportTrail = {
+        ParticleTexture::CODE, 1,
+        0.0f, 0.0f, 0.0f, 0.0f,
+        -0.5f, 0.5f, -1.5f, -0.5f,
+        0.0f, 0.0f, 0.0f, 0.0f,
+        0.1f, 0.2f, 0.3f, 0.6f,
+        {0.8f, 0.2f, 1.0f}
+    };
+}
+
+ParticleSystem::ParticleSystem(uint64_t seed) : random_(seed) {
+    for (auto& buffer : buffers_) {
+        buffer.reserve(kCapacityPerTexture);
+    }
+}
+
+void ParticleSystem::update(float deltaTime) {
+    PROFILE_ZONE("ParticleSystem::update");
+    for (auto& buffer : buffers_) {
+        updateParticles(buffer, deltaTime);
+    }
+}
+
+int ParticleSystem::emit(const EmitterDescriptor& descriptor, const Vector2& position) {
+    ParticleBuffer& buffer = buffers_[static_cast<size_t>(descriptor.texture)];
+
+    // Volle Puffer wachsen nicht, überzählige Partikel entfallen
+    size_t space = kCapacityPerTexture - buffer.size();
+    int count = descriptor.count < static_cast<int>(space) ? descriptor.count : static_cast<int>(space);
+
+    for (int i = 0; i < count; i++) {
+        Particle p;
+        p.position = position;
+
+        float angle = random_.range(descriptor.minAngle, descriptor.maxAngle);
+        float speed = random_.range(descriptor.minSpeed, descriptor.maxSpeed);
+        p.velocity = {
+            std::cos(angle) * speed + random_.range(descriptor.minVelocityX, descriptor.maxVelocityX),
+            std::sin(angle) * speed + random_.range(descriptor.minVelocityY, descriptor.maxVelocityY)
+        };
+
+        p.rotation = random_.range(descriptor.minRotation, descriptor.maxRotation);
+        p.rotationSpeed = random_.range(descriptor.minRotationSpeed, descriptor.maxRotationSpeed);
+        p.scale = random_.range(descriptor.minScale, descriptor.maxScale);
+        p.life = random_.range(descriptor.minLife, descriptor.maxLife);
+        p.maxLife = p.life;
+        p.color = descriptor.color;
+        p.alpha = 1.0f;
+
+        buffer.push(p);
+    }
+    return count;
+}
+
+void ParticleSystem::clear() {
+    for (auto& buffer : buffers_) {
+        buffer.clear();
+    }
+}
+
+size_t ParticleSystem::getParticleCount() const {
+    size_t count = 0;
+    for (const auto& buffer : buffers_) {
+        count += buffer.size();
+    }
+    return count;
+}
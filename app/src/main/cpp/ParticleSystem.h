@@ -1,160 +1,98 @@
 #ifndef CODINI_PARTICLE_SYSTEM_H
 #define CODINI_PARTICLE_SYSTEM_H
 
-#include <vector>
-#include <random>
-#include <memory>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
 #include "Model.h"
-
-struct Particle {
-    Vector2 position;
-    Vector2 velocity;
-    float rotation;
-    float rotationSpeed;
-    float scale;
-    float life;
-    float maxLife;
-    Vector3 color;
-    float alpha;
+#include "ParticleBuffer.h"
+#include "Random.h"
+#include "StringTable.h"
+
+// Texturen, nach denen der Partikelpool aufgeteilt ist
+enum class ParticleTexture : uint8_t {
+    STAR,
+    CODE,
+    COUNT
 };
 
-class ParticleEmitter {
-public:
-    ParticleEmitter(const Vector2& position, const std::string& textureName)
-        : position_(position), textureName_(textureName) {
-        
-        std::random_device rd;
-        rng_ = std::mt19937(rd());
-    }
-
-    virtual void update(float deltaTime) {
-        // Partikel aktualisieren
-        for (auto it = particles_.begin(); it != particles_.end();) {
-            updateParticle(*it, deltaTime);
-            if (it->life <= 0) {
-                it = particles_.erase(it);
-            } else {
-                ++it;
-            }
-        }
-    }
-
-    virtual void emit(int count) = 0;
-
-    const std::vector<Particle>& getParticles() const { return particles_; }
-    const std::string& getTextureName() const { return textureName_; }
-
-protected:
-    void updateParticle(Particle& particle, float deltaTime) {
-        particle.life -= deltaTime;
-        particle.position.x += particle.velocity.x * deltaTime;
-        particle.position.y += particle.velocity.y * deltaTime;
-        particle.rotation += particle.rotationSpeed * deltaTime;
-        particle.alpha = (particle.life / particle.maxLife);
-    }
-
-    float random(float min, float max) {
-        std::uniform_real_distribution<float> dist(min, max);
-        return dist(rng_);
-    }
-
-    std::vector<Particle> particles_;
-    Vector2 position_;
-    std::string textureName_;
-    std::mt19937 rng_;
+/*!
+ * @return den internierten Dateinamen der Partikeltextur
+ */
+StringId particleTextureId(ParticleTexture texture);
+
+/*!
+ * Beschreibt einen Effekt: wie viele Partikel mit welchen Startwerten entstehen. Die Geschwindigkeit
+ * ist die Summe aus einem zufälligen Polaranteil (Winkel, Betrag) und einem zufälligen
+ * kartesischen Anteil. Deskriptoren sind reine Daten, ein Effekt belegt also keinen eigenen Speicher.
+ */
+struct EmitterDescriptor {
+    ParticleTexture texture;
+    int count;
+    float minAngle, maxAngle;      // Bogenmaß
+    float minSpeed, maxSpeed;
+    float minVelocityX, maxVelocityX;
+    float minVelocityY, maxVelocityY;
+    float minRotation, maxRotation;
+    float minRotationSpeed, maxRotationSpeed;
+    float minScale, maxScale;
+    float minLife, maxLife;
+    Vector3 color;
 };
 
-// Sterne-Partikel für Erfolgseffekt
-class StarEmitter : public ParticleEmitter {
+namespace ParticleEffects {
+    // Sterne-Partikel für Erfolgseffekt
+    extern const EmitterDescriptor kStarBurst;
+    // Cyber-Partikel für Code-Block-Effekt
+    extern const EmitterDescriptor kCodeEffect;
+    // Staub während eines Sprungs
+    extern const EmitterDescriptor kJump;
+    // Blitz beim Verschwinden bzw. Erscheinen
+    extern const EmitterDescriptor kTeleportOut;
+    extern const EmitterDescriptor kTeleportIn;
+    // Spur während des Verschwindens
+    extern const EmitterDescriptor kTeleportTrail;
+}
+
+/*!
+ * Ein globaler Partikelpool mit fester Kapazität pro Textur. Alle Effekte schreiben in denselben
+ * Puffer ihrer Textur und teilen sich einen Zufallsgenerator; nach dem Konstruktor wird nichts mehr
+ * allokiert. Ist ein Puffer voll, werden weitere Partikel verworfen.
+ */
+class ParticleSystem {
 public:
-    StarEmitter(const Vector2& position) 
-        : ParticleEmitter(position, "star_particle.png") {}
+    static constexpr size_t kCapacityPerTexture = 512;
 
-    void emit(int count) override {
-        for (int i = 0; i < count; i++) {
-            Particle p;
-            p.position = position_;
-            
-            // Kreisförmige Verteilung
-            float angle = random(0, 2 * M_PI);
-            float speed = random(2.0f, 5.0f);
-            p.velocity = {cos(angle) * speed, sin(angle) * speed};
-            
-            p.rotation = random(0, 360);
-            p.rotationSpeed = random(-180, 180);
-            p.scale = random(0.3f, 0.6f);
-            p.life = random(0.5f, 1.5f);
-            p.maxLife = p.life;
-            p.color = {1.0f, 1.0f, 0.0f}; // Gelb
-            p.alpha = 1.0f;
-            
-            particles_.push_back(p);
-        }
-    }
-};
+    explicit ParticleSystem(uint64_t seed = 0x5eed);
 
-// Cyber-Partikel für Code-Block-Effekt
-class CodeParticleEmitter : public ParticleEmitter {
-public:
-    CodeParticleEmitter(const Vector2& position)
-        : ParticleEmitter(position, "code_particle.png") {}
+    void update(float deltaTime);
 
-    void emit(int count) override {
-        for (int i = 0; i < count; i++) {
-            Particle p;
-            p.position = position_;
-            
-            // Aufwärts fließend
-            p.velocity = {random(-1.0f, 1.0f), random(-3.0f, -1.0f)};
-            
-            p.rotation = 0;
-            p.rotationSpeed = 0;
-            p.scale = random(0.2f, 0.4f);
-            p.life = random(0.8f, 2.0f);
-            p.maxLife = p.life;
-            p.color = {0.0f, 1.0f, 0.8f}; // Cyber-Blau
-            p.alpha = 1.0f;
-            
-            particles_.push_back(p);
-        }
-    }
-};
+    /*!
+     * Erzeugt die Partikel eines Effekts an der angegebenen Position.
+     * @return Anzahl tatsächlich erzeugter Partikel
+     */
+    int emit(const EmitterDescriptor& descriptor, const Vector2& position);
 
-class ParticleSystem {
-public:
-    void update(float deltaTime) {
-        for (auto& emitter : emitters_) {
-            emitter->update(deltaTime);
-        }
-        
-        // Leere Emitter löschen
-        emitters_.erase(
-            std::remove_if(emitters_.begin(), emitters_.end(),
-                [](const std::unique_ptr<ParticleEmitter>& emitter) {
-                    return emitter->getParticles().empty();
-                }),
-            emitters_.end()
-        );
+    void addStarBurst(const Vector2& position) { emit(ParticleEffects::kStarBurst, position); }
+    void addCodeEffect(const Vector2& position) { emit(ParticleEffects::kCodeEffect, position); }
+    void addJumpEffect(const Vector2& position) { emit(ParticleEffects::kJump, position); }
+    void addTeleportTrail(const Vector2& position) { emit(ParticleEffects::kTeleportTrail, position); }
+    void addTeleportEffect(const Vector2& position, bool disappearing) {
+        emit(disappearing ? ParticleEffects::kTeleportOut : ParticleEffects::kTeleportIn, position);
     }
 
-    void addStarBurst(const Vector2& position) {
-        auto emitter = std::make_unique<StarEmitter>(position);
-        emitter->emit(20); // 20 Sterne-Partikel
-        emitters_.push_back(std::move(emitter));
-    }
+    void clear();
 
-    void addCodeEffect(const Vector2& position) {
-        auto emitter = std::make_unique<CodeParticleEmitter>(position);
-        emitter->emit(10); // 10 Code-Partikel
-        emitters_.push_back(std::move(emitter));
+    const ParticleBuffer& getParticles(ParticleTexture texture) const {
+        return buffers_[static_cast<size_t>(texture)];
     }
 
-    const std::vector<std::unique_ptr<ParticleEmitter>>& getEmitters() const {
-        return emitters_;
-    }
+    size_t getParticleCount() const;
 
 private:
-    std::vector<std::unique_ptr<ParticleEmitter>> emitters_;
+    std::array<ParticleBuffer, static_cast<size_t>(ParticleTexture::COUNT)> buffers_;
+    FastRandom random_;
 };
 
 #endif //CODINI_PARTICLE_SYSTEM_H
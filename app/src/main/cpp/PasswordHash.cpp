@@ -0,0 +1,116 @@
+#include "PasswordHash.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "Sha256.h"
+
+namespace {
+    constexpr std::string_view kScheme = "pbkdf2-sha256";
+    constexpr size_t kSaltSize = 16;
+    constexpr uint32_t kMaxIterations = 100000000;
+
+    struct EncodedHash {
+        uint32_t iterations = 0;
+        std::vector<uint8_t> salt;
+        std::vector<uint8_t> hash;
+    };
+
+    std::string toHex(const uint8_t* bytes, size_t size) {
+        static const char digits[] = "0123456789abcdef";
+        std::string text(size * 2, '0');
+        for (size_t i = 0; i < size; i++) {
+            text[i * 2] = digits[bytes[i] >> 4];
+            text[i * 2 + 1] = digits[bytes[i] & 0xF];
+        }
+        return text;
+    }
+
+    int hexValue(char digit) {
+        if (digit >= '0' && digit <= '9') return digit - '0';
+        if (digit >= 'a' && digit <= 'f') return digit - 'a' + 10;
+        return -1;
+    }
+
+    bool fromHex(std::string_view text, std::vector<uint8_t>& outBytes) {
+        if (text.empty() || text.size() % 2 != 0) {
+            return false;
+        }
+        outBytes.resize(text.size() / 2);
+        for (size_t i = 0; i < outBytes.size(); i++) {
+            int high = hexValue(text[i * 2]);
+            int low = hexValue(text[i * 2 + 1]);
+            if (high < 0 || low < 0) {
+                return false;
+            }
+            outBytes[i] = static_cast<uint8_t>(high << 4 | low);
+        }
+        return true;
+    }
+
+    // Nächstes Feld bis '$' bzw. bis zum Ende
+    std::string_view nextField(std::string_view& text) {
+        size_t end = text.find('$');
+        std::string_view field = text.substr(0, end);
+        text = end == std::string_view::npos ? std::string_view() : text.substr(end + 1);
+        return field;
+    }
+
+    bool decode(std::string_view encoded, EncodedHash& outHash) {
+        if (std::count(encoded.begin(), encoded.end(), '$') != 3 || nextField(encoded) != kScheme) {
+            return false;
+        }
+        std::string_view iterations = nextField(encoded);
+        if (iterations.empty() || iterations.size() > 9) {
+            return false;
+        }
+        uint32_t count = 0;
+        for (char digit : iterations) {
+            if (digit < '0' || digit > '9') return false;
+            count = count * 10 + static_cast<uint32_t>(digit - '0');
+        }
+        if (count == 0 || count > kMaxIterations) {
+            return false;
+        }
+        outHash.iterations = count;
+        return fromHex(nextField(encoded), outHash.salt) &&
+               fromHex(nextField(encoded), outHash.hash) &&
+               outHash.hash.size() == Sha256Digest().size();
+    }
+}
+
+std::string hashPassword(std::string_view password, uint32_t iterations) {
+    uint8_t salt[kSaltSize];
+    std::random_device random;
+    for (size_t i = 0; i < kSaltSize; i += 4) {
+        uint32_t value = random();
+        for (size_t byte = 0; byte < 4; byte++) {
+            salt[i + byte] = static_cast<uint8_t>(value >> (byte * 8));
+        }
+    }
+
+    Sha256Digest derived = pbkdf2Sha256(password.data(), password.size(), salt, kSaltSize, iterations);
+    return std::string(kScheme) + "$" + std::to_string(iterations) + "$" +
+           toHex(salt, kSaltSize) + "$" + toHex(derived.data(), derived.size());
+}
+
+bool verifyPassword(std::string_view password, std::string_view encoded) {
+    EncodedHash stored;
+    if (!decode(encoded, stored)) {
+        return false;
+    }
+    Sha256Digest derived = pbkdf2Sha256(password.data(), password.size(), stored.salt.data(),
+                                        stored.salt.size(), stored.iterations);
+
+    uint8_t difference = 0;
+    for (size_t i = 0; i < derived.size(); i++) {
+        difference |= derived[i] ^ stored.hash[i];
+    }
+    return difference == 0;
+}
+
+bool passwordNeedsRehash(std::string_view encoded, uint32_t iterations) {
+    EncodedHash stored;
+    return !decode(encoded, stored) || stored.iterations < iterations;
+}
@@ -0,0 +1,37 @@
+#ifndef CODINI_PASSWORD_HASH_H
+#define CODINI_PASSWORD_HASH_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/*
+ * Passwort-Hashes für die lokalen Benutzerprofile: PBKDF2-HMAC-SHA-256 mit zufälligem Salt.
+ * Gespeichert wird alles in einer Zeichenkette, damit die Iterationszahl später erhöht werden
+ * kann, ohne alte Profile ungültig zu machen:
+ *
+ *   pbkdf2-sha256$<Iterationen>$<Salt hex>$<Hash hex>
+ */
+
+// Mit codini_hashbench auf das Latenzbudget der Tablets abgestimmt
+constexpr uint32_t kDefaultPasswordIterations = 100000;
+
+/*!
+ * Erzeugt einen neuen Salt und hasht das Passwort.
+ */
+std::string hashPassword(std::string_view password, uint32_t iterations = kDefaultPasswordIterations);
+
+/*!
+ * Prüft ein Passwort gegen einen mit hashPassword erzeugten Eintrag. Der Vergleich braucht
+ * unabhängig vom Inhalt gleich lange.
+ * @return false auch bei ungültigem Format
+ */
+bool verifyPassword(std::string_view password, std::string_view encoded);
+
+/*!
+ * @return true, wenn der Eintrag mit weniger Iterationen erzeugt wurde (oder ungültig ist) und
+ *         nach der nächsten erfolgreichen Anmeldung neu gehasht werden sollte
+ */
+bool passwordNeedsRehash(std::string_view encoded, uint32_t iterations = kDefaultPasswordIterations);
+
+#endif //CODINI_PASSWORD_HASH_H
@@ -0,0 +1,178 @@
+#include "Profiler.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+void FrameHistogram::add(float frameSeconds) {
+    int bucket = static_cast<int>(frameSeconds * 1000.0f);
+    bucket = std::min(std::max(bucket, 0), kBucketCount - 1);
+    maxBucket_ = std::max(maxBucket_, ++buckets_[bucket]);
+    frameCount_++;
+}
+
+void FrameHistogram::reset() {
+    std::fill(std::begin(buckets_), std::end(buckets_), 0u);
+    maxBucket_ = 0;
+    frameCount_ = 0;
+}
+
+float FrameHistogram::percentileMs(float fraction) const {
+    if (frameCount_ == 0) {
+        return 0.0f;
+    }
+    auto wanted = static_cast<uint32_t>(fraction * static_cast<float>(frameCount_));
+    uint32_t seen = 0;
+    for (int i = 0; i < kBucketCount; i++) {
+        seen += buckets_[i];
+        if (seen > wanted) {
+            return static_cast<float>(i + 1);
+        }
+    }
+    return static_cast<float>(kBucketCount);
+}
+
+Profiler& Profiler::global() {
+    static Profiler profiler;
+    return profiler;
+}
+
+uint64_t Profiler::nowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+Profiler::ThreadRing& Profiler::threadRing() {
+    // Ein Puffer pro Thread, nur der erste Aufruf eines Threads nimmt das Lock. Gedacht für
+    // global(), ein Thread, der zwischen mehreren Profilern wechselt, holt jedes Mal neu.
+    struct Lease {
+        std::shared_ptr<RingPool> pool;
+        ThreadRing* ring = nullptr;
+
+        void release() {
+            if (pool) {
+                std::lock_guard<std::mutex> lock(pool->mutex);
+                pool->unused.push_back(ring);
+            }
+        }
+
+        ~Lease() { release(); }
+    };
+    thread_local Lease lease;
+
+    if (lease.pool != pool_) {
+        lease.release();
+        std::lock_guard<std::mutex> lock(pool_->mutex);
+        if (!pool_->unused.empty()) {
+            lease.ring = pool_->unused.back();
+            pool_->unused.pop_back();
+        } else {
+            auto id = static_cast<uint32_t>(pool_->rings.size() + 1);
+            pool_->rings.push_back(std::make_unique<ThreadRing>(id));
+            lease.ring = pool_->rings.back().get();
+        }
+        lease.pool = pool_;
+    }
+    return *lease.ring;
+}
+
+void Profiler::record(const char* name, uint64_t startNs, uint64_t endNs) {
+    ThreadRing& ring = threadRing();
+    uint64_t index = ring.written.load(std::memory_order_relaxed);
+    Slot& slot = ring.slots[index & (kRingCapacity - 1)];
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.startNs.store(startNs, std::memory_order_relaxed);
+    slot.durationNs.store(endNs - startNs, std::memory_order_relaxed);
+    ring.written.store(index + 1, std::memory_order_release);
+}
+
+std::vector<ProfileEvent> Profiler::collect() const {
+    std::vector<ProfileEvent> events;
+    std::lock_guard<std::mutex> lock(pool_->mutex);
+    for (const auto& ring : pool_->rings) {
+        uint64_t end = ring->written.load(std::memory_order_acquire);
+        uint64_t begin = std::max(ring->cleared.load(std::memory_order_relaxed),
+                                  end > kRingCapacity ? end - kRingCapacity : 0);
+        size_t first = events.size();
+        for (uint64_t i = begin; i < end; i++) {
+            const Slot& slot = ring->slots[i & (kRingCapacity - 1)];
+            events.push_back({slot.name.load(std::memory_order_relaxed),
+                              slot.startNs.load(std::memory_order_relaxed),
+                              slot.durationNs.load(std::memory_order_relaxed),
+                              ring->threadId});
+        }
+
+        // Was der Thread während des Kopierens überschrieben hat, ist nicht mehr zuverlässig
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t after = ring->written.load(std::memory_order_relaxed);
+        if (after > kRingCapacity && after - kRingCapacity > begin) {
+            uint64_t lost = std::min(after - kRingCapacity - begin, end - begin);
+            events.erase(events.begin() + static_cast<ptrdiff_t>(first),
+                         events.begin() + static_cast<ptrdiff_t>(first + lost));
+        }
+    }
+
+    std::sort(events.begin(), events.end(), [](const ProfileEvent& a, const ProfileEvent& b) {
+        return a.startNs < b.startNs;
+    });
+    return events;
+}
+
+std::string Profiler::chromeTraceJson() const {
+    std::vector<ProfileEvent> events = collect();
+    uint64_t origin = events.empty() ? 0 : events.front().startNs;
+
+    std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    char buffer[96];
+    bool first = true;
+    for (const auto& event : events) {
+        if (!event.name) {
+            continue;
+        }
+        json += first ? "\n" : ",\n";
+        first = false;
+
+        // Namen sind Literale aus dem Quelltext, zu maskieren sind höchstens " und Backslash
+        json += "{\"name\":\"";
+        for (const char* c = event.name; *c; c++) {
+            if (*c == '"' || *c == '\\') {
+                json += '\\';
+            }
+            json += *c;
+        }
+        std::snprintf(buffer, sizeof(buffer),
+                      "\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+                      static_cast<double>(event.startNs - origin) / 1000.0,
+                      static_cast<double>(event.durationNs) / 1000.0, event.threadId);
+        json += buffer;
+    }
+    json += "\n]}\n";
+    return json;
+}
+
+bool Profiler::writeChromeTrace(const std::string& path, std::string* error) const {
+    std::string json = chromeTraceJson();
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        if (error) {
+            *error = "trace can't be written: " + std::string(std::strerror(errno));
+        }
+        return false;
+    }
+    bool written = std::fwrite(json.data(), 1, json.size(), file) == json.size();
+    written &= std::fclose(file) == 0;
+    if (!written && error) {
+        *error = "trace can't be written";
+    }
+    return written;
+}
+
+void Profiler::reset() {
+    std::lock_guard<std::mutex> lock(pool_->mutex);
+    for (const auto& ring : pool_->rings) {
+        ring->cleared.store(ring->written.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+    frameHistogram_.reset();
+}
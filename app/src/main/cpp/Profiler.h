@@ -0,0 +1,174 @@
+#ifndef CODINI_PROFILER_H
+#define CODINI_PROFILER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Ein gemessener Abschnitt, Zeiten in Nanosekunden seit einem beliebigen, festen Zeitpunkt
+struct ProfileEvent {
+    const char* name;
+    uint64_t startNs;
+    uint64_t durationNs;
+    uint32_t threadId;
+};
+
+/*!
+ * Verteilung der Framezeiten in Millisekunden-Schritten, die letzte Klasse sammelt alles ab
+ * kBucketCount - 1 ms. Wird vom Spiel-Thread geschrieben und gelesen.
+ */
+class FrameHistogram {
+public:
+    static constexpr int kBucketCount = 51;
+
+    void add(float frameSeconds);
+    void reset();
+
+    uint32_t getBucket(int index) const { return buckets_[index]; }
+    uint32_t getMaxBucket() const { return maxBucket_; }
+    uint32_t getFrameCount() const { return frameCount_; }
+
+    /*!
+     * @return die Framezeit in ms, unter der der Anteil fraction (0..1) aller Frames liegt,
+     *         auf die Klassenbreite genau
+     */
+    float percentileMs(float fraction) const;
+
+private:
+    uint32_t buckets_[kBucketCount] = {};
+    uint32_t maxBucket_ = 0;
+    uint32_t frameCount_ = 0;
+};
+
+/*!
+ * Messpunkte für den heißen Pfad. PROFILE_ZONE misst den umgebenden Block und schreibt ihn in
+ * einen Ringpuffer des aufrufenden Threads: zwei Uhrzeitabfragen und drei relaxed-Stores, kein
+ * Lock und keine Allokation. Ist der Puffer voll, werden die ältesten Abschnitte überschrieben;
+ * exportiert wird also immer die jüngste Vergangenheit.
+ *
+ * Jeder Thread bekommt beim ersten Messpunkt einen eigenen Puffer (etwa 200 KB), nur diese
+ * Anmeldung nimmt ein Lock. Endet der Thread, geht der Puffer an den nächsten neuen Thread;
+ * seine Abschnitte bleiben bis dahin im Export. Es gibt also höchstens so viele Puffer, wie
+ * gleichzeitig messende Threads gelebt haben. Der Export (writeChromeTrace) darf aus jedem
+ * Thread laufen, Abschnitte, die dabei gerade überschrieben werden, fallen weg.
+ *
+ * Namen müssen Zeichenkettenliterale sein, gespeichert wird nur der Zeiger. Ohne setEnabled(true)
+ * kostet ein Messpunkt nur das Lesen des Schalters; Release-Builds definieren
+ * CODINI_DISABLE_PROFILER, dann entfallen die Messpunkte ganz.
+ */
+class Profiler {
+public:
+    static constexpr size_t kRingCapacity = 8192;  // Abschnitte pro Thread
+
+    Profiler() = default;
+
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    /*!
+     * @return den gemeinsamen Profiler des Spiels
+     */
+    static Profiler& global();
+
+    static uint64_t nowNs();
+
+    void setEnabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+    bool isEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    /*!
+     * Speichert einen fertigen Abschnitt im Puffer des aufrufenden Threads.
+     */
+    void record(const char* name, uint64_t startNs, uint64_t endNs);
+
+    /*!
+     * Rechnet die Dauer eines ganzen Frames in das Histogramm ein (nur Spiel-Thread).
+     */
+    void markFrame(float frameSeconds) { frameHistogram_.add(frameSeconds); }
+    const FrameHistogram& getFrameHistogram() const { return frameHistogram_; }
+
+    /*!
+     * @return alle noch gepufferten Abschnitte aller Threads, nach Startzeit sortiert
+     */
+    std::vector<ProfileEvent> collect() const;
+
+    /*!
+     * @return die gepufferten Abschnitte im Chrome-Trace-Format (chrome://tracing, Perfetto)
+     */
+    std::string chromeTraceJson() const;
+
+    bool writeChromeTrace(const std::string& path, std::string* error = nullptr) const;
+
+    /*!
+     * Verwirft alle gepufferten Abschnitte und das Histogramm (nur Spiel-Thread).
+     */
+    void reset();
+
+private:
+    // Felder einzeln atomar, damit der Export nie einen halb geschriebenen Abschnitt liest
+    struct Slot {
+        std::atomic<const char*> name{nullptr};
+        std::atomic<uint64_t> startNs{0};
+        std::atomic<uint64_t> durationNs{0};
+    };
+
+    struct ThreadRing {
+        explicit ThreadRing(uint32_t id) : threadId(id) {}
+
+        const uint32_t threadId;
+        alignas(64) std::atomic<uint64_t> written{0};
+        // Ab hier gültig, reset() schreibt den Stand von written hinein
+        std::atomic<uint64_t> cleared{0};
+        Slot slots[kRingCapacity];
+    };
+
+    // Alle Puffer eines Profilers; gemeinsam besessen, weil Threads ihren Puffer erst beim
+    // Beenden zurückgeben, möglicherweise nach dem Profiler
+    struct RingPool {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<ThreadRing>> rings;
+        std::vector<ThreadRing*> unused;  // Puffer beendeter Threads
+    };
+
+    ThreadRing& threadRing();
+
+    std::atomic<bool> enabled_{false};
+    std::shared_ptr<RingPool> pool_ = std::make_shared<RingPool>();
+    FrameHistogram frameHistogram_;
+};
+
+/*!
+ * Misst von der Konstruktion bis zum Ende des Blocks, siehe PROFILE_ZONE.
+ */
+class ProfileZone {
+public:
+    explicit ProfileZone(const char* name)
+            : name_(name), startNs_(Profiler::global().isEnabled() ? Profiler::nowNs() : 0) {}
+
+    ~ProfileZone() {
+        if (startNs_ != 0) {
+            Profiler::global().record(name_, startNs_, Profiler::nowNs());
+        }
+    }
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+private:
+    const char* name_;
+    uint64_t startNs_;
+};
+
+#define CODINI_PROFILE_CONCAT_INNER(a, b) a##b
+#define CODINI_PROFILE_CONCAT(a, b) CODINI_PROFILE_CONCAT_INNER(a, b)
+
+#ifdef CODINI_DISABLE_PROFILER
+#define PROFILE_ZONE(name) do {} while (false)
+#else
+#define PROFILE_ZONE(name) ProfileZone CODINI_PROFILE_CONCAT(profileZone_, __LINE__)(name)
+#endif
+
+#endif //CODINI_PROFILER_H
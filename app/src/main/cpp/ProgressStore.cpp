@@ -0,0 +1,469 @@
+#include "ProgressStore.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+    constexpr char kSnapshotMagic[4] = {'C', 'P', 'R', 'S'};
+    constexpr uint16_t kSnapshotVersion = 1;
+    constexpr const char* kSnapshotName = "/progress.snap";
+    constexpr const char* kSnapshotTempName = "/progress.snap.tmp";
+    constexpr const char* kWalName = "/progress.wal";
+
+    // Logeinträge
+    constexpr uint16_t kRecordProfile = 1;
+    constexpr uint16_t kRecordLevelResult = 2;
+
+    // Obergrenze gegen unsinnige Längen aus beschädigten Dateien
+    constexpr uint32_t kMaxRecordSize = 1 << 20;
+
+    struct SnapshotHeader {
+        char magic[4];
+        uint16_t version;
+        uint16_t headerSize;
+        uint32_t userCount;
+        uint32_t sequence;   // Letzter Logeintrag, der im Abzug enthalten ist
+        uint32_t bodySize;
+        uint32_t crc;        // Über den Rumpf
+    };
+
+    struct RecordHeader {
+        uint32_t size;       // Nutzdaten ohne Header
+        uint32_t crc;        // Über Header (mit crc = 0) und Nutzdaten
+        uint32_t sequence;
+        uint16_t type;
+        uint16_t reserved;
+    };
+
+    static_assert(sizeof(SnapshotHeader) == 24, "SnapshotHeader layout");
+    static_assert(sizeof(RecordHeader) == 16, "RecordHeader layout");
+
+    uint32_t crc32(const void* data, size_t size, uint32_t crc = 0) {
+        static const auto table = [] {
+            struct Table { uint32_t entries[256]; } result{};
+            for (uint32_t i = 0; i < 256; i++) {
+                uint32_t value = i;
+                for (int bit = 0; bit < 8; bit++) {
+                    value = (value & 1) ? 0xEDB88320u ^ (value >> 1) : value >> 1;
+                }
+                result.entries[i] = value;
+            }
+            return result;
+        }();
+
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        crc = ~crc;
+        for (size_t i = 0; i < size; i++) {
+            crc = table.entries[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+        }
+        return ~crc;
+    }
+
+    uint32_t recordCrc(RecordHeader header, const char* payload) {
+        header.crc = 0;
+        return crc32(payload, header.size, crc32(&header, sizeof(header)));
+    }
+
+    bool fail(std::string* error, const std::string& message) {
+        if (error) {
+            *error = message;
+        }
+        return false;
+    }
+
+    bool writeAll(int fd, const void* data, size_t size) {
+        const auto* bytes = static_cast<const char*>(data);
+        while (size > 0) {
+            ssize_t written = ::write(fd, bytes, size);
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            bytes += written;
+            size -= static_cast<size_t>(written);
+        }
+        return true;
+    }
+
+    bool readFile(int fd, std::string& outData) {
+        struct stat info{};
+        if (fstat(fd, &info) != 0) {
+            return false;
+        }
+        outData.resize(static_cast<size_t>(info.st_size));
+        size_t done = 0;
+        while (done < outData.size()) {
+            ssize_t count = ::pread(fd, &outData[done], outData.size() - done,
+                                    static_cast<off_t>(done));
+            if (count < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            if (count == 0) break;
+            done += static_cast<size_t>(count);
+        }
+        outData.resize(done);
+        return true;
+    }
+
+    // Fortschritt liegt auch im Verzeichnis, erst dessen fsync macht ein rename dauerhaft
+    void syncDirectory(const std::string& directory) {
+        int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (fd >= 0) {
+            fsync(fd);
+            ::close(fd);
+        }
+    }
+
+    class Writer {
+    public:
+        explicit Writer(std::string& out) : out_(out) {}
+
+        template<typename T>
+        void put(T value) {
+            out_.append(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        void putString(const std::string& text) {
+            put(static_cast<uint32_t>(text.size()));
+            out_ += text;
+        }
+
+    private:
+        std::string& out_;
+    };
+
+    class Reader {
+    public:
+        Reader(const char* data, size_t size) : data_(data), size_(size) {}
+
+        template<typename T>
+        bool get(T& outValue) {
+            if (size_ - offset_ < sizeof(T)) {
+                return false;
+            }
+            std::memcpy(&outValue, data_ + offset_, sizeof(T));
+            offset_ += sizeof(T);
+            return true;
+        }
+
+        bool getString(std::string& outText) {
+            uint32_t length = 0;
+            if (!get(length) || size_ - offset_ < length) {
+                return false;
+            }
+            outText.assign(data_ + offset_, length);
+            offset_ += length;
+            return true;
+        }
+
+        size_t getOffset() const { return offset_; }
+
+    private:
+        const char* data_;
+        size_t size_;
+        size_t offset_ = 0;
+    };
+
+    void writeProfile(Writer& writer, const UserProfile& profile) {
+        const UserProgress& progress = profile.progress;
+        writer.putString(profile.username);
+        writer.putString(profile.passwordHash);
+        writer.put(static_cast<int32_t>(progress.currentLevel));
+        writer.put(static_cast<int32_t>(progress.totalScore));
+        writer.put(static_cast<int64_t>(progress.lastPlayTime));
+        writer.put(static_cast<uint32_t>(progress.levelScores.size()));
+        for (const auto& entry : progress.levelScores) {
+            auto stars = progress.levelStars.find(entry.first);
+            writer.put(static_cast<int32_t>(entry.first));
+            writer.put(static_cast<int32_t>(entry.second));
+            writer.put(static_cast<int32_t>(stars != progress.levelStars.end() ? stars->second : 0));
+        }
+    }
+
+    bool readProfile(Reader& reader, UserProfile& outProfile) {
+        int32_t currentLevel = 0;
+        int32_t totalScore = 0;
+        int64_t lastPlayTime = 0;
+        uint32_t levelCount = 0;
+        if (!reader.getString(outProfile.username) || !reader.getString(outProfile.passwordHash) ||
+            !reader.get(currentLevel) || !reader.get(totalScore) || !reader.get(lastPlayTime) ||
+            !reader.get(levelCount)) {
+            return false;
+        }
+
+        UserProgress& progress = outProfile.progress;
+        progress = UserProgress{currentLevel, totalScore, {}, {},
+                                static_cast<std::time_t>(lastPlayTime)};
+        for (uint32_t i = 0; i < levelCount; i++) {
+            int32_t level = 0;
+            int32_t score = 0;
+            int32_t stars = 0;
+            if (!reader.get(level) || !reader.get(score) || !reader.get(stars)) {
+                return false;
+            }
+            // Einträge sind nach Level sortiert geschrieben
+            progress.levelScores.emplace_hint(progress.levelScores.end(), level, score);
+            if (stars > 0) {
+                progress.levelStars.emplace_hint(progress.levelStars.end(), level, stars);
+            }
+        }
+        outProfile.isLoggedIn = false;
+        return true;
+    }
+
+    bool applyLevelResult(Reader& reader, std::map<std::string, UserProfile>& users) {
+        std::string username;
+        int32_t level = 0;
+        int32_t score = 0;
+        int32_t stars = 0;
+        int32_t currentLevel = 0;
+        int32_t totalScore = 0;
+        int64_t lastPlayTime = 0;
+        if (!reader.getString(username) || !reader.get(level) || !reader.get(score) ||
+            !reader.get(stars) || !reader.get(currentLevel) || !reader.get(totalScore) ||
+            !reader.get(lastPlayTime)) {
+            return false;
+        }
+
+        auto it = users.find(username);
+        if (it == users.end()) {
+            return true;  // Profil fehlt, Eintrag ist gültig, aber nicht anwendbar
+        }
+        UserProgress& progress = it->second.progress;
+        progress.levelScores[level] = score;
+        progress.levelStars[level] = stars;
+        progress.currentLevel = currentLevel;
+        progress.totalScore = totalScore;
+        progress.lastPlayTime = static_cast<std::time_t>(lastPlayTime);
+        return true;
+    }
+}
+
+ProgressStore::~ProgressStore() {
+    close();
+}
+
+bool ProgressStore::open(const std::string& directory, std::map<std::string, UserProfile>& outUsers,
+                         std::string* error) {
+    close();
+    directory_ = directory;
+    outUsers.clear();
+
+    if (!loadSnapshot(outUsers, error)) {
+        return false;
+    }
+
+    walFd_ = ::open((directory_ + kWalName).c_str(), O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0600);
+    if (walFd_ < 0) {
+        return fail(error, "progress log can't be opened: " + std::string(std::strerror(errno)));
+    }
+    if (!replayWal(outUsers, error)) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void ProgressStore::close() {
+    if (walFd_ >= 0) {
+        ::close(walFd_);
+        walFd_ = -1;
+    }
+    walBytes_ = 0;
+    snapshotSequence_ = 0;
+    nextSequence_ = 1;
+}
+
+bool ProgressStore::loadSnapshot(std::map<std::string, UserProfile>& users, std::string* error) {
+    int fd = ::open((directory_ + kSnapshotName).c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        if (errno == ENOENT) {
+            return true;  // Erster Start
+        }
+        return fail(error, "progress snapshot can't be opened: " + std::string(std::strerror(errno)));
+    }
+    std::string data;
+    bool read = readFile(fd, data);
+    ::close(fd);
+    if (!read) {
+        return fail(error, "progress snapshot can't be read");
+    }
+
+    SnapshotHeader header{};
+    if (data.size() < sizeof(header)) {
+        return fail(error, "progress snapshot too small");
+    }
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (std::memcmp(header.magic, kSnapshotMagic, sizeof(kSnapshotMagic)) != 0 ||
+        header.version != kSnapshotVersion || header.headerSize != sizeof(SnapshotHeader)) {
+        return fail(error, "unsupported progress snapshot");
+    }
+    if (header.bodySize != data.size() - sizeof(header) ||
+        crc32(data.data() + sizeof(header), header.bodySize) != header.crc) {
+        return fail(error, "progress snapshot is damaged");
+    }
+
+    // Profile sind nach Namen sortiert, das Einfügen am Ende ist damit konstant
+    Reader reader(data.data() + sizeof(header), header.bodySize);
+    for (uint32_t i = 0; i < header.userCount; i++) {
+        UserProfile profile;
+        if (!readProfile(reader, profile)) {
+            users.clear();
+            return fail(error, "progress snapshot is damaged");
+        }
+        std::string name = profile.username;
+        users.emplace_hint(users.end(), std::move(name), std::move(profile));
+    }
+
+    snapshotSequence_ = header.sequence;
+    nextSequence_ = header.sequence + 1;
+    return true;
+}
+
+bool ProgressStore::replayWal(std::map<std::string, UserProfile>& users, std::string* error) {
+    std::string data;
+    if (!readFile(walFd_, data)) {
+        return fail(error, "progress log can't be read");
+    }
+
+    size_t offset = 0;
+    while (data.size() - offset >= sizeof(RecordHeader)) {
+        RecordHeader header{};
+        std::memcpy(&header, data.data() + offset, sizeof(header));
+        const char* payload = data.data() + offset + sizeof(header);
+        if (header.size > kMaxRecordSize || header.size > data.size() - offset - sizeof(header) ||
+            recordCrc(header, payload) != header.crc) {
+            break;  // Abgerissener oder beschädigter Eintrag, alles danach ist ungültig
+        }
+
+        if (header.sequence > snapshotSequence_) {
+            Reader reader(payload, header.size);
+            bool applied = true;
+            if (header.type == kRecordProfile) {
+                UserProfile profile;
+                applied = readProfile(reader, profile);
+                if (applied) {
+                    std::string name = profile.username;
+                    users[name] = std::move(profile);
+                }
+            } else if (header.type == kRecordLevelResult) {
+                applied = applyLevelResult(reader, users);
+            }
+            if (!applied) {
+                break;
+            }
+        }
+
+        offset += sizeof(header) + header.size;
+        if (header.sequence >= nextSequence_) {
+            nextSequence_ = header.sequence + 1;
+        }
+    }
+
+    if (offset != data.size() && ftruncate(walFd_, static_cast<off_t>(offset)) != 0) {
+        return fail(error, "progress log can't be repaired");
+    }
+    walBytes_ = offset;
+    return true;
+}
+
+bool ProgressStore::appendRecord(uint16_t type, const std::string& payload) {
+    if (walFd_ < 0) {
+        return false;
+    }
+    RecordHeader header{static_cast<uint32_t>(payload.size()), 0, nextSequence_, type, 0};
+    header.crc = recordCrc(header, payload.data());
+
+    // Ein write pro Eintrag, damit ein Absturz höchstens den letzten Eintrag abreißt
+    std::string record;
+    record.reserve(sizeof(header) + payload.size());
+    record.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    record += payload;
+    if (!writeAll(walFd_, record.data(), record.size())) {
+        // Teilweise geschriebene Bytes abschneiden, sonst landen alle folgenden Einträge hinter
+        // einem abgerissenen Eintrag und gehen beim nächsten Öffnen verloren
+        if (ftruncate(walFd_, static_cast<off_t>(walBytes_)) != 0) {
+            ::close(walFd_);
+            walFd_ = -1;
+        }
+        return false;
+    }
+    nextSequence_++;
+    walBytes_ += record.size();
+    return true;
+}
+
+bool ProgressStore::appendProfile(const UserProfile& profile) {
+    std::string payload;
+    Writer writer(payload);
+    writeProfile(writer, profile);
+    return appendRecord(kRecordProfile, payload);
+}
+
+bool ProgressStore::appendLevelResult(const std::string& username, int levelNumber,
+                                      const UserProgress& progress) {
+    auto score = progress.levelScores.find(levelNumber);
+    auto stars = progress.levelStars.find(levelNumber);
+
+    std::string payload;
+    Writer writer(payload);
+    writer.putString(username);
+    writer.put(static_cast<int32_t>(levelNumber));
+    writer.put(static_cast<int32_t>(score != progress.levelScores.end() ? score->second : 0));
+    writer.put(static_cast<int32_t>(stars != progress.levelStars.end() ? stars->second : 0));
+    writer.put(static_cast<int32_t>(progress.currentLevel));
+    writer.put(static_cast<int32_t>(progress.totalScore));
+    writer.put(static_cast<int64_t>(progress.lastPlayTime));
+    return appendRecord(kRecordLevelResult, payload);
+}
+
+bool ProgressStore::compact(const std::map<std::string, UserProfile>& users) {
+    if (walFd_ < 0) {
+        return false;
+    }
+
+    std::string data(sizeof(SnapshotHeader), '\0');
+    Writer writer(data);
+    for (const auto& entry : users) {
+        writeProfile(writer, entry.second);
+    }
+
+    SnapshotHeader header{};
+    std::memcpy(header.magic, kSnapshotMagic, sizeof(kSnapshotMagic));
+    header.version = kSnapshotVersion;
+    header.headerSize = sizeof(SnapshotHeader);
+    header.userCount = static_cast<uint32_t>(users.size());
+    header.sequence = nextSequence_ - 1;
+    header.bodySize = static_cast<uint32_t>(data.size() - sizeof(header));
+    header.crc = crc32(data.data() + sizeof(header), header.bodySize);
+    std::memcpy(&data[0], &header, sizeof(header));
+
+    std::string tempPath = directory_ + kSnapshotTempName;
+    int fd = ::open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        return false;
+    }
+    bool written = writeAll(fd, data.data(), data.size()) && fsync(fd) == 0;
+    ::close(fd);
+    if (!written || rename(tempPath.c_str(), (directory_ + kSnapshotName).c_str()) != 0) {
+        unlink(tempPath.c_str());
+        return false;
+    }
+    syncDirectory(directory_);
+
+    // Ab hier deckt der Abzug alle Logeinträge ab, ein Absturz vor dem Leeren schadet nicht
+    snapshotSequence_ = header.sequence;
+    if (ftruncate(walFd_, 0) != 0) {
+        return false;
+    }
+    walBytes_ = 0;
+    return fsync(walFd_) == 0;
+}
+
+bool ProgressStore::sync() {
+    return walFd_ >= 0 && fsync(walFd_) == 0;
+}
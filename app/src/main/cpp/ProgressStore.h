@@ -0,0 +1,91 @@
+#ifndef CODINI_PROGRESS_STORE_H
+#define CODINI_PROGRESS_STORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+
+#include "UserProfile.h"
+
+/*!
+ * Lokaler Speicher für Benutzerprofile und Fortschritt.
+ *
+ * Zwei Dateien im Verzeichnis:
+ *   progress.snap  Abzug aller Profile, sortiert nach Benutzername
+ *   progress.wal   Anhängelog mit einem Eintrag pro Registrierung bzw. abgeschlossenem Level
+ *
+ * Jeder Logeintrag trägt eine fortlaufende Sequenznummer und eine CRC32. Beim Öffnen wird der
+ * Abzug gelesen und das Log darauf angewendet, Einträge bis einschließlich der Sequenz des
+ * Abzugs werden übersprungen. Ein abgerissener Eintrag am Ende (Absturz während write) wird
+ * abgeschnitten. compact() schreibt einen neuen Abzug per temporärer Datei + rename und leert
+ * danach das Log; stürzt die App dazwischen ab, sind die Logeinträge über die Sequenz bereits
+ * abgedeckt.
+ *
+ * Anhängen schreibt nur in den Seitencache, sync() macht die Daten mit fsync dauerhaft.
+ * Nicht threadsicher, ein Besitzer pro Verzeichnis.
+ */
+class ProgressStore {
+public:
+    ProgressStore() = default;
+    ~ProgressStore();
+
+    ProgressStore(const ProgressStore&) = delete;
+    ProgressStore& operator=(const ProgressStore&) = delete;
+
+    /*!
+     * Öffnet oder erzeugt den Speicher und lädt alle Profile nach outUsers.
+     * @return false mit Grund in error, wenn das Verzeichnis nicht nutzbar oder der Abzug
+     *         beschädigt ist
+     */
+    bool open(const std::string& directory, std::map<std::string, UserProfile>& outUsers,
+              std::string* error = nullptr);
+
+    void close();
+
+    bool isOpen() const { return walFd_ >= 0; }
+
+    /*!
+     * Hängt ein ganzes Profil an (Registrierung, Passwortwechsel).
+     */
+    bool appendProfile(const UserProfile& profile);
+
+    /*!
+     * Hängt ein abgeschlossenes Level an. Gespeichert werden die Werte nach der Änderung, nicht
+     * die Differenz, damit das Wiederholen eines Eintrags nichts verfälscht.
+     */
+    bool appendLevelResult(const std::string& username, int levelNumber,
+                           const UserProgress& progress);
+
+    /*!
+     * Schreibt den aktuellen Stand aller Profile als neuen Abzug und leert das Log.
+     */
+    bool compact(const std::map<std::string, UserProfile>& users);
+
+    /*!
+     * @return true, wenn das Log groß genug ist, dass sich compact() lohnt
+     */
+    bool shouldCompact() const { return walBytes_ >= kCompactBytes; }
+
+    /*!
+     * Macht alle bisher angehängten Einträge dauerhaft (fsync).
+     */
+    bool sync();
+
+    size_t getWalBytes() const { return walBytes_; }
+
+private:
+    static constexpr size_t kCompactBytes = 64 * 1024;
+
+    bool loadSnapshot(std::map<std::string, UserProfile>& users, std::string* error);
+    bool replayWal(std::map<std::string, UserProfile>& users, std::string* error);
+    bool appendRecord(uint16_t type, const std::string& payload);
+
+    std::string directory_;
+    int walFd_ = -1;
+    size_t walBytes_ = 0;
+    uint32_t snapshotSequence_ = 0;
+    uint32_t nextSequence_ = 1;
+};
+
+#endif //CODINI_PROGRESS_STORE_H
@@ -0,0 +1,163 @@
+#include "ProgressWriter.h"
+
+#include <algorithm>
+#include <utility>
+
+ProgressWriter::~ProgressWriter() {
+    close();
+}
+
+bool ProgressWriter::open(const std::string& directory, std::map<std::string, UserProfile>& outUsers,
+                          std::string* error) {
+    close();
+    if (!store_.open(directory, outUsers, error)) {
+        return false;
+    }
+    users_ = outUsers;
+    stopping_ = false;
+    flushRequested_.store(0, std::memory_order_relaxed);
+    flushCompleted_ = 0;
+    worker_ = std::thread(&ProgressWriter::workerLoop, this);
+    return true;
+}
+
+void ProgressWriter::close() {
+    if (!worker_.joinable()) {
+        return;
+    }
+    flush();
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        stopping_ = true;
+    }
+    wakeUp_.notify_one();
+    worker_.join();
+    store_.close();
+    users_.clear();
+}
+
+void ProgressWriter::publishProfile(const UserProfile& profile) {
+    publish(Entry{Kind::PROFILE, 0, std::make_shared<const UserProfile>(profile)});
+}
+
+void ProgressWriter::publishLevelResult(const UserProfile& profile, int levelNumber) {
+    publish(Entry{Kind::LEVEL_RESULT, levelNumber, std::make_shared<const UserProfile>(profile)});
+}
+
+void ProgressWriter::publish(Entry entry) {
+    if (!isOpen()) {
+        return;
+    }
+    {
+        // Reihenfolge erhalten: Neues darf erst in die Warteschlange, wenn der Rückstau leer ist
+        std::lock_guard<std::mutex> lock(publishMutex_);
+        if (!pushBacklog() || !queue_.tryPush(std::move(entry))) {
+            backlog_.push_back(std::move(entry));
+        }
+    }
+    wake();
+}
+
+bool ProgressWriter::pushBacklog() {
+    // Aufrufer hält publishMutex_
+    size_t pushed = 0;
+    while (pushed < backlog_.size() && queue_.tryPush(std::move(backlog_[pushed]))) {
+        pushed++;
+    }
+    backlog_.erase(backlog_.begin(), backlog_.begin() + static_cast<std::ptrdiff_t>(pushed));
+    return backlog_.empty();
+}
+
+void ProgressWriter::wake() {
+    // Kurz sperren, damit der Worker zwischen Prüfen und Einschlafen nichts verpasst
+    { std::lock_guard<std::mutex> lock(wakeMutex_); }
+    wakeUp_.notify_one();
+}
+
+void ProgressWriter::flush() {
+    if (!isOpen()) {
+        return;
+    }
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(publishMutex_);
+            if (pushBacklog()) {
+                break;
+            }
+        }
+        wake();
+        std::this_thread::yield();
+    }
+    uint64_t generation = flushRequested_.fetch_add(1, std::memory_order_acq_rel) + 1;
+    wake();
+
+    std::unique_lock<std::mutex> lock(wakeMutex_);
+    flushed_.wait(lock, [&] { return flushCompleted_ >= generation; });
+}
+
+void ProgressWriter::workerLoop() {
+    std::vector<Entry> batch;
+    while (true) {
+        uint64_t flushTarget = 0;
+        {
+            std::unique_lock<std::mutex> lock(wakeMutex_);
+            wakeUp_.wait(lock, [&] {
+                return stopping_ || !queue_.empty() ||
+                       flushRequested_.load(std::memory_order_acquire) > flushCompleted_;
+            });
+            if (stopping_ && queue_.empty()) {
+                break;
+            }
+            // Vor dem Abholen lesen: alles, was vor der Anforderung veröffentlicht wurde, ist drin
+            flushTarget = flushRequested_.load(std::memory_order_acquire);
+        }
+
+        Entry entry;
+        while (queue_.tryPop(entry)) {
+            batch.push_back(std::move(entry));
+        }
+        writeBatch(batch);
+        batch.clear();
+
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex_);
+            flushCompleted_ = std::max(flushCompleted_, flushTarget);
+        }
+        flushed_.notify_all();
+    }
+}
+
+void ProgressWriter::writeBatch(std::vector<Entry>& batch) {
+    // Zusammenfassen: pro Benutzer zählt nur das letzte Profil, pro Benutzer und Level nur das
+    // letzte Ergebnis. Die Logeinträge enthalten absolute Werte, die übrigen bleiben gültig.
+    std::map<std::string, size_t> lastProfile;
+    std::map<std::pair<std::string, int>, size_t> lastResult;
+    for (size_t i = 0; i < batch.size(); i++) {
+        const Entry& entry = batch[i];
+        const std::string& name = entry.profile->username;
+        if (entry.kind == Kind::PROFILE) {
+            lastProfile[name] = i;
+        } else {
+            lastResult[{name, entry.levelNumber}] = i;
+        }
+        users_[name] = *entry.profile;
+    }
+
+    for (size_t i = 0; i < batch.size(); i++) {
+        const Entry& entry = batch[i];
+        const std::string& name = entry.profile->username;
+        if (entry.kind == Kind::PROFILE) {
+            if (lastProfile[name] == i) {
+                store_.appendProfile(*entry.profile);
+            }
+        } else if (lastResult[{name, entry.levelNumber}] == i) {
+            store_.appendLevelResult(name, entry.levelNumber, entry.profile->progress);
+        }
+    }
+
+    // Ein fsync pro Stapel; ohne neue Einträge ist er billig und bestätigt nur flush()
+    store_.sync();
+    if (store_.shouldCompact()) {
+        store_.compact(users_);
+    }
+}
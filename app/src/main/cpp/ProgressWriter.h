@@ -0,0 +1,99 @@
+#ifndef CODINI_PROGRESS_WRITER_H
+#define CODINI_PROGRESS_WRITER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ProgressStore.h"
+#include "SpscQueue.h"
+#include "UserProfile.h"
+
+/*!
+ * Schreibt den Benutzerfortschritt im Hintergrund (write-behind).
+ *
+ * Spiel und Sync veröffentlichen unveränderliche Kopien des Profils in eine SPSC-Warteschlange
+ * und kehren sofort zurück. Ein eigener Thread besitzt den ProgressStore: er holt alles ab, was
+ * anliegt, fasst mehrere Stände desselben Levels zusammen, hängt sie an das Log und macht den
+ * Stapel mit einem fsync dauerhaft. Compaction läuft ebenfalls dort, auf einer eigenen Kopie
+ * aller Profile.
+ *
+ * publishProfile, publishLevelResult und flush dürfen von beliebigen Threads kommen: die
+ * Erzeuger stellen sich an publishMutex_ an, die Warteschlange sieht also immer nur einen
+ * Erzeuger zur Zeit. open und close gehören dem Spiel-Thread.
+ */
+class ProgressWriter {
+public:
+    ProgressWriter() = default;
+    ~ProgressWriter();
+
+    ProgressWriter(const ProgressWriter&) = delete;
+    ProgressWriter& operator=(const ProgressWriter&) = delete;
+
+    /*!
+     * Lädt alle Profile synchron nach outUsers und startet danach den Schreib-Thread.
+     */
+    bool open(const std::string& directory, std::map<std::string, UserProfile>& outUsers,
+              std::string* error = nullptr);
+
+    /*!
+     * Wartet, bis alles geschrieben ist, und beendet den Thread.
+     */
+    void close();
+
+    bool isOpen() const { return worker_.joinable(); }
+
+    // Ganzes Profil (Registrierung)
+    void publishProfile(const UserProfile& profile);
+
+    // Ergebnis eines abgeschlossenen Levels, profile ist der Stand danach
+    void publishLevelResult(const UserProfile& profile, int levelNumber);
+
+    /*!
+     * Blockiert, bis alles bisher Veröffentlichte per fsync dauerhaft ist. Für den Moment, in
+     * dem die App ihr Fenster verliert (APP_CMD_TERM_WINDOW): dann wird ohnehin nicht gerendert.
+     */
+    void flush();
+
+private:
+    enum class Kind : uint8_t {
+        PROFILE,
+        LEVEL_RESULT
+    };
+
+    struct Entry {
+        Kind kind = Kind::PROFILE;
+        int levelNumber = 0;
+        std::shared_ptr<const UserProfile> profile;
+    };
+
+    static constexpr size_t kQueueCapacity = 64;
+
+    void publish(Entry entry);
+    bool pushBacklog();
+    void wake();
+    void workerLoop();
+    void writeBatch(std::vector<Entry>& batch);
+
+    ProgressStore store_;
+    std::map<std::string, UserProfile> users_;  // Kopie für compact(), nur Schreib-Thread
+    SpscQueue<Entry, kQueueCapacity> queue_;
+    std::mutex publishMutex_;                   // Serialisiert die Erzeuger
+    std::vector<Entry> backlog_;                // Volle Warteschlange, unter publishMutex_
+
+    std::thread worker_;
+    std::mutex wakeMutex_;
+    std::condition_variable wakeUp_;
+    std::condition_variable flushed_;
+    std::atomic<uint64_t> flushRequested_{0};
+    uint64_t flushCompleted_ = 0;               // Unter wakeMutex_
+    bool stopping_ = false;                     // Unter wakeMutex_
+};
+
+#endif //CODINI_PROGRESS_WRITER_H
@@ -0,0 +1,148 @@
+#include "RecordingGLBackend.h"
+
+#include <cstring>
+#include <sstream>
+
+namespace {
+    const char* callName(GLCall call) {
+        static const char* names[] = {
+            "createVertexArray",
+            "deleteVertexArray",
+            "bindVertexArray",
+            "createBuffer",
+            "deleteBuffer",
+            "bindBuffer",
+            "bufferData",
+            "bufferSubData",
+            "vertexAttribPointer",
+            "enableVertexAttribArray",
+            "bindTexture",
+            "setBlendMode",
+            "drawTriangles",
+        };
+        static_assert(sizeof(names) / sizeof(names[0]) == static_cast<size_t>(GLCall::DRAW_TRIANGLES) + 1,
+                      "Namen passen nicht zu GLCall");
+        return names[static_cast<size_t>(call)];
+    }
+}
+
+uint32_t RecordingGLBackend::createVertexArray() {
+    uint32_t name = nextName_++;
+    commands_.push_back({GLCall::CREATE_VERTEX_ARRAY, name});
+    vertexArrayIndexBuffers_[name] = 0;
+    return name;
+}
+
+void RecordingGLBackend::deleteVertexArray(uint32_t vertexArray) {
+    commands_.push_back({GLCall::DELETE_VERTEX_ARRAY, vertexArray});
+    vertexArrayIndexBuffers_.erase(vertexArray);
+    if (boundVertexArray_ == vertexArray) {
+        boundVertexArray_ = 0;
+    }
+}
+
+void RecordingGLBackend::bindVertexArray(uint32_t vertexArray) {
+    commands_.push_back({GLCall::BIND_VERTEX_ARRAY, vertexArray});
+    boundVertexArray_ = vertexArray;
+}
+
+uint32_t RecordingGLBackend::createBuffer() {
+    uint32_t name = nextName_++;
+    commands_.push_back({GLCall::CREATE_BUFFER, name});
+    buffers_[name];
+    return name;
+}
+
+void RecordingGLBackend::deleteBuffer(uint32_t buffer) {
+    commands_.push_back({GLCall::DELETE_BUFFER, buffer});
+    buffers_.erase(buffer);
+}
+
+void RecordingGLBackend::bindBuffer(BufferTarget target, uint32_t buffer) {
+    commands_.push_back({GLCall::BIND_BUFFER, static_cast<uint32_t>(target), buffer});
+    if (target == BufferTarget::VERTEX) {
+        boundVertexBuffer_ = buffer;
+    } else {
+        // Der Indexpuffer gehört wie in GL zum Vertex Array
+        vertexArrayIndexBuffers_[boundVertexArray_] = buffer;
+    }
+}
+
+void RecordingGLBackend::bufferData(BufferTarget target, size_t size, const void* data, BufferUsage usage) {
+    commands_.push_back({GLCall::BUFFER_DATA, static_cast<uint32_t>(target),
+                         static_cast<uint32_t>(usage), size, data ? 1u : 0u});
+    auto it = buffers_.find(boundBuffer(target));
+    if (it == buffers_.end()) {
+        return;
+    }
+    it->second.assign(size, 0);
+    if (data) {
+        std::memcpy(it->second.data(), data, size);
+    }
+}
+
+void RecordingGLBackend::bufferSubData(BufferTarget target, size_t offset, size_t size, const void* data) {
+    commands_.push_back({GLCall::BUFFER_SUB_DATA, static_cast<uint32_t>(target), 0, offset, size});
+    auto it = buffers_.find(boundBuffer(target));
+    if (it == buffers_.end() || offset + size > it->second.size()) {
+        return;
+    }
+    std::memcpy(it->second.data() + offset, data, size);
+}
+
+void RecordingGLBackend::vertexAttribPointer(uint32_t location, int components, AttribType type,
+                                             bool normalized, size_t stride, size_t offset) {
+    commands_.push_back({GLCall::VERTEX_ATTRIB_POINTER, location,
+                         static_cast<uint32_t>(components) | static_cast<uint32_t>(type) << 8
+                                 | (normalized ? 1u << 16 : 0u),
+                         stride, offset});
+}
+
+void RecordingGLBackend::enableVertexAttribArray(uint32_t location) {
+    commands_.push_back({GLCall::ENABLE_VERTEX_ATTRIB_ARRAY, location});
+}
+
+void RecordingGLBackend::bindTexture(uint32_t texture) {
+    commands_.push_back({GLCall::BIND_TEXTURE, texture});
+}
+
+void RecordingGLBackend::setBlendMode(BlendMode mode) {
+    commands_.push_back({GLCall::SET_BLEND_MODE, static_cast<uint32_t>(mode)});
+}
+
+void RecordingGLBackend::drawTriangles(size_t indexCount, size_t indexOffset) {
+    commands_.push_back({GLCall::DRAW_TRIANGLES, 0, 0, indexCount, indexOffset});
+}
+
+size_t RecordingGLBackend::count(GLCall call) const {
+    size_t result = 0;
+    for (const auto& command : commands_) {
+        if (command.call == call) {
+            result++;
+        }
+    }
+    return result;
+}
+
+const std::vector<uint8_t>& RecordingGLBackend::getBufferContents(uint32_t buffer) const {
+    static const std::vector<uint8_t> empty;
+    auto it = buffers_.find(buffer);
+    return it != buffers_.end() ? it->second : empty;
+}
+
+std::string RecordingGLBackend::describe() const {
+    std::ostringstream out;
+    for (const auto& command : commands_) {
+        out << callName(command.call) << "(" << command.a << ", " << command.b << ", "
+            << command.c << ", " << command.d << ")\n";
+    }
+    return out.str();
+}
+
+uint32_t RecordingGLBackend::boundBuffer(BufferTarget target) const {
+    if (target == BufferTarget::VERTEX) {
+        return boundVertexBuffer_;
+    }
+    auto it = vertexArrayIndexBuffers_.find(boundVertexArray_);
+    return it != vertexArrayIndexBuffers_.end() ? it->second : 0;
+}
@@ -0,0 +1,83 @@
+#ifndef CODINI_RECORDING_GL_BACKEND_H
+#define CODINI_RECORDING_GL_BACKEND_H
+
+#include "GLBackend.h"
+#include <map>
+#include <string>
+#include <vector>
+
+enum class GLCall : uint8_t {
+    CREATE_VERTEX_ARRAY,
+    DELETE_VERTEX_ARRAY,
+    BIND_VERTEX_ARRAY,
+    CREATE_BUFFER,
+    DELETE_BUFFER,
+    BIND_BUFFER,
+    BUFFER_DATA,
+    BUFFER_SUB_DATA,
+    VERTEX_ATTRIB_POINTER,
+    ENABLE_VERTEX_ATTRIB_ARRAY,
+    BIND_TEXTURE,
+    SET_BLEND_MODE,
+    DRAW_TRIANGLES
+};
+
+// Ein aufgezeichneter Aufruf; die Bedeutung der Argumente hängt vom Aufruf ab
+struct GLCommand {
+    GLCall call;
+    uint32_t a = 0;
+    uint32_t b = 0;
+    size_t c = 0;
+    size_t d = 0;
+};
+
+/*!
+ * GLBackend für Host-Builds: zeichnet alle Aufrufe auf und hält den Inhalt der Puffer im Speicher,
+ * statt etwas zu zeichnen. Ermöglicht Prüfungen wie "ein Draw-Call pro Textur".
+ */
+class RecordingGLBackend : public GLBackend {
+public:
+    uint32_t createVertexArray() override;
+    void deleteVertexArray(uint32_t vertexArray) override;
+    void bindVertexArray(uint32_t vertexArray) override;
+
+    uint32_t createBuffer() override;
+    void deleteBuffer(uint32_t buffer) override;
+    void bindBuffer(BufferTarget target, uint32_t buffer) override;
+    void bufferData(BufferTarget target, size_t size, const void* data, BufferUsage usage) override;
+    void bufferSubData(BufferTarget target, size_t offset, size_t size, const void* data) override;
+
+    void vertexAttribPointer(uint32_t location, int components, AttribType type,
+                             bool normalized, size_t stride, size_t offset) override;
+    void enableVertexAttribArray(uint32_t location) override;
+
+    void bindTexture(uint32_t texture) override;
+    void setBlendMode(BlendMode mode) override;
+    void drawTriangles(size_t indexCount, size_t indexOffset) override;
+
+    const std::vector<GLCommand>& getCommands() const { return commands_; }
+    size_t count(GLCall call) const;
+    void clearCommands() { commands_.clear(); }
+
+    /*!
+     * @return den aktuellen Inhalt eines Puffers, leer wenn er nicht existiert
+     */
+    const std::vector<uint8_t>& getBufferContents(uint32_t buffer) const;
+
+    /*!
+     * @return alle Aufrufe als Text, eine Zeile pro Aufruf (zum Debuggen)
+     */
+    std::string describe() const;
+
+private:
+    uint32_t boundBuffer(BufferTarget target) const;
+
+    std::vector<GLCommand> commands_;
+    std::map<uint32_t, std::vector<uint8_t>> buffers_;
+    std::map<uint32_t, uint32_t> vertexArrayIndexBuffers_;
+    uint32_t nextName_ = 1;
+    uint32_t boundVertexArray_ = 0;
+    uint32_t boundVertexBuffer_ = 0;
+};
+
+#endif //CODINI_RECORDING_GL_BACKEND_H
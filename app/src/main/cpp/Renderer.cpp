@@ -6,31 +6,32 @@
 #include <vector>
 #include <android/imagedecoder.h>
 
-#include "AndroidOut.h"
+#include "Log.h"
 #include "Shader.h"
+#include "Simulation.h"
+#include "TextureAtlas.h"
 #include "Utility.h"
 #include "TextureAsset.h"
 
 //! executes glGetString and outputs the result to logcat
-#define PRINT_GL_STRING(s) {aout << #s": "<< glGetString(s) << std::endl;}
+#define PRINT_GL_STRING(s) LOG_I(#s": {}", reinterpret_cast<const char*>(glGetString(s)))
 
 /*!
  * @brief if glGetString returns a space separated list of elements, prints each one on a new line
  *
  * This works by creating an istringstream of the input c-style string. Then that is used to create
  * a vector -- each element of the vector is a new element in the input string. Finally a foreach
- * loop consumes this and outputs it to logcat using @a aout
+ * loop consumes this and outputs each element as its own debug log line
  */
 #define PRINT_GL_STRING_AS_LIST(s) { \
 std::istringstream extensionStream((const char *) glGetString(s));\
 std::vector<std::string> extensionList(\
         std::istream_iterator<std::string>{extensionStream},\
         std::istream_iterator<std::string>());\
-aout << #s":\n";\
+LOG_D(#s": {} entries", extensionList.size());\
 for (auto& extension: extensionList) {\
-    aout << extension << "\n";\
+    LOG_D("  {}", extension);\
 }\
-aout << std::endl;\
 }
 
 //! Color for cornflower blue. Can be sent directly to glClearColor
@@ -66,6 +67,63 @@ void main() {
 }
 )fragment";
 
+// Vertex-Shader des SpriteBatch, die Locations entsprechen SpriteBatch::k*Location
+static const char *spriteVertex = R"vertex(#version 300 es
+layout(location = 0) in vec2 inPosition;
+layout(location = 1) in vec2 inUV;
+layout(location = 2) in vec4 inColor;
+
+out vec2 fragUV;
+out vec4 fragColor;
+
+uniform mat4 uProjection;
+
+void main() {
+    fragUV = inUV;
+    fragColor = inColor;
+    gl_Position = uProjection * vec4(inPosition, 0.0, 1.0);
+}
+)vertex";
+
+static const char *spriteFragment = R"fragment(#version 300 es
+precision mediump float;
+
+in vec2 fragUV;
+in vec4 fragColor;
+
+uniform sampler2D uTexture;
+
+out vec4 outColor;
+
+void main() {
+    outColor = texture(uTexture, fragUV) * fragColor;
+}
+)fragment";
+
+// Zeichenebenen des SpriteBatch, von hinten nach vorne
+enum SpriteLayer : uint8_t {
+    LAYER_BACKGROUND,
+    LAYER_DECORATION,
+    LAYER_TARGET,
+    LAYER_BOX,
+    LAYER_PARTICLE,
+    LAYER_OVERLAY
+};
+
+// Spielfeldzellen in Weltkoordinaten: die Felder 0..FIELD_WIDTH füllen die Höhe der Projektion
+static constexpr float kCellSize = 4.f / (Simulation::FIELD_WIDTH + 1);
+
+static inline float cellToWorld(float cell) {
+    return (cell - Simulation::FIELD_WIDTH * 0.5f) * kCellSize;
+}
+
+static inline void setRegion(Sprite& sprite, const TextureRegion& region) {
+    sprite.u0 = region.u0;
+    sprite.v0 = region.v0;
+    sprite.u1 = region.u1;
+    sprite.v1 = region.v1;
+}
+
 /*!
  * Half the height of the projection matrix. This gives you a renderable area of height 4 ranging
  * from -2 to 2
@@ -147,6 +205,159 @@ void Renderer::render() {
     assert(swapResult == EGL_TRUE);
 }
 
+void Renderer::beginFrame() {
+    updateRenderArea();
+
+    spriteShader_->activate();
+    if (shaderNeedsNewProjectionMatrix_) {
+        float projectionMatrix[16] = {0};
+        Utility::buildOrthographicMatrix(
+                projectionMatrix,
+                kProjectionHalfHeight,
+                float(width_) / height_,
+                kProjectionNearPlane,
+                kProjectionFarPlane);
+        spriteShader_->setProjectionMatrix(projectionMatrix);
+        shaderNeedsNewProjectionMatrix_ = false;
+    }
+
+    glClear(GL_COLOR_BUFFER_BIT);
+    spriteBatch_->begin();
+}
+
+void Renderer::endFrame() {
+    spriteBatch_->end();
+
+    auto swapResult = eglSwapBuffers(display_, surface_);
+    assert(swapResult == EGL_TRUE);
+}
+
+void Renderer::renderBackground(const Theme& theme) {
+    // Beim ersten Frame eines Themes wird dessen Atlas gebaut, danach nur noch umgeschaltet
+    textureCache_->useTheme(theme);
+    currentTheme_ = &theme;
+
+    TextureRegion region = textureCache_->region(theme.backgroundTexture);
+    Sprite sprite;
+    sprite.x = 0.f;
+    sprite.y = 0.f;
+    sprite.height = 2.f * kProjectionHalfHeight;
+    sprite.width = sprite.height * float(width_) / height_;
+    setRegion(sprite, region);
+    if (region.texture) {
+        spriteBatch_->draw({region.texture, BlendMode::ALPHA, LAYER_BACKGROUND}, sprite);
+    }
+}
+
+AssetHandle Renderer::preloadTheme(const Theme& theme) {
+    return textureCache_->preloadTheme(theme);
+}
+
+void Renderer::renderBox(const GameObject& box) {
+    if (currentTheme_) {
+        renderGameObject(box, currentTheme_->boxTexture, LAYER_BOX);
+    }
+}
+
+void Renderer::renderTarget(const GameObject& target) {
+    if (currentTheme_) {
+        renderGameObject(target, currentTheme_->targetTexture, LAYER_TARGET);
+    }
+}
+
+void Renderer::renderDecoration(const GameObject& decoration) {
+    if (!currentTheme_ || currentTheme_->decorativeElements.empty()) {
+        return;
+    }
+    // Dekorationen haben keine eigene Textur, die Position wählt stabil eine aus dem Theme
+    const auto& elements = currentTheme_->decorativeElements;
+    auto cell = static_cast<size_t>(decoration.position.x * (Simulation::FIELD_WIDTH + 1) + decoration.position.y);
+    renderGameObject(decoration, elements[cell % elements.size()], LAYER_DECORATION);
+}
+
+void Renderer::renderParticles(const ParticleBuffer& particles, StringId texture) {
+    if (particles.empty()) {
+        return;
+    }
+
+    // Additiv geblendet, damit sich überlappende Partikel aufhellen statt sich zu verdecken
+    TextureRegion region = textureCache_->region(texture);
+    if (!region.texture) {
+        return;
+    }
+    SpriteState state{region.texture, BlendMode::ADDITIVE, LAYER_PARTICLE};
+    const float* positionX = particles.positionX();
+    const float* positionY = particles.positionY();
+    const float* rotation = particles.rotation();
+    const float* scale = particles.scale();
+    const float* alpha = particles.alpha();
+    const float* colorR = particles.colorR();
+    const float* colorG = particles.colorG();
+    const float* colorB = particles.colorB();
+    for (size_t i = 0; i < particles.size(); i++) {
+        Sprite sprite;
+        sprite.x = cellToWorld(positionX[i]);
+        sprite.y = cellToWorld(positionY[i]);
+        sprite.width = sprite.height = scale[i] * kCellSize;
+        sprite.rotation = rotation[i];
+        setRegion(sprite, region);
+        sprite.color = SpriteBatch::packColor(
+                colorR[i], colorG[i], colorB[i], alpha[i]);
+        spriteBatch_->draw(state, sprite);
+    }
+}
+
+void Renderer::renderFrameHistogram(const FrameHistogram& histogram) {
+    if (!overlayTexture_ || histogram.getMaxBucket() == 0) {
+        return;
+    }
+
+    // Unten links, ein Viertel der Höhe
+    const float halfWidth = kProjectionHalfHeight * float(width_) / height_;
+    const float barWidth = 0.03f;
+    const float maxHeight = kProjectionHalfHeight * 0.5f;
+    const float left = -halfWidth + 0.1f;
+    const float bottom = -kProjectionHalfHeight + 0.1f;
+
+    SpriteState state{overlayTexture_->getTextureID(), BlendMode::ALPHA, LAYER_OVERLAY};
+    for (int i = 0; i < FrameHistogram::kBucketCount; i++) {
+        uint32_t count = histogram.getBucket(i);
+        if (count == 0) {
+            continue;
+        }
+        Sprite bar;
+        bar.width = barWidth * 0.8f;
+        bar.height = maxHeight * static_cast<float>(count) / histogram.getMaxBucket();
+        bar.x = left + barWidth * (static_cast<float>(i) + 0.5f);
+        bar.y = bottom + bar.height * 0.5f;
+        if (i < 17) {
+            bar.color = SpriteBatch::packColor(0.2f, 0.9f, 0.2f, 0.8f);
+        } else if (i < 34) {
+            bar.color = SpriteBatch::packColor(0.95f, 0.85f, 0.1f, 0.8f);
+        } else {
+            bar.color = SpriteBatch::packColor(0.95f, 0.2f, 0.2f, 0.8f);
+        }
+        spriteBatch_->draw(state, bar);
+    }
+}
+
+void Renderer::renderGameObject(const GameObject& object, StringId texture, uint8_t layer) {
+    TextureRegion region = textureCache_->region(texture);
+    if (!region.texture) {
+        return;
+    }
+    Sprite sprite;
+    // Höhe (z, z.B. beim Sprung) hebt das Objekt auf dem Bildschirm an
+    sprite.x = cellToWorld(object.position.x);
+    sprite.y = cellToWorld(object.position.y) + object.position.z * kCellSize;
+    sprite.width = object.width * object.scale * kCellSize;
+    sprite.height = object.height * object.scale * kCellSize;
+    sprite.rotation = object.rotation;
+    sprite.color = SpriteBatch::packColor(1.f, 1.f, 1.f, object.alpha);
+    setRegion(sprite, region);
+    spriteBatch_->draw({region.texture, BlendMode::ALPHA, layer}, sprite);
+}
+
 void Renderer::initRenderer() {
     // Choose your render attributes
     constexpr EGLint attribs[] = {
@@ -184,15 +395,14 @@ void Renderer::initRenderer() {
                     && eglGetConfigAttrib(display, config, EGL_BLUE_SIZE, &blue)
                     && eglGetConfigAttrib(display, config, EGL_DEPTH_SIZE, &depth)) {
 
-                    aout << "Found config with " << red << ", " << green << ", " << blue << ", "
-                         << depth << std::endl;
+                    LOG_D("Found config with {}, {}, {}, {}", red, green, blue, depth);
                     return red == 8 && green == 8 && blue == 8 && depth == 24;
                 }
                 return false;
             });
 
-    aout << "Found " << numConfigs << " configs" << std::endl;
-    aout << "Chose " << config << std::endl;
+    LOG_I("Found {} configs", numConfigs);
+    LOG_I("Chose {}", config);
 
     // create the proper window surface
     EGLint format;
@@ -228,6 +438,17 @@ void Renderer::initRenderer() {
     // you'll want to track the active shader and activate/deactivate it as necessary
     shader_->activate();
 
+    spriteShader_ = std::unique_ptr<Shader>(
+            Shader::loadShader(spriteVertex, spriteFragment, "inPosition", "inUV", "uProjection"));
+    assert(spriteShader_);
+    spriteBatch_ = std::make_unique<SpriteBatch>(glBackend_);
+
+    GLint maxTextureSize = 2048;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+    textureCache_ = std::make_unique<TextureCache>(
+            app_->activity->assetManager, assetLoader_, maxTextureSize);
+    overlayTexture_ = TextureAsset::createFromImage(Image{1, 1, {255, 255, 255, 255}});
+
     // setup any other gl related global states
     glClearColor(CORNFLOWER_BLUE);
 
@@ -278,12 +499,9 @@ void Renderer::createModels() {
             0, 1, 2, 0, 2, 3
     };
 
-    // loads an image and assigns it to the square.
-    //
-    // Note: there is no texture management in this sample, so if you reuse an image be careful not
-    // to load it repeatedly. Since you get a shared_ptr you can safely reuse it in many models.
-    auto assetManager = app_->activity->assetManager;
-    auto spAndroidRobotTexture = TextureAsset::loadAsset(assetManager, "android_robot.png");
+    // loads an image through the texture cache and assigns it to the square. Repeated requests for
+    // the same name return the same texture.
+    auto spAndroidRobotTexture = textureCache_->get(intern("android_robot.png"));
 
     // Create a model and put it in the back of the render list.
     models_.emplace_back(vertices, indices, spAndroidRobotTexture);
@@ -305,7 +523,6 @@ void Renderer::handleInput() {
         // Find the pointer index, mask and bitshift to turn it into a readable value.
         auto pointerIndex = (action & AMOTION_EVENT_ACTION_POINTER_INDEX_MASK)
                 >> AMOTION_EVENT_ACTION_POINTER_INDEX_SHIFT;
-        aout << "Pointer(s): ";
 
         // get the x and y position of this event if it is not ACTION_MOVE.
         auto &pointer = motionEvent.pointers[pointerIndex];
@@ -316,8 +533,7 @@ void Renderer::handleInput() {
         switch (action & AMOTION_EVENT_ACTION_MASK) {
             case AMOTION_EVENT_ACTION_DOWN:
             case AMOTION_EVENT_ACTION_POINTER_DOWN:
-                aout << "(" << pointer.id << ", " << x << ", " << y << ") "
-                     << "Pointer Down";
+                LOG_V("Pointer(s): ({}, {}, {}) Pointer Down", pointer.id, x, y);
                 break;
 
             case AMOTION_EVENT_ACTION_CANCEL:
@@ -326,8 +542,7 @@ void Renderer::handleInput() {
                 // code pass through on purpose.
             case AMOTION_EVENT_ACTION_UP:
             case AMOTION_EVENT_ACTION_POINTER_UP:
-                aout << "(" << pointer.id << ", " << x << ", " << y << ") "
-                     << "Pointer Up";
+                LOG_V("Pointer(s): ({}, {}, {}) Pointer Up", pointer.id, x, y);
                 break;
 
             case AMOTION_EVENT_ACTION_MOVE:
@@ -338,17 +553,12 @@ void Renderer::handleInput() {
                     pointer = motionEvent.pointers[index];
                     x = GameActivityPointerAxes_getX(&pointer);
                     y = GameActivityPointerAxes_getY(&pointer);
-                    aout << "(" << pointer.id << ", " << x << ", " << y << ")";
-
-                    if (index != (motionEvent.pointerCount - 1)) aout << ",";
-                    aout << " ";
+                    LOG_V("Pointer(s): ({}, {}, {}) Pointer Move", pointer.id, x, y);
                 }
-                aout << "Pointer Move";
                 break;
             default:
-                aout << "Unknown MotionEvent Action: " << action;
+                LOG_V("Unknown MotionEvent Action: {}", action);
         }
-        aout << std::endl;
     }
     // clear the motion input count in this buffer for main thread to re-use.
     android_app_clear_motion_events(inputBuffer);
@@ -356,22 +566,20 @@ void Renderer::handleInput() {
     // handle input key events.
     for (auto i = 0; i < inputBuffer->keyEventsCount; i++) {
         auto &keyEvent = inputBuffer->keyEvents[i];
-        aout << "Key: " << keyEvent.keyCode <<" ";
         switch (keyEvent.action) {
             case AKEY_EVENT_ACTION_DOWN:
-                aout << "Key Down";
+                LOG_V("Key: {} Key Down", keyEvent.keyCode);
                 break;
             case AKEY_EVENT_ACTION_UP:
-                aout << "Key Up";
+                LOG_V("Key: {} Key Up", keyEvent.keyCode);
                 break;
             case AKEY_EVENT_ACTION_MULTIPLE:
                 // Deprecated since Android API level 29.
-                aout << "Multiple Key Actions";
+                LOG_V("Key: {} Multiple Key Actions", keyEvent.keyCode);
                 break;
             default:
-                aout << "Unknown KeyEvent Action: " << keyEvent.action;
+                LOG_V("Key: {} Unknown KeyEvent Action: {}", keyEvent.keyCode, keyEvent.action);
         }
-        aout << std::endl;
     }
     // clear the key input count too.
     android_app_clear_key_events(inputBuffer);
@@ -5,10 +5,17 @@
 #include <GLES3/gl3.h>
 #include <android/asset_manager.h>
 #include <memory>
+#include <string>
 
+#include "AssetLoader.h"
+#include "GLES3Backend.h"
 #include "Model.h"
+#include "ParticleBuffer.h"
+#include "Profiler.h"
 #include "Shader.h"
+#include "SpriteBatch.h"
 #include "TextureAsset.h"
+#include "TextureCache.h"
 
 struct android_app;
 
@@ -16,9 +23,11 @@ class Renderer {
 public:
     /*!
      * @param pApp the android_app this Renderer belongs to, needed to configure GL
+     * @param assetLoader loader for textures, its uploads must be pumped on this thread
      */
-    inline Renderer(android_app *pApp) :
+    inline Renderer(android_app *pApp, AssetLoader &assetLoader) :
             app_(pApp),
+            assetLoader_(assetLoader),
             display_(EGL_NO_DISPLAY),
             surface_(EGL_NO_SURFACE),
             context_(EGL_NO_CONTEXT),
@@ -47,6 +56,33 @@ public:
     void render(GameModel& model);
     void handleTouch(float x, float y);
 
+    /*!
+     * Beginnt einen Frame. Alle folgenden render*-Aufrufe werden im SpriteBatch gesammelt und erst
+     * in endFrame gezeichnet, sortiert nach Ebene und Textur.
+     */
+    void beginFrame();
+    void endFrame();
+
+    /*!
+     * Zeichnet den Hintergrund und merkt sich das Theme für die Texturen der Spielobjekte.
+     */
+    void renderBackground(const Theme& theme);
+    void renderBox(const GameObject& box);
+    void renderTarget(const GameObject& target);
+    void renderDecoration(const GameObject& decoration);
+    void renderParticles(const ParticleBuffer& particles, StringId texture);
+
+    /*!
+     * Zeichnet die Verteilung der Framezeiten als Balken über allen anderen Sprites unten links,
+     * ein Balken pro Millisekunde. Grün bis 60 fps, gelb bis 30 fps, darüber rot.
+     */
+    void renderFrameHistogram(const FrameHistogram& histogram);
+
+    /*!
+     * Baut den Atlas eines Themes im Hintergrund, z.B. für das nächste Level.
+     */
+    AssetHandle preloadTheme(const Theme& theme);
+
 private:
     /*!
      * Performs necessary OpenGL initialization. Customize this if you want to change your EGL
@@ -66,12 +102,12 @@ private:
      */
     void createModels();
 
-    void renderBox(const GameObject& box);
-    void renderTarget(const GameObject& target);
     void renderUI();
-    void renderParticle(const Particle& particle, const std::string& textureName);
+
+    void renderGameObject(const GameObject& object, StringId texture, uint8_t layer);
 
     android_app *app_;
+    AssetLoader &assetLoader_;
     EGLDisplay display_;
     EGLSurface surface_;
     EGLContext context_;
@@ -90,6 +126,13 @@ private:
 
     std::unique_ptr<Shader> shader_;
     std::vector<Model> models_;
+
+    std::unique_ptr<Shader> spriteShader_;
+    GLES3Backend glBackend_;
+    std::unique_ptr<SpriteBatch> spriteBatch_;
+    std::unique_ptr<TextureCache> textureCache_;
+    const Theme* currentTheme_ = nullptr;
+    std::shared_ptr<TextureAsset> overlayTexture_;  // Ein weißes Pixel für einfarbige Flächen
 };
 
 #endif //ANDROIDGLINVESTIGATIONS_RENDERER_H
\ No newline at end of file
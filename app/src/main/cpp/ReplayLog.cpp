@@ -0,0 +1,448 @@
+#include "ReplayLog.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+    constexpr char kReplayMagic[4] = {'C', 'R', 'P', 'L'};
+    constexpr uint16_t kReplayVersion = 1;
+
+    // Obergrenzen gegen unsinnige Werte aus beschädigten Dateien
+    constexpr uint32_t kMaxEvents = 1 << 24;
+    constexpr int kMaxStepsPerSecond = 10000;
+
+    struct ReplayHeader {
+        char magic[4];
+        uint16_t version;
+        uint16_t headerSize;
+        uint32_t stepsPerSecond;
+        uint32_t eventCount;
+        uint32_t bodySize;
+        uint32_t reserved;
+    };
+
+    static_assert(sizeof(ReplayHeader) == 24, "ReplayHeader layout");
+
+    bool fail(std::string* error, const std::string& message) {
+        if (error) {
+            *error = message;
+        }
+        return false;
+    }
+
+    bool writeAll(int fd, const void* data, size_t size) {
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        while (size > 0) {
+            ssize_t written = ::write(fd, bytes, size);
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            bytes += written;
+            size -= static_cast<size_t>(written);
+        }
+        return true;
+    }
+
+    class VarintReader {
+    public:
+        VarintReader(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+        bool getByte(uint8_t& outValue) {
+            if (offset_ == size_) {
+                return false;
+            }
+            outValue = data_[offset_++];
+            return true;
+        }
+
+        bool getVarint(uint64_t& outValue) {
+            outValue = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                uint8_t byte = 0;
+                if (!getByte(byte)) {
+                    return false;
+                }
+                outValue |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0) {
+                    return true;
+                }
+            }
+            return false;  // Mehr als 10 Byte
+        }
+
+        bool getInt(int& outValue) {
+            uint64_t value = 0;
+            if (!getVarint(value) || value > UINT32_MAX) {
+                return false;
+            }
+            outValue = static_cast<int>(static_cast<uint32_t>(value));
+            return true;
+        }
+
+        bool getFixed64(uint64_t& outValue) {
+            if (size_ - offset_ < sizeof(outValue)) {
+                return false;
+            }
+            outValue = 0;
+            for (int i = 7; i >= 0; i--) {
+                outValue = (outValue << 8) | data_[offset_ + i];
+            }
+            offset_ += sizeof(outValue);
+            return true;
+        }
+
+        bool atEnd() const { return offset_ == size_; }
+
+    private:
+        const uint8_t* data_;
+        size_t size_;
+        size_t offset_ = 0;
+    };
+
+    // Nur Schleifen und Funktionen tragen einen Parameter, alle anderen Befehle ein Byte
+    bool hasLoopCount(CommandType type) {
+        return type == CommandType::LOOP_START;
+    }
+
+    bool hasFunctionId(CommandType type) {
+        return type == CommandType::FUNCTION_DEF || type == CommandType::FUNCTION_CALL;
+    }
+}
+
+void ReplayRecorder::begin(int stepsPerSecond) {
+    body_.clear();
+    stepsPerSecond_ = stepsPerSecond;
+    eventCount_ = 0;
+    lastTick_ = 0;
+}
+
+void ReplayRecorder::levelStarted(uint64_t tick, int levelNumber, uint64_t seed) {
+    event(ReplayEventType::LEVEL_START, tick);
+    putVarint(static_cast<uint32_t>(levelNumber));
+    putVarint(seed);
+}
+
+void ReplayRecorder::commandAdded(uint64_t tick, const Command& command) {
+    event(ReplayEventType::COMMAND_ADDED, tick);
+    putVarint(static_cast<uint8_t>(command.type));
+    if (hasLoopCount(command.type)) {
+        putVarint(static_cast<uint32_t>(command.loopCount));
+    } else if (hasFunctionId(command.type)) {
+        putVarint(static_cast<uint32_t>(command.functionId));
+    }
+}
+
+void ReplayRecorder::programCleared(uint64_t tick) {
+    event(ReplayEventType::PROGRAM_CLEARED, tick);
+}
+
+void ReplayRecorder::executionStarted(uint64_t tick, bool parallel) {
+    event(parallel ? ReplayEventType::EXECUTION_START_PARALLEL : ReplayEventType::EXECUTION_START,
+          tick);
+}
+
+void ReplayRecorder::executionStopped(uint64_t tick, int actionsExecuted) {
+    event(ReplayEventType::EXECUTION_STOP, tick);
+    putVarint(static_cast<uint32_t>(actionsExecuted));
+}
+
+void ReplayRecorder::levelReset(uint64_t tick) {
+    event(ReplayEventType::LEVEL_RESET, tick);
+}
+
+void ReplayRecorder::levelCompleted(uint64_t tick, int actionsExecuted, uint64_t stateHash) {
+    event(ReplayEventType::LEVEL_COMPLETE, tick);
+    putVarint(static_cast<uint32_t>(actionsExecuted));
+    for (int i = 0; i < 8; i++) {
+        body_.push_back(static_cast<uint8_t>(stateHash >> (8 * i)));
+    }
+}
+
+void ReplayRecorder::event(ReplayEventType type, uint64_t tick) {
+    // Schritte laufen nie rückwärts, ein älterer Schritt zählt als gleichzeitig
+    uint64_t delta = tick > lastTick_ ? tick - lastTick_ : 0;
+    lastTick_ += delta;
+    body_.push_back(static_cast<uint8_t>(type));
+    putVarint(delta);
+    eventCount_++;
+}
+
+void ReplayRecorder::putVarint(uint64_t value) {
+    while (value >= 0x80) {
+        body_.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    body_.push_back(static_cast<uint8_t>(value));
+}
+
+std::vector<uint8_t> ReplayRecorder::serialize() const {
+    ReplayHeader header{};
+    std::memcpy(header.magic, kReplayMagic, sizeof(kReplayMagic));
+    header.version = kReplayVersion;
+    header.headerSize = sizeof(ReplayHeader);
+    header.stepsPerSecond = static_cast<uint32_t>(stepsPerSecond_);
+    header.eventCount = eventCount_;
+    header.bodySize = static_cast<uint32_t>(body_.size());
+
+    std::vector<uint8_t> data(sizeof(header) + body_.size());
+    std::memcpy(data.data(), &header, sizeof(header));
+    if (!body_.empty()) {
+        std::memcpy(data.data() + sizeof(header), body_.data(), body_.size());
+    }
+    return data;
+}
+
+bool ReplayRecorder::save(const std::string& path, std::string* error) const {
+    std::vector<uint8_t> data = serialize();
+
+    std::string tempPath = path + ".tmp";
+    int fd = ::open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        return fail(error, "replay can't be written: " + std::string(std::strerror(errno)));
+    }
+    bool written = writeAll(fd, data.data(), data.size()) && fsync(fd) == 0;
+    ::close(fd);
+    if (!written || rename(tempPath.c_str(), path.c_str()) != 0) {
+        unlink(tempPath.c_str());
+        return fail(error, "replay can't be written");
+    }
+    return true;
+}
+
+bool parseReplay(const uint8_t* data, size_t size, Replay& outReplay, std::string* error) {
+    outReplay = Replay{};
+
+    ReplayHeader header{};
+    if (size < sizeof(header)) {
+        return fail(error, "replay too small");
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, kReplayMagic, sizeof(kReplayMagic)) != 0) {
+        return fail(error, "not a replay");
+    }
+    if (header.version != kReplayVersion || header.headerSize != sizeof(ReplayHeader)) {
+        return fail(error, "unsupported replay version");
+    }
+    if (header.bodySize != size - sizeof(header)) {
+        return fail(error, "replay is truncated");
+    }
+    if (header.stepsPerSecond == 0 || header.stepsPerSecond > kMaxStepsPerSecond ||
+        header.eventCount > kMaxEvents || header.eventCount > header.bodySize) {
+        return fail(error, "replay header is damaged");
+    }
+
+    outReplay.stepsPerSecond = static_cast<int>(header.stepsPerSecond);
+    outReplay.events.reserve(header.eventCount);
+
+    VarintReader reader(data + sizeof(header), header.bodySize);
+    uint64_t tick = 0;
+    for (uint32_t i = 0; i < header.eventCount; i++) {
+        uint8_t type = 0;
+        uint64_t delta = 0;
+        if (!reader.getByte(type) || !reader.getVarint(delta)) {
+            return fail(error, "replay event " + std::to_string(i) + " is truncated");
+        }
+        tick += delta;
+
+        ReplayEvent event{static_cast<ReplayEventType>(type)};
+        event.tick = tick;
+        bool valid = true;
+        switch (event.type) {
+            case ReplayEventType::LEVEL_START:
+                valid = reader.getInt(event.levelNumber) && reader.getVarint(event.seed);
+                break;
+            case ReplayEventType::COMMAND_ADDED: {
+                uint64_t command = 0;
+                valid = reader.getVarint(command) &&
+                        command <= static_cast<uint64_t>(CommandType::ACTIVATE_SWITCH);
+                if (valid) {
+                    event.command.type = static_cast<CommandType>(command);
+                    if (hasLoopCount(event.command.type)) {
+                        valid = reader.getInt(event.command.loopCount);
+                    } else if (hasFunctionId(event.command.type)) {
+                        valid = reader.getInt(event.command.functionId);
+                    }
+                }
+                break;
+            }
+            case ReplayEventType::PROGRAM_CLEARED:
+            case ReplayEventType::EXECUTION_START:
+            case ReplayEventType::EXECUTION_START_PARALLEL:
+            case ReplayEventType::LEVEL_RESET:
+                break;
+            case ReplayEventType::EXECUTION_STOP:
+                valid = reader.getInt(event.actionsExecuted);
+                break;
+            case ReplayEventType::LEVEL_COMPLETE:
+                valid = reader.getInt(event.actionsExecuted) && reader.getFixed64(event.stateHash);
+                break;
+            default:
+                return fail(error, "replay event " + std::to_string(i) + " has unknown type " +
+                                   std::to_string(type));
+        }
+        if (!valid) {
+            return fail(error, "replay event " + std::to_string(i) + " is damaged");
+        }
+        outReplay.events.push_back(event);
+    }
+
+    if (!reader.atEnd()) {
+        return fail(error, "replay has trailing data");
+    }
+    return true;
+}
+
+bool loadReplay(const std::string& path, Replay& outReplay, std::string* error) {
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        return fail(error, "replay can't be opened: " + std::string(std::strerror(errno)));
+    }
+    std::vector<uint8_t> data;
+    uint8_t buffer[4096];
+    size_t count;
+    while ((count = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        data.insert(data.end(), buffer, buffer + count);
+    }
+    bool readError = std::ferror(file) != 0;
+    std::fclose(file);
+    if (readError) {
+        return fail(error, "replay can't be read");
+    }
+    return parseReplay(data.data(), data.size(), outReplay, error);
+}
+
+ReplayResult ReplayPlayer::play(const Replay& replay) {
+    ReplayResult result;
+    levelLoaded_ = false;
+    running_ = false;
+    actionsExecuted_ = 0;
+    program_.clear();
+
+    for (const auto& event : replay.events) {
+        result.lastTick = event.tick;
+        if (!apply(event, result)) {
+            break;
+        }
+    }
+    result.finalStateHash = levelLoaded_ ? simulation_.stateHash() : 0;
+    return result;
+}
+
+bool ReplayPlayer::apply(const ReplayEvent& event, ReplayResult& result) {
+    if (!levelLoaded_ && event.type != ReplayEventType::LEVEL_START &&
+        event.type != ReplayEventType::COMMAND_ADDED &&
+        event.type != ReplayEventType::PROGRAM_CLEARED) {
+        return diverge(result, event, "event before the first level start");
+    }
+
+    switch (event.type) {
+        case ReplayEventType::LEVEL_START:
+            // Gleicher Startwert ergibt dasselbe Level wie auf dem Gerät
+            level_ = levelSource_.createLevel(event.levelNumber, event.seed);
+            if (level_.boxes.empty()) {
+                return diverge(result, event, "unknown level " + std::to_string(event.levelNumber));
+            }
+            simulation_.loadLevel(level_);
+            levelNumber_ = event.levelNumber;
+            levelLoaded_ = true;
+            running_ = false;
+            return true;
+
+        case ReplayEventType::COMMAND_ADDED:
+            program_.push_back(event.command);
+            return true;
+
+        case ReplayEventType::PROGRAM_CLEARED:
+            program_.clear();
+            return true;
+
+        case ReplayEventType::EXECUTION_START:
+        case ReplayEventType::EXECUTION_START_PARALLEL: {
+            simulation_.loadLevel(level_);
+            bool loaded = event.type == ReplayEventType::EXECUTION_START
+                          ? simulation_.loadProgram(program_)
+                          : simulation_.loadParallelPrograms({program_});
+            if (!loaded) {
+                return diverge(result, event, "program rejected: " + simulation_.getProgram().error);
+            }
+            running_ = true;
+            actionsExecuted_ = 0;
+            return true;
+        }
+
+        case ReplayEventType::EXECUTION_STOP:
+            if (!advanceTo(event.actionsExecuted, result, event)) {
+                return false;
+            }
+            simulation_.stopProgram();
+            running_ = false;
+            return true;
+
+        case ReplayEventType::LEVEL_RESET:
+            simulation_.stopProgram();
+            simulation_.loadLevel(level_);
+            running_ = false;
+            return true;
+
+        case ReplayEventType::LEVEL_COMPLETE: {
+            if (!advanceTo(event.actionsExecuted, result, event)) {
+                return false;
+            }
+            ReplayCompletion completion{};
+            completion.levelNumber = levelNumber_;
+            completion.tick = event.tick;
+            completion.actionsExecuted = event.actionsExecuted;
+            completion.solved = simulation_.checkWinCondition();
+            completion.hashMatches = simulation_.stateHash() == event.stateHash;
+            result.completions.push_back(completion);
+            running_ = false;
+
+            if (!completion.solved) {
+                return diverge(result, event, "level not solved after " +
+                                              std::to_string(event.actionsExecuted) + " actions");
+            }
+            if (!completion.hashMatches) {
+                return diverge(result, event, "state differs from the recording");
+            }
+            return true;
+        }
+    }
+    return diverge(result, event, "unknown event");
+}
+
+bool ReplayPlayer::advanceTo(int actionsExecuted, ReplayResult& result, const ReplayEvent& event) {
+    if (!running_) {
+        return diverge(result, event, "no program running");
+    }
+    if (actionsExecuted < actionsExecuted_) {
+        return diverge(result, event, "recorded " + std::to_string(actionsExecuted) +
+                                      " actions, already executed " +
+                                      std::to_string(actionsExecuted_));
+    }
+    // Im Parallelbetrieb zählt ein Takt mehrere Aktionen, gestoppt wird nur zwischen Takten
+    while (actionsExecuted_ < actionsExecuted) {
+        int actions = simulation_.stepRound();
+        if (actions == 0) {
+            return diverge(result, event, "program ended after " + std::to_string(actionsExecuted_) +
+                                          " actions, recorded " + std::to_string(actionsExecuted));
+        }
+        actionsExecuted_ += actions;
+        result.actionsSimulated += static_cast<uint64_t>(actions);
+    }
+    if (actionsExecuted_ != actionsExecuted) {
+        return diverge(result, event, "recorded " + std::to_string(actionsExecuted) +
+                                      " actions, a round ended at " + std::to_string(actionsExecuted_));
+    }
+    return true;
+}
+
+bool ReplayPlayer::diverge(ReplayResult& result, const ReplayEvent& event, const std::string& message) {
+    result.consistent = false;
+    result.divergence = "tick " + std::to_string(event.tick) + ": " + message;
+    return false;
+}
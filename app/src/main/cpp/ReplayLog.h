@@ -0,0 +1,147 @@
+#ifndef CODINI_REPLAY_LOG_H
+#define CODINI_REPLAY_LOG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Command.h"
+#include "Model.h"
+#include "Simulation.h"
+
+/*!
+ * Aufzeichnung einer Spielsitzung als kompaktes Ereignislog.
+ *
+ * Aufgezeichnet werden nur Eingaben, nicht der Spielzustand: Levelstart mit Zufallsstartwert,
+ * hinzugefügte Befehle, Programmstart und -stopp, Zurücksetzen und der Levelabschluss. Jedes
+ * Ereignis trägt den Simulationsschritt (FixedTimestep::getStepCount), zu dem es eintrat.
+ * Stopp und Abschluss halten zusätzlich fest, wie viele Aktionen bis dahin ausgeführt waren,
+ * der Abschluss auch den stateHash der Simulation. Damit lässt sich eine Sitzung ohne
+ * Animationen und Bildrate nachrechnen und prüfen (ReplayPlayer).
+ *
+ * Dateiformat: 24 Byte Header (Magic "CRPL", Version, Headergröße, Simulationsrate, Anzahl
+ * Ereignisse, Rumpfgröße), danach die Ereignisse: ein Byte Typ, der Abstand zum vorigen Schritt
+ * und die Parameter als LEB128-Varints, nur der stateHash steht mit festen 8 Byte. Eine typische
+ * Sitzung braucht 3 bis 5 Byte pro Ereignis.
+ */
+enum class ReplayEventType : uint8_t {
+    LEVEL_START = 1,     // levelNumber, seed
+    COMMAND_ADDED,       // command
+    PROGRAM_CLEARED,
+    EXECUTION_START,
+    EXECUTION_STOP,      // actionsExecuted
+    LEVEL_RESET,
+    LEVEL_COMPLETE,      // actionsExecuted, stateHash
+    EXECUTION_START_PARALLEL  // Wie EXECUTION_START, alle Boxen führen das Programm gleichzeitig aus
+};
+
+struct ReplayEvent {
+    ReplayEventType type;
+    uint64_t tick = 0;          // Simulationsschritt seit Sitzungsbeginn
+    int levelNumber = 0;
+    uint64_t seed = 0;
+    Command command{};
+    int actionsExecuted = 0;
+    uint64_t stateHash = 0;
+};
+
+struct Replay {
+    int stepsPerSecond = 0;
+    std::vector<ReplayEvent> events;
+};
+
+/*!
+ * Schreibt Ereignisse direkt in den kodierten Puffer, ohne Allokation pro Ereignis (nach dem
+ * Aufwärmen). Die Schritte müssen aufsteigend sein.
+ */
+class ReplayRecorder {
+public:
+    /*!
+     * Beginnt eine neue Aufzeichnung, bisherige Ereignisse werden verworfen.
+     */
+    void begin(int stepsPerSecond);
+
+    void levelStarted(uint64_t tick, int levelNumber, uint64_t seed);
+    void commandAdded(uint64_t tick, const Command& command);
+    void programCleared(uint64_t tick);
+    void executionStarted(uint64_t tick, bool parallel = false);
+    void executionStopped(uint64_t tick, int actionsExecuted);
+    void levelReset(uint64_t tick);
+    void levelCompleted(uint64_t tick, int actionsExecuted, uint64_t stateHash);
+
+    size_t getEventCount() const { return eventCount_; }
+
+    /*!
+     * @return die komplette Datei (Header und Ereignisse)
+     */
+    std::vector<uint8_t> serialize() const;
+
+    /*!
+     * Schreibt die Aufzeichnung über eine temporäre Datei, eine alte Datei bleibt bis zum
+     * rename erhalten.
+     */
+    bool save(const std::string& path, std::string* error = nullptr) const;
+
+private:
+    void event(ReplayEventType type, uint64_t tick);
+    void putVarint(uint64_t value);
+
+    std::vector<uint8_t> body_;
+    int stepsPerSecond_ = 0;
+    uint32_t eventCount_ = 0;
+    uint64_t lastTick_ = 0;
+};
+
+/*!
+ * Dekodiert eine Aufzeichnung und prüft dabei Header, Längen und Ereignistypen.
+ * @return false mit Grund in error, wenn die Daten beschädigt sind
+ */
+bool parseReplay(const uint8_t* data, size_t size, Replay& outReplay, std::string* error = nullptr);
+
+bool loadReplay(const std::string& path, Replay& outReplay, std::string* error = nullptr);
+
+// Ergebnis eines aufgezeichneten Levelabschlusses beim Nachrechnen
+struct ReplayCompletion {
+    int levelNumber;
+    uint64_t tick;
+    int actionsExecuted;
+    bool solved;           // Die Simulation hat das Level nach actionsExecuted Aktionen gelöst
+    bool hashMatches;      // Und der Zustand stimmt mit der Aufzeichnung überein
+};
+
+struct ReplayResult {
+    bool consistent = true;         // Keine Abweichung von der Aufzeichnung
+    std::string divergence;         // Erste Abweichung, mit Schritt
+    std::vector<ReplayCompletion> completions;
+    uint64_t actionsSimulated = 0;
+    uint64_t finalStateHash = 0;
+    uint64_t lastTick = 0;
+};
+
+/*!
+ * Rechnet eine Aufzeichnung ohne Grafik und ohne Wartezeiten nach: dieselben Level (über
+ * GameModel::createLevel mit dem aufgezeichneten Startwert), dieselben Programme und dieselbe
+ * Anzahl Aktionen bis zu jedem Stopp. Jede Abweichung (abgelehntes Programm, Programm endet
+ * früher, anderer Endzustand) wird gemeldet; für Fehlersuche, Schummelprüfung und Benchmarks.
+ */
+class ReplayPlayer {
+public:
+    ReplayResult play(const Replay& replay);
+
+private:
+    bool apply(const ReplayEvent& event, ReplayResult& result);
+    bool advanceTo(int actionsExecuted, ReplayResult& result, const ReplayEvent& event);
+    static bool diverge(ReplayResult& result, const ReplayEvent& event, const std::string& message);
+
+    GameModel levelSource_;
+    Simulation simulation_;
+    Level level_;
+    std::vector<Command> program_;
+    int levelNumber_ = 0;
+    bool levelLoaded_ = false;
+    bool running_ = false;
+    int actionsExecuted_ = 0;       // Aktionen seit dem letzten Programmstart
+};
+
+#endif //CODINI_REPLAY_LOG_H
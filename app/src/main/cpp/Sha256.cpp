@@ -0,0 +1,407 @@
+#include "Sha256.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+#if !defined(CODINI_NO_SIMD) && (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#include <cpuid.h>
+#include <immintrin.h>
+#define CODINI_SHA_X86 1
+#elif !defined(CODINI_NO_SIMD) && defined(__aarch64__) && \
+    (defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO))
+#include <arm_neon.h>
+#if defined(__linux__)
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#endif
+#define CODINI_SHA_ARM 1
+#endif
+
+namespace {
+    constexpr uint32_t kInitialState[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+        0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+    };
+
+    alignas(16) constexpr uint32_t kRoundConstants[64] = {
+        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+        0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+        0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+        0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+        0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+    };
+
+    uint32_t rotr(uint32_t value, int bits) {
+        return (value >> bits) | (value << (32 - bits));
+    }
+
+    uint32_t loadBigEndian(const uint8_t* bytes) {
+        return (uint32_t(bytes[0]) << 24) | (uint32_t(bytes[1]) << 16) |
+               (uint32_t(bytes[2]) << 8) | uint32_t(bytes[3]);
+    }
+
+    void storeBigEndian(uint8_t* bytes, uint32_t value) {
+        bytes[0] = static_cast<uint8_t>(value >> 24);
+        bytes[1] = static_cast<uint8_t>(value >> 16);
+        bytes[2] = static_cast<uint8_t>(value >> 8);
+        bytes[3] = static_cast<uint8_t>(value);
+    }
+
+    void compressPortable(uint32_t state[8], const uint8_t* blocks, size_t blockCount) {
+        uint32_t w[64];
+        for (size_t block = 0; block < blockCount; block++, blocks += 64) {
+            for (int t = 0; t < 16; t++) {
+                w[t] = loadBigEndian(blocks + t * 4);
+            }
+            for (int t = 16; t < 64; t++) {
+                uint32_t s0 = rotr(w[t - 15], 7) ^ rotr(w[t - 15], 18) ^ (w[t - 15] >> 3);
+                uint32_t s1 = rotr(w[t - 2], 17) ^ rotr(w[t - 2], 19) ^ (w[t - 2] >> 10);
+                w[t] = w[t - 16] + s0 + w[t - 7] + s1;
+            }
+
+            uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+            uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+            for (int t = 0; t < 64; t++) {
+                uint32_t s1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+                uint32_t choice = (e & f) ^ (~e & g);
+                uint32_t temp1 = h + s1 + choice + kRoundConstants[t] + w[t];
+                uint32_t s0 = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+                uint32_t majority = (a & b) ^ (a & c) ^ (b & c);
+                uint32_t temp2 = s0 + majority;
+                h = g;
+                g = f;
+                f = e;
+                e = d + temp1;
+                d = c;
+                c = b;
+                b = a;
+                a = temp1 + temp2;
+            }
+            state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+            state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+        }
+    }
+
+#if defined(CODINI_SHA_X86)
+    bool cpuHasShaNi() {
+        unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+        if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || !(ecx & bit_SSE4_1)) {
+            return false;
+        }
+        if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+            return false;
+        }
+        return (ebx & (1u << 29)) != 0;  // SHA
+    }
+
+    // Je Schleifendurchlauf vier Runden; msg hält die nächsten 16 Wörter des Nachrichtenplans
+    __attribute__((target("sha,sse4.1,ssse3")))
+    void compressShaNi(uint32_t state[8], const uint8_t* blocks, size_t blockCount) {
+        const __m128i byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+        // Die Befehle erwarten die Zustandswörter als ABEF und CDGH
+        __m128i temp = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), 0xB1);
+        __m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state + 4)), 0x1B);
+        __m128i state0 = _mm_alignr_epi8(temp, state1, 8);
+        state1 = _mm_blend_epi16(state1, temp, 0xF0);
+
+        for (size_t block = 0; block < blockCount; block++, blocks += 64) {
+            const __m128i savedAbef = state0;
+            const __m128i savedCdgh = state1;
+
+            __m128i msg[4];
+            for (int i = 0; i < 4; i++) {
+                msg[i] = _mm_shuffle_epi8(
+                        _mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks + i * 16)), byteSwap);
+            }
+            for (int i = 0; i < 16; i++) {
+                __m128i wk = _mm_add_epi32(
+                        msg[i & 3], _mm_load_si128(reinterpret_cast<const __m128i*>(kRoundConstants + i * 4)));
+                state1 = _mm_sha256rnds2_epu32(state1, state0, wk);
+                state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(wk, 0x0E));
+                if (i < 12) {
+                    __m128i next = _mm_sha256msg1_epu32(msg[i & 3], msg[(i + 1) & 3]);
+                    next = _mm_add_epi32(next, _mm_alignr_epi8(msg[(i + 3) & 3], msg[(i + 2) & 3], 4));
+                    msg[i & 3] = _mm_sha256msg2_epu32(next, msg[(i + 3) & 3]);
+                }
+            }
+
+            state0 = _mm_add_epi32(state0, savedAbef);
+            state1 = _mm_add_epi32(state1, savedCdgh);
+        }
+
+        temp = _mm_shuffle_epi32(state0, 0x1B);
+        state1 = _mm_shuffle_epi32(state1, 0xB1);
+        state0 = _mm_blend_epi16(temp, state1, 0xF0);
+        state1 = _mm_alignr_epi8(state1, temp, 8);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(state), state0);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(state + 4), state1);
+    }
+#endif
+
+#if defined(CODINI_SHA_ARM)
+    bool cpuHasArmSha2() {
+#if defined(__linux__)
+        return (getauxval(AT_HWCAP) & HWCAP_SHA2) != 0;
+#else
+        return true;  // Zur Übersetzungszeit zugesichert
+#endif
+    }
+
+    void compressArmV8(uint32_t state[8], const uint8_t* blocks, size_t blockCount) {
+        uint32x4_t state0 = vld1q_u32(state);
+        uint32x4_t state1 = vld1q_u32(state + 4);
+
+        for (size_t block = 0; block < blockCount; block++, blocks += 64) {
+            const uint32x4_t savedAbcd = state0;
+            const uint32x4_t savedEfgh = state1;
+
+            uint32x4_t msg[4];
+            for (int i = 0; i < 4; i++) {
+                msg[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(blocks + i * 16)));
+            }
+            for (int i = 0; i < 16; i++) {
+                uint32x4_t wk = vaddq_u32(msg[i & 3], vld1q_u32(kRoundConstants + i * 4));
+                uint32x4_t previous = state0;
+                state0 = vsha256hq_u32(state0, state1, wk);
+                state1 = vsha256h2q_u32(state1, previous, wk);
+                if (i < 12) {
+                    msg[i & 3] = vsha256su1q_u32(vsha256su0q_u32(msg[i & 3], msg[(i + 1) & 3]),
+                                                 msg[(i + 2) & 3], msg[(i + 3) & 3]);
+                }
+            }
+
+            state0 = vaddq_u32(state0, savedAbcd);
+            state1 = vaddq_u32(state1, savedEfgh);
+        }
+
+        vst1q_u32(state, state0);
+        vst1q_u32(state + 4, state1);
+    }
+#endif
+
+    using CompressFunction = void (*)(uint32_t*, const uint8_t*, size_t);
+
+    Sha256::Backend detectBackend() {
+#if defined(CODINI_SHA_X86)
+        if (cpuHasShaNi()) return Sha256::Backend::SHA_NI;
+#elif defined(CODINI_SHA_ARM)
+        if (cpuHasArmSha2()) return Sha256::Backend::ARMV8;
+#endif
+        return Sha256::Backend::PORTABLE;
+    }
+
+    std::atomic<Sha256::Backend>& activeBackend() {
+        static std::atomic<Sha256::Backend> backend{detectBackend()};
+        return backend;
+    }
+
+    CompressFunction compressFunction() {
+        switch (activeBackend().load(std::memory_order_relaxed)) {
+#if defined(CODINI_SHA_X86)
+            case Sha256::Backend::SHA_NI: return compressShaNi;
+#endif
+#if defined(CODINI_SHA_ARM)
+            case Sha256::Backend::ARMV8: return compressArmV8;
+#endif
+            default: return compressPortable;
+        }
+    }
+
+    void storeState(uint8_t* bytes, const uint32_t state[8]) {
+        for (int i = 0; i < 8; i++) {
+            storeBigEndian(bytes + i * 4, state[i]);
+        }
+    }
+
+    // Block mit 32 Byte Nachricht hinter einem bereits verarbeiteten Block (HMAC-Schlüssel)
+    void prepareDigestBlock(uint8_t block[64]) {
+        std::memset(block, 0, 64);
+        block[32] = 0x80;
+        storeBigEndian(block + 60, (64 + 32) * 8);
+    }
+}
+
+Sha256::Sha256() {
+    std::memcpy(state_, kInitialState, sizeof(state_));
+}
+
+void Sha256::update(const void* data, size_t size) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    totalBytes_ += size;
+
+    if (bufferSize_ > 0) {
+        size_t take = std::min(size, sizeof(buffer_) - bufferSize_);
+        std::memcpy(buffer_ + bufferSize_, bytes, take);
+        bufferSize_ += take;
+        bytes += take;
+        size -= take;
+        if (bufferSize_ < sizeof(buffer_)) {
+            return;
+        }
+        compress(state_, buffer_, 1);
+        bufferSize_ = 0;
+    }
+
+    size_t blockCount = size / 64;
+    if (blockCount > 0) {
+        compress(state_, bytes, blockCount);
+        bytes += blockCount * 64;
+        size -= blockCount * 64;
+    }
+    std::memcpy(buffer_, bytes, size);
+    bufferSize_ = size;
+}
+
+Sha256Digest Sha256::finish() {
+    uint64_t bitLength = totalBytes_ * 8;
+    buffer_[bufferSize_++] = 0x80;
+    if (bufferSize_ > 56) {
+        std::memset(buffer_ + bufferSize_, 0, sizeof(buffer_) - bufferSize_);
+        compress(state_, buffer_, 1);
+        bufferSize_ = 0;
+    }
+    std::memset(buffer_ + bufferSize_, 0, 56 - bufferSize_);
+    storeBigEndian(buffer_ + 56, static_cast<uint32_t>(bitLength >> 32));
+    storeBigEndian(buffer_ + 60, static_cast<uint32_t>(bitLength));
+    compress(state_, buffer_, 1);
+
+    Sha256Digest digest{};
+    storeState(digest.data(), state_);
+    return digest;
+}
+
+Sha256Digest Sha256::hash(const void* data, size_t size) {
+    Sha256 sha;
+    sha.update(data, size);
+    return sha.finish();
+}
+
+void Sha256::compress(uint32_t state[8], const uint8_t* blocks, size_t blockCount) {
+    compressFunction()(state, blocks, blockCount);
+}
+
+Sha256::Backend Sha256::getBackend() {
+    return activeBackend().load(std::memory_order_relaxed);
+}
+
+bool Sha256::isSupported(Backend backend) {
+    switch (backend) {
+        case Backend::PORTABLE:
+            return true;
+#if defined(CODINI_SHA_X86)
+        case Backend::SHA_NI:
+            return cpuHasShaNi();
+#endif
+#if defined(CODINI_SHA_ARM)
+        case Backend::ARMV8:
+            return cpuHasArmSha2();
+#endif
+        default:
+            return false;
+    }
+}
+
+bool Sha256::setBackend(Backend backend) {
+    if (!isSupported(backend)) {
+        return false;
+    }
+    activeBackend().store(backend, std::memory_order_relaxed);
+    return true;
+}
+
+const char* Sha256::backendName(Backend backend) {
+    switch (backend) {
+        case Backend::SHA_NI: return "SHA-NI";
+        case Backend::ARMV8: return "ARMv8";
+        default: return "portable";
+    }
+}
+
+Sha256Digest hmacSha256(const void* key, size_t keySize, const void* message, size_t messageSize) {
+    uint8_t pad[64] = {};
+    if (keySize > sizeof(pad)) {
+        Sha256Digest keyDigest = Sha256::hash(key, keySize);
+        std::memcpy(pad, keyDigest.data(), keyDigest.size());
+    } else if (keySize > 0) {
+        std::memcpy(pad, key, keySize);
+    }
+
+    for (auto& byte : pad) byte ^= 0x36;
+    Sha256 inner;
+    inner.update(pad, sizeof(pad));
+    inner.update(message, messageSize);
+    Sha256Digest innerDigest = inner.finish();
+
+    for (auto& byte : pad) byte ^= 0x36 ^ 0x5c;
+    Sha256 outer;
+    outer.update(pad, sizeof(pad));
+    outer.update(innerDigest.data(), innerDigest.size());
+    return outer.finish();
+}
+
+Sha256Digest pbkdf2Sha256(const void* password, size_t passwordSize,
+                          const void* salt, size_t saltSize, uint32_t iterations) {
+    uint8_t pad[64] = {};
+    if (passwordSize > sizeof(pad)) {
+        Sha256Digest keyDigest = Sha256::hash(password, passwordSize);
+        std::memcpy(pad, keyDigest.data(), keyDigest.size());
+    } else if (passwordSize > 0) {
+        std::memcpy(pad, password, passwordSize);
+    }
+
+    // Zustände nach dem inneren und äußeren Schlüsselblock, für jede Iteration gleich
+    CompressFunction compressBlocks = compressFunction();
+    uint32_t innerKeyState[8];
+    uint32_t outerKeyState[8];
+    std::memcpy(innerKeyState, kInitialState, sizeof(innerKeyState));
+    std::memcpy(outerKeyState, kInitialState, sizeof(outerKeyState));
+    for (auto& byte : pad) byte ^= 0x36;
+    compressBlocks(innerKeyState, pad, 1);
+    for (auto& byte : pad) byte ^= 0x36 ^ 0x5c;
+    compressBlocks(outerKeyState, pad, 1);
+
+    // U1 = HMAC(P, S || INT(1))
+    std::vector<uint8_t> firstMessage(static_cast<const uint8_t*>(salt),
+                                      static_cast<const uint8_t*>(salt) + saltSize);
+    firstMessage.insert(firstMessage.end(), {0, 0, 0, 1});
+    Sha256Digest first = hmacSha256(password, passwordSize, firstMessage.data(), firstMessage.size());
+
+    uint8_t innerBlock[64];
+    uint8_t outerBlock[64];
+    prepareDigestBlock(innerBlock);
+    prepareDigestBlock(outerBlock);
+
+    uint32_t state[8];
+    for (int word = 0; word < 8; word++) {
+        state[word] = loadBigEndian(first.data() + word * 4);
+    }
+
+    uint32_t result[8];
+    std::memcpy(result, state, sizeof(result));
+
+    // Ui = HMAC(P, Ui-1), T = U1 ^ U2 ^ ... ^ Uc
+    for (uint32_t i = 1; i < iterations; i++) {
+        storeState(innerBlock, state);
+        std::memcpy(state, innerKeyState, sizeof(state));
+        compressBlocks(state, innerBlock, 1);
+
+        storeState(outerBlock, state);
+        std::memcpy(state, outerKeyState, sizeof(state));
+        compressBlocks(state, outerBlock, 1);
+
+        for (int word = 0; word < 8; word++) {
+            result[word] ^= state[word];
+        }
+    }
+
+    Sha256Digest derived{};
+    storeState(derived.data(), result);
+    return derived;
+}
@@ -0,0 +1,68 @@
+#ifndef CODINI_SHA256_H
+#define CODINI_SHA256_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+using Sha256Digest = std::array<uint8_t, 32>;
+
+/*!
+ * SHA-256 (FIPS 180-4). Die Kompressionsfunktion nutzt, falls vorhanden, die SHA-Befehle der
+ * CPU: SHA-NI auf x86-64, die ARMv8-Kryptoerweiterung auf arm64. Die Auswahl geschieht einmal
+ * zur Laufzeit; mit CODINI_NO_SIMD wird immer portabel gerechnet.
+ */
+class Sha256 {
+public:
+    enum class Backend : uint8_t {
+        PORTABLE,
+        SHA_NI,   // x86-64 SHA Extensions
+        ARMV8     // ARMv8 Crypto Extensions
+    };
+
+    Sha256();
+
+    void update(const void* data, size_t size);
+    Sha256Digest finish();
+
+    static Sha256Digest hash(const void* data, size_t size);
+
+    /*!
+     * @return die aktuell verwendete Implementierung
+     */
+    static Backend getBackend();
+
+    /*!
+     * Erzwingt eine Implementierung, z.B. für Benchmarks und Vergleiche.
+     * @return false, wenn die CPU sie nicht unterstützt (dann bleibt alles wie es war)
+     */
+    static bool setBackend(Backend backend);
+
+    static bool isSupported(Backend backend);
+    static const char* backendName(Backend backend);
+
+    /*!
+     * Verarbeitet blockCount aufeinanderfolgende 64-Byte-Blöcke, ohne Auffüllung.
+     */
+    static void compress(uint32_t state[8], const uint8_t* blocks, size_t blockCount);
+
+private:
+    uint32_t state_[8];
+    uint8_t buffer_[64];
+    size_t bufferSize_ = 0;
+    uint64_t totalBytes_ = 0;
+};
+
+/*!
+ * HMAC-SHA-256 (RFC 2104).
+ */
+Sha256Digest hmacSha256(const void* key, size_t keySize, const void* message, size_t messageSize);
+
+/*!
+ * PBKDF2-HMAC-SHA-256 (RFC 8018) mit genau einem Ausgabeblock (32 Byte). Die Schlüsselblöcke
+ * werden einmal vorberechnet, jede Iteration kostet danach zwei Kompressionen.
+ */
+Sha256Digest pbkdf2Sha256(const void* password, size_t passwordSize,
+                          const void* salt, size_t saltSize, uint32_t iterations);
+
+#endif //CODINI_SHA256_H
@@ -1,7 +1,9 @@
 #include "Shader.h"
 
-#include "AndroidOut.h"
+#include "Log.h"
 #include "Model.h"
+#include "Profiler.h"
+#include "TextureAsset.h"
 #include "Utility.h"
 
 Shader *Shader::loadShader(
@@ -39,7 +41,7 @@ Shader *Shader::loadShader(
             if (logLength) {
                 GLchar *log = new GLchar[logLength];
                 glGetProgramInfoLog(program, logLength, nullptr, log);
-                aout << "Failed to link program with:\n" << log << std::endl;
+                LOG_E("Failed to link program with:\n{}", log);
                 delete[] log;
             }
 
@@ -96,7 +98,7 @@ GLuint Shader::loadShader(GLenum shaderType, const std::string &shaderSource) {
             if (infoLength) {
                 auto *infoLog = new GLchar[infoLength];
                 glGetShaderInfoLog(shader, infoLength, nullptr, infoLog);
-                aout << "Failed to compile with:\n" << infoLog << std::endl;
+                LOG_E("Failed to compile with:\n{}", infoLog);
                 delete[] infoLog;
             }
 
@@ -116,6 +118,8 @@ void Shader::deactivate() const {
 }
 
 void Shader::drawModel(const Model &model) const {
+    PROFILE_ZONE("Shader::drawModel");
+
     // The position attribute is 3 floats
     glVertexAttribPointer(
             position_, // attrib
@@ -0,0 +1,592 @@
+#include "Simulation.h"
+
+#include <algorithm>
+#include <string>
+
+namespace {
+    // Weite einer Bewegung in Blickrichtung, 0 für Aktionen ohne Bewegung
+    int moveDistance(CommandType action) {
+        switch (action) {
+            case CommandType::MOVE_FORWARD: return 1;
+            case CommandType::MOVE_BACKWARD: return -1;
+            case CommandType::JUMP: return 2;       // Über ein Feld hinweg
+            case CommandType::TELEPORT: return 3;
+            default: return 0;
+        }
+    }
+
+    // Sprung und Teleport brauchen nur ein freies Zielfeld, normale Schritte den ganzen Weg
+    bool checksPath(CommandType action) {
+        return action == CommandType::MOVE_FORWARD || action == CommandType::MOVE_BACKWARD;
+    }
+}
+
+void Simulation::loadLevel(const Level& level) {
+    startBoxes_.clear();
+    startSelectedBox_ = -1;
+    for (size_t i = 0; i < level.boxes.size(); i++) {
+        const GameObject& box = level.boxes[i];
+        startBoxes_.push_back({tileFromPosition(box.position), directionFromRotation(box.rotation)});
+        if (box.isSelected && startSelectedBox_ < 0) {
+            startSelectedBox_ = static_cast<int>(i);
+        }
+    }
+    // Ohne ausgewählte Box steuert das Programm die erste Box
+    startSelectedBox_ = std::max(startSelectedBox_, 0);
+    startObjects_.clear();
+    targets_.clear();
+    for (const auto& target : level.targets) {
+        targets_.push_back(tileFromPosition(target.position));
+    }
+    sizeField();
+    restoreField();
+    stopProgram();
+}
+
+void Simulation::loadLevel(const LevelDefinition& definition) {
+    startBoxes_.clear();
+    startSelectedBox_ = 0;
+    for (const auto& start : definition.startPositions) {
+        startBoxes_.push_back({tileFromPosition(start), Direction::EAST});
+    }
+    targets_.clear();
+    for (const auto& target : definition.targetPositions) {
+        targets_.push_back(tileFromPosition(target));
+    }
+    startObjects_.clear();
+    for (const auto& object : definition.objects) {
+        startObjects_.push_back({object.type, tileFromPosition(object.position), object.isActive,
+                                 object.linkedId});
+    }
+    sizeField();
+    restoreField();
+    stopProgram();
+}
+
+void Simulation::loadLevel(const LevelView& view) {
+    startBoxes_.clear();
+    startSelectedBox_ = 0;
+    for (const auto& start : view.getStarts()) {
+        startBoxes_.push_back({TilePos{start.x, start.y}, Direction::EAST});
+    }
+    targets_.clear();
+    for (const auto& target : view.getTargets()) {
+        targets_.push_back(TilePos{target.x, target.y});
+    }
+    startObjects_.clear();
+    for (const auto& object : view.getObjects()) {
+        startObjects_.push_back({static_cast<LevelObject::Type>(object.type),
+                                 TilePos{object.tile.x, object.tile.y}, object.isActive != 0,
+                                 object.linkedId});
+    }
+    sizeField();
+    restoreField();
+    stopProgram();
+}
+
+void Simulation::reset() {
+    restoreField();
+    vm_.reset(program_);
+    resetBoxVMs();
+}
+
+void Simulation::sizeField() {
+    // Ein Feld mehr als die größte Koordinate, die Ränder 0 und FIELD_WIDTH sind beide begehbar
+    int width = FIELD_WIDTH + 1;
+    int height = FIELD_HEIGHT + 1;
+    auto include = [&](TilePos tile) {
+        width = std::max(width, std::min(tile.x + 1, kMaxFieldSize));
+        height = std::max(height, std::min(tile.y + 1, kMaxFieldSize));
+    };
+    for (const auto& box : startBoxes_) include(box.tile);
+    for (const auto& target : targets_) include(target);
+    for (const auto& object : startObjects_) include(object.tile);
+
+    // Nur bei geänderter Größe neu anlegen, sonst bleibt der Speicher der Raster erhalten
+    if (tiles_.getWidth() != width || tiles_.getHeight() != height) {
+        tiles_.resize(width, height);
+        grid_.resize(width, height);
+    }
+}
+
+void Simulation::restoreField() {
+    boxes_ = startBoxes_;
+    objects_ = startObjects_;
+    itemsCollected_ = 0;
+    selectedBox_ = startSelectedBox_;
+
+    tiles_.clear();
+    grid_.clear(SpatialGrid::Layer::TARGET);
+    grid_.clear(SpatialGrid::Layer::OBJECT);
+
+    for (const auto& box : boxes_) {
+        tiles_.set(box.tile, Tile::BOX);
+    }
+    for (size_t i = 0; i < targets_.size(); i++) {
+        tiles_.set(targets_[i], Tile::TARGET);
+        grid_.insert(SpatialGrid::Layer::TARGET, static_cast<int>(i), targets_[i]);
+    }
+    for (size_t i = 0; i < objects_.size(); i++) {
+        addObjectToGrid(static_cast<int>(i));
+    }
+}
+
+void Simulation::stopProgram() {
+    vm_.halt();
+    for (auto& vm : boxVMs_) {
+        vm.halt();
+    }
+}
+
+bool Simulation::loadProgram(const std::vector<Command>& commands) {
+    parallel_ = false;
+    boxPrograms_.clear();
+    boxVMs_.clear();
+    if (!ProgramCompiler::compile(commands, program_)) {
+        vm_.halt();
+        return false;
+    }
+    vm_.reset(program_);
+    return true;
+}
+
+bool Simulation::loadParallelPrograms(const std::vector<std::vector<Command>>& programs) {
+    parallel_ = true;
+    program_ = Program{};
+    vm_.halt();
+    boxVMs_.clear();
+    boxPrograms_.assign(programs.size(), Program{});
+
+    if (programs.size() != 1 && programs.size() != boxes_.size()) {
+        program_.error = "Anzahl der Programme passt nicht zu den Boxen";
+        return false;
+    }
+    for (size_t i = 0; i < programs.size(); i++) {
+        if (!ProgramCompiler::compile(programs[i], boxPrograms_[i])) {
+            program_.error = "Box " + std::to_string(i + 1) + ": " + boxPrograms_[i].error;
+            return false;
+        }
+    }
+    resetBoxVMs();
+    return true;
+}
+
+void Simulation::resetBoxVMs() {
+    if (!parallel_) {
+        return;
+    }
+    // Die VMs zeigen in boxPrograms_, das sich bis zum nächsten Laden nicht mehr ändert
+    boxVMs_.assign(boxes_.size(), ProgramVM{});
+    bool shared = boxPrograms_.size() == 1;
+    if (!shared && boxPrograms_.size() != boxes_.size()) {
+        return;
+    }
+    for (size_t i = 0; i < boxVMs_.size(); i++) {
+        boxVMs_[i].reset(boxPrograms_[shared ? 0 : i]);
+    }
+}
+
+bool Simulation::step(StepEvent* outEvent) {
+    // Im Parallelbetrieb ist vm_ angehalten, next() liefert dann sofort false
+    if (boxes_.empty()) {
+        return false;
+    }
+
+    CommandType action;
+    if (!vm_.next(*this, action)) {
+        return false;
+    }
+
+    StepEvent event;
+    applyAction(selectedBox_, action, event);
+    if (outEvent) {
+        *outEvent = event;
+    }
+    return true;
+}
+
+int Simulation::stepRound(std::vector<StepEvent>* outEvents) {
+    if (!parallel_) {
+        StepEvent event;
+        if (!step(outEvents ? &event : nullptr)) {
+            return 0;
+        }
+        if (outEvents) {
+            outEvents->push_back(event);
+        }
+        return 1;
+    }
+
+    // Erst alle Entscheidungen auf dem Zustand vor dem Takt, dann erst Änderungen
+    intents_.clear();
+    for (size_t i = 0; i < boxVMs_.size(); i++) {
+        BoxConditions conditions{*this, static_cast<int>(i)};
+        CommandType action;
+        if (boxVMs_[i].next(conditions, action)) {
+            intents_.push_back({static_cast<int>(i), action, boxes_[i].tile, boxes_[i].tile, false});
+        }
+    }
+    if (intents_.empty()) {
+        return 0;
+    }
+
+    resolveMoves();
+
+    // Alle Bewegungen gleichzeitig: erst alle Felder räumen, dann die Ziele besetzen
+    for (const Intent& intent : intents_) {
+        if (intent.moving) {
+            tiles_.unset(intent.from, Tile::BOX);
+        }
+    }
+    for (const Intent& intent : intents_) {
+        if (intent.moving) {
+            tiles_.set(intent.target, Tile::BOX);
+            boxes_[intent.boxIndex].tile = intent.target;
+        }
+    }
+
+    // Übrige Aktionen nach den Bewegungen, in Boxreihenfolge
+    for (const Intent& intent : intents_) {
+        const BoxState& box = boxes_[intent.boxIndex];
+        StepEvent event{intent.action, intent.boxIndex, intent.from, box.tile, box.facing,
+                        box.facing, intent.moving};
+        if (moveDistance(intent.action) == 0) {
+            applyAction(intent.boxIndex, intent.action, event);
+        }
+        if (outEvents) {
+            outEvents->push_back(event);
+        }
+    }
+    return static_cast<int>(intents_.size());
+}
+
+void Simulation::resolveMoves() {
+    // Zielfelder gegen Wände, Türen und Spielfeldrand prüfen, Boxen folgen danach
+    for (Intent& intent : intents_) {
+        int distance = moveDistance(intent.action);
+        if (distance == 0) {
+            continue;
+        }
+        const BoxState& box = boxes_[intent.boxIndex];
+        intent.target = box.tile.offset(box.facing, distance);
+        intent.moving = isPassable(intent.target);
+
+        int stride = distance < 0 ? -1 : 1;
+        for (int d = stride; intent.moving && checksPath(intent.action) && d != distance; d += stride) {
+            intent.moving = isValidPosition(box.tile.offset(box.facing, d));
+        }
+    }
+
+    // Gleiches Zielfeld: der kleinste Boxindex zieht. Tausch zweier Felder: beide bleiben stehen.
+    for (size_t a = 0; a < intents_.size(); a++) {
+        for (size_t b = a + 1; b < intents_.size(); b++) {
+            Intent& first = intents_[a];
+            Intent& second = intents_[b];
+            if (!first.moving || !second.moving) {
+                continue;
+            }
+            if (first.target == second.target) {
+                second.moving = false;
+            } else if (first.target == boxes_[second.boxIndex].tile &&
+                       second.target == boxes_[first.boxIndex].tile) {
+                first.moving = false;
+                second.moving = false;
+            }
+        }
+    }
+
+    // Besetzte Zielfelder werden nur frei, wenn die Box dort selbst zieht. Jede Blockade kann
+    // weitere auslösen, deshalb bis nichts mehr kippt; Ringe aus drei oder mehr Boxen ziehen.
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (Intent& intent : intents_) {
+            if (!intent.moving || !tiles_.has(intent.target, Tile::BOX)) {
+                continue;
+            }
+            int occupant = findBoxAt(intent.target);
+            bool leaves = std::any_of(intents_.begin(), intents_.end(), [occupant](const Intent& other) {
+                return other.boxIndex == occupant && other.moving;
+            });
+            if (!leaves) {
+                intent.moving = false;
+                changed = true;
+            }
+        }
+    }
+}
+
+int Simulation::findBoxAt(TilePos tile) const {
+    for (size_t i = 0; i < boxes_.size(); i++) {
+        if (boxes_[i].tile == tile) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+RunResult Simulation::run(int actionBudget) {
+    RunResult result{false, false, 0, 0};
+    if (!parallel_) {
+        // Eigene Schleife direkt über step(), der Umweg über stepRound kostet im Interpreter
+        // messbar Zeit
+        while (result.actionsExecuted < actionBudget && step()) {
+            result.actionsExecuted++;
+            if (checkWinCondition()) {
+                result.solved = true;
+                break;
+            }
+        }
+        result.rounds = result.actionsExecuted;
+        result.faulted = vm_.hasFaulted();
+        return result;
+    }
+
+    while (result.actionsExecuted < actionBudget) {
+        int actions = stepRound();
+        if (actions == 0) {
+            break;
+        }
+        result.actionsExecuted += actions;
+        result.rounds++;
+        if (checkWinCondition()) {
+            result.solved = true;
+            break;
+        }
+    }
+    result.faulted = hasFaulted();
+    return result;
+}
+
+bool Simulation::isRunning() const {
+    if (!parallel_) {
+        return vm_.isRunning();
+    }
+    return std::any_of(boxVMs_.begin(), boxVMs_.end(), [](const ProgramVM& vm) {
+        return vm.isRunning();
+    });
+}
+
+bool Simulation::hasFaulted() const {
+    if (!parallel_) {
+        return vm_.hasFaulted();
+    }
+    return std::any_of(boxVMs_.begin(), boxVMs_.end(), [](const ProgramVM& vm) {
+        return vm.hasFaulted();
+    });
+}
+
+void Simulation::applyAction(int boxIndex, CommandType action, StepEvent& event) {
+    BoxState& box = boxes_[boxIndex];
+    event.action = action;
+    event.boxIndex = boxIndex;
+    event.from = box.tile;
+    event.fromFacing = box.facing;
+    event.moved = true;
+
+    switch (action) {
+        // Grundbewegungsbefehle. Weiten wie in moveDistance, hier als Konstanten, damit der
+        // Interpreter-Pfad sie einsetzen kann.
+        case CommandType::MOVE_FORWARD:
+            event.moved = moveBox(boxIndex, 1, true);
+            break;
+        case CommandType::TURN_LEFT:
+            box.facing = turnLeft(box.facing);
+            break;
+        case CommandType::TURN_RIGHT:
+            box.facing = turnRight(box.facing);
+            break;
+
+        // Erweiterte Bewegungsbefehle
+        case CommandType::JUMP:
+            // Springt über ein Feld hinweg, nur der Landepunkt muss frei sein
+            event.moved = moveBox(boxIndex, 2, false);
+            break;
+        case CommandType::MOVE_BACKWARD:
+            event.moved = moveBox(boxIndex, -1, true);
+            break;
+        case CommandType::PICK_ITEM:
+            pickItem(boxIndex);
+            break;
+
+        // Spezielle Befehle
+        case CommandType::TELEPORT:
+            event.moved = moveBox(boxIndex, 3, false);
+            break;
+        case CommandType::ACTIVATE_SWITCH:
+            activateSwitch(boxIndex);
+            break;
+
+        // USE_ITEM und CREATE_BRIDGE haben noch keine Spielregel
+        default:
+            break;
+    }
+
+    event.to = box.tile;
+    event.toFacing = box.facing;
+}
+
+bool Simulation::moveBox(int boxIndex, int distance, bool checkPath) {
+    BoxState& box = boxes_[boxIndex];
+
+    // Bei normaler Bewegung muss jedes Feld auf dem Weg frei sein
+    if (checkPath) {
+        int stride = distance < 0 ? -1 : 1;
+        for (int d = stride; d != distance; d += stride) {
+            if (!isValidPosition(box.tile.offset(box.facing, d))) {
+                return false;
+            }
+        }
+    }
+
+    // Kollisionsprüfung für neues Feld, auch bei Sprung und Teleport (siehe Klassenbeschreibung)
+    TilePos target = box.tile.offset(box.facing, distance);
+    if (!isValidPosition(target)) {
+        return false;
+    }
+
+    tiles_.unset(box.tile, Tile::BOX);
+    tiles_.set(target, Tile::BOX);
+    box.tile = target;
+    return true;
+}
+
+void Simulation::pickItem(int boxIndex) {
+    TilePos tile = boxes_[boxIndex].tile;
+    int item = findObjectAt(tile, LevelObject::Type::ITEM);
+    if (item < 0) {
+        return;
+    }
+    objects_.erase(objects_.begin() + item);
+    itemsCollected_++;
+
+    // Die Indizes dahinter haben sich verschoben, Aufsammeln ist aber selten
+    grid_.clear(SpatialGrid::Layer::OBJECT);
+    for (size_t i = 0; i < objects_.size(); i++) {
+        grid_.insert(SpatialGrid::Layer::OBJECT, static_cast<int>(i), objects_[i].tile);
+    }
+    refreshObjectFlags(tile);
+}
+
+void Simulation::activateSwitch(int boxIndex) {
+    int index = findObjectAt(boxes_[boxIndex].tile, LevelObject::Type::SWITCH);
+    if (index < 0) {
+        return;
+    }
+
+    // Schalter umlegen und alle verknüpften Türen mitschalten
+    TileObject& sw = objects_[index];
+    sw.isActive = !sw.isActive;
+    for (auto& object : objects_) {
+        if (object.type == LevelObject::Type::DOOR && object.linkedId == sw.linkedId &&
+            object.isActive != sw.isActive) {
+            object.isActive = sw.isActive;
+            refreshObjectFlags(object.tile);
+        }
+    }
+}
+
+int Simulation::findObjectAt(TilePos tile, LevelObject::Type type) const {
+    if (!tiles_.has(tile, Tile::flagFor(type, false) | Tile::flagFor(type, true))) {
+        return -1;
+    }
+
+    // Bei mehreren Treffern das erste Objekt in Level-Reihenfolge
+    int found = -1;
+    grid_.forEachNear(SpatialGrid::Layer::OBJECT, tile, 0, [&](int id) {
+        const TileObject& object = objects_[id];
+        if (object.type == type && object.tile == tile && (found < 0 || id < found)) {
+            found = id;
+        }
+    });
+    return found;
+}
+
+void Simulation::addObjectToGrid(int id) {
+    const TileObject& object = objects_[id];
+    grid_.insert(SpatialGrid::Layer::OBJECT, id, object.tile);
+    tiles_.set(object.tile, Tile::flagFor(object.type, object.isActive));
+}
+
+void Simulation::refreshObjectFlags(TilePos tile) {
+    // Boxen und Ziele bleiben, die Objektbits werden aus den Objekten im Feld neu gebildet
+    tiles_.unset(tile, static_cast<uint16_t>(~(Tile::BOX | Tile::TARGET)));
+    grid_.forEachNear(SpatialGrid::Layer::OBJECT, tile, 0, [&](int id) {
+        const TileObject& object = objects_[id];
+        if (object.tile == tile) {
+            tiles_.set(tile, Tile::flagFor(object.type, object.isActive));
+        }
+    });
+}
+
+bool Simulation::isValidPosition(TilePos tile) const {
+    // Spielfeldgrenzen des geladenen Levels, andere Boxen und blockierende Objekte
+    return tiles_.contains(tile) && !tiles_.isBlocked(tile);
+}
+
+bool Simulation::isPassable(TilePos tile) const {
+    // Wie isValidPosition, Boxen zählen aber nicht, die können im selben Takt wegziehen
+    return tiles_.contains(tile) && !tiles_.has(tile, Tile::WALL | Tile::OBSTACLE | Tile::DOOR);
+}
+
+bool Simulation::checkWinCondition() const {
+    if (targets_.empty()) {
+        return false;
+    }
+
+    // Jedes Ziel muss von einer Box besetzt sein
+    for (const auto& target : targets_) {
+        if (!tiles_.has(target, Tile::BOX)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Simulation::isPathAhead(int boxIndex) const {
+    if (boxes_.empty()) {
+        return false;
+    }
+    const BoxState& box = boxes_[boxIndex];
+    return isValidPosition(box.tile.offset(box.facing, 1));
+}
+
+bool Simulation::isTargetNearby(int boxIndex) const {
+    if (boxes_.empty()) {
+        return false;
+    }
+    const TilePos tile = boxes_[boxIndex].tile;
+
+    // Weniger als 2 Einheiten entfernt sind genau die 8 Nachbarfelder und das eigene Feld
+    for (int dy = -1; dy <= 1; dy++) {
+        for (int dx = -1; dx <= 1; dx++) {
+            if (tiles_.has({tile.x + dx, tile.y + dy}, Tile::TARGET)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+uint64_t Simulation::stateHash() const {
+    // FNV-1a über die ganzzahligen Zustandswerte
+    uint64_t hash = 1469598103934665603ull;
+    auto mix = [&hash](int64_t value) {
+        hash ^= static_cast<uint64_t>(value);
+        hash *= 1099511628211ull;
+    };
+
+    for (const auto& box : boxes_) {
+        mix(box.tile.x);
+        mix(box.tile.y);
+        mix(static_cast<int64_t>(box.facing));
+    }
+    for (const auto& object : objects_) {
+        mix(static_cast<int64_t>(object.type));
+        mix(object.tile.x);
+        mix(object.tile.y);
+        mix(object.isActive ? 1 : 0);
+    }
+    mix(itemsCollected_);
+    return hash;
+}
@@ -0,0 +1,261 @@
+#ifndef CODINI_SIMULATION_H
+#define CODINI_SIMULATION_H
+
+#include "Model.h"
+#include "LevelDefinitions.h"
+#include "Command.h"
+#include "Bytecode.h"
+#include "LevelPack.h"
+#include "SpatialGrid.h"
+#include "TileGrid.h"
+#include <vector>
+
+// Zustand einer Box im Raster
+struct BoxState {
+    TilePos tile;
+    Direction facing;
+};
+
+// Levelobjekt im Raster, ohne die nur fürs Rendern nötigen Daten
+struct TileObject {
+    LevelObject::Type type;
+    TilePos tile;
+    bool isActive;
+    int linkedId;
+};
+
+// Ergebnis eines einzelnen Simulationsschritts, daraus baut Game die Animation
+struct StepEvent {
+    CommandType action;
+    int boxIndex;          // Betroffene Box
+    TilePos from;          // Feld vor dem Schritt
+    TilePos to;            // Feld nach dem Schritt
+    Direction fromFacing;
+    Direction toFacing;
+    bool moved;            // false, wenn die Bewegung blockiert war
+};
+
+// Ergebnis eines kompletten Programmdurchlaufs
+struct RunResult {
+    bool solved;           // Alle Ziele erreicht
+    bool faulted;          // VM-Fehler (z.B. endlose Rekursion)
+    int actionsExecuted;   // Ausgeführte Aktionen
+    int rounds;            // Takte, im Einzelbetrieb gleich actionsExecuted
+};
+
+/*!
+ * GL-freier Spielkern. Enthält den Spielfeldzustand und alle Spielregeln (Bewegen, Drehen,
+ * Springen, Teleportieren, Kollisionen, Siegbedingung). Programme laufen ohne Animationen und
+ * deterministisch; Game verwendet dieselbe Simulation und animiert nur die Ergebnisse.
+ *
+ * Normalerweise steuert ein Programm die ausgewählte Box. Im Parallelbetrieb
+ * (loadParallelPrograms) hat jede Box eine eigene VM und alle Boxen handeln im selben Takt,
+ * Konflikte zwischen gleichzeitigen Bewegungen löst stepRound nach festen Regeln auf.
+ *
+ * Jede Bewegung braucht ein freies Zielfeld im Spielfeld, auch Sprung (2 Felder) und Teleport
+ * (3 Felder). Die ursprüngliche Spiellogik ließ Sprung und Teleport ungeprüft landen, auch
+ * außerhalb des Feldes oder auf einer anderen Box; solche Befehle bleiben jetzt wirkungslos
+ * (StepEvent::moved = false). Übersprungene Felder werden dabei nicht geprüft.
+ *
+ * Der Zustand ist ganzzahlig: Boxen stehen auf Feldern und schauen in eine von vier Richtungen,
+ * was auf einem Feld liegt steht in einer TileGrid-Bitmaske. Float-Positionen entstehen erst
+ * beim Rendern (positionOf, rotationOf).
+ */
+class Simulation {
+public:
+    // Größte Koordinate, die Felder 0 bis FIELD_WIDTH bzw. FIELD_HEIGHT sind begehbar. Reicht
+    // ein Level weiter, wächst das Feld bis zu seinem größten Feld mit (höchstens kMaxFieldSize).
+    static constexpr int FIELD_WIDTH = 8;
+    static constexpr int FIELD_HEIGHT = 8;
+    static constexpr int kMaxFieldSize = 256;
+    static constexpr int kDefaultActionBudget = 10000;
+    static constexpr float kSecondsPerAction = 0.5f; // Abstand der Takte im Spiel
+
+    /*!
+     * Spielzeit für eine Anzahl Takte. Im Spiel beginnt alle kSecondsPerAction ein Takt, egal
+     * wie lange seine Animation läuft; Game und Grader werten die Zeit beide hiermit.
+     */
+    static float secondsFor(int rounds) { return rounds * kSecondsPerAction; }
+
+    Simulation() = default;
+
+    // Die VM zeigt in den eigenen Bytecode, deshalb nicht kopierbar
+    Simulation(const Simulation&) = delete;
+    Simulation& operator=(const Simulation&) = delete;
+
+    /*!
+     * Lädt ein Level aus dem GameModel (Boxen und Ziele). Wie alle loadLevel-Varianten hält es
+     * ein geladenes Programm an; erst reset() oder loadProgram startet es wieder.
+     */
+    void loadLevel(const Level& level);
+
+    /*!
+     * Lädt eine Level-Definition inklusive Wänden, Türen und anderer Levelobjekte.
+     */
+    void loadLevel(const LevelDefinition& definition);
+
+    /*!
+     * Lädt ein Level direkt aus einem Level-Paket, ohne es vorher zu kopieren.
+     */
+    void loadLevel(const LevelView& view);
+
+    /*!
+     * Setzt das Spielfeld auf den Startzustand des geladenen Levels zurück und startet ein
+     * geladenes Programm von vorn. Anders als loadLevel, das das Feld ebenso zurücksetzt, aber
+     * das Programm angehalten lässt.
+     */
+    void reset();
+
+    /*!
+     * Hält das laufende Programm bzw. alle Programme an, das Spielfeld bleibt unverändert.
+     */
+    void stopProgram();
+
+    /*!
+     * Übersetzt ein Programm und bereitet die Ausführung vor.
+     * @return false, wenn das Programm ungültig ist (Grund in getProgram().error)
+     */
+    bool loadProgram(const std::vector<Command>& commands);
+
+    /*!
+     * Übersetzt ein Programm pro Box für den Parallelbetrieb, jede Box bekommt eine eigene VM
+     * mit eigenem Befehlszeiger. Ein einzelnes Programm führen alle Boxen aus.
+     * @return false, wenn ein Programm ungültig ist oder die Anzahl nicht zu den Boxen passt
+     *         (Grund in getProgram().error)
+     */
+    bool loadParallelPrograms(const std::vector<std::vector<Command>>& programs);
+
+    bool isParallel() const { return parallel_; }
+
+    /*!
+     * Führt die nächste Aktion des Programms sofort aus (nur Einzelbetrieb).
+     * @param outEvent optional, beschreibt die ausgeführte Aktion
+     * @return false, wenn das Programm beendet ist
+     */
+    bool step(StepEvent* outEvent = nullptr);
+
+    /*!
+     * Ein Takt: im Einzelbetrieb eine Aktion wie step(), im Parallelbetrieb die nächste Aktion
+     * jeder Box, deren Programm noch läuft. Bedingungen sehen dabei alle den Zustand vor dem
+     * Takt. Bewegungen gelten gleichzeitig:
+     *  - Wollen mehrere Boxen auf dasselbe Feld, zieht die mit dem kleinsten Index.
+     *  - Zwei Boxen, die ihre Felder tauschen wollen, bleiben beide stehen.
+     *  - Ein Feld mit einer Box wird nur frei, wenn diese Box im selben Takt wegzieht.
+     * Danach folgen die übrigen Aktionen (Drehen, Aufsammeln, Schalter) nach Boxindex.
+     *
+     * @param outEvents optional, bekommt die Ereignisse des Takts nach Boxindex angehängt
+     * @return Anzahl ausgeführter Aktionen, 0 wenn alle Programme beendet sind
+     */
+    int stepRound(std::vector<StepEvent>* outEvents = nullptr);
+
+    /*!
+     * Führt das geladene Programm bis zum Ende, bis zum Sieg oder bis das Aktionsbudget
+     * aufgebraucht ist aus.
+     */
+    RunResult run(int actionBudget = kDefaultActionBudget);
+
+    // Spielregeln
+    bool isValidPosition(TilePos tile) const;
+    bool checkWinCondition() const;
+    bool isPathAhead() const { return isPathAhead(selectedBox_); }
+    bool isTargetNearby() const { return isTargetNearby(selectedBox_); }
+    bool isPathAhead(int boxIndex) const;
+    bool isTargetNearby(int boxIndex) const;
+
+    /*!
+     * @return ob noch ein Programm läuft, im Parallelbetrieb das irgendeiner Box
+     */
+    bool isRunning() const;
+    bool hasFaulted() const;
+
+    /*!
+     * Ruft fn(targetIndex) für jedes Ziel auf, das auf dem Feld der Box liegt.
+     */
+    template<typename F>
+    void forEachTargetTouching(int boxIndex, F&& fn) const {
+        TilePos tile = boxes_[boxIndex].tile;
+        if (!tiles_.has(tile, Tile::TARGET)) {
+            return;
+        }
+        grid_.forEachNear(SpatialGrid::Layer::TARGET, tile, 0, [&](int id) {
+            if (targets_[id] == tile) {
+                fn(id);
+            }
+        });
+    }
+
+    /*!
+     * @return einen Hash über Boxfelder, Blickrichtungen und Levelobjekte. Gleiche Hashes
+     * bedeuten (bis auf Kollisionen) gleichen Spielzustand, unabhängig vom Programm.
+     */
+    uint64_t stateHash() const;
+
+    const std::vector<BoxState>& getBoxes() const { return boxes_; }
+    const std::vector<TilePos>& getTargets() const { return targets_; }
+    const TileGrid& getTiles() const { return tiles_; }
+    int getSelectedBoxIndex() const { return selectedBox_; }
+    int getItemsCollected() const { return itemsCollected_; }
+    const Program& getProgram() const { return program_; }
+    const ProgramVM& getVM() const { return vm_; }
+    const ProgramVM& getBoxVM(int boxIndex) const { return boxVMs_[boxIndex]; }
+
+private:
+    // Bedingungen aus Sicht einer Box, für ProgramVM::next im Parallelbetrieb
+    struct BoxConditions {
+        const Simulation& simulation;
+        int boxIndex;
+
+        bool isPathAhead() const { return simulation.isPathAhead(boxIndex); }
+        bool isTargetNearby() const { return simulation.isTargetNearby(boxIndex); }
+    };
+
+    // Geplante Aktion einer Box in einem Takt
+    struct Intent {
+        int boxIndex;
+        CommandType action;
+        TilePos from;       // Feld vor dem Takt
+        TilePos target;     // Zielfeld, nur bei Bewegungen
+        bool moving;        // Bewegung, die noch nicht blockiert ist
+    };
+
+    void applyAction(int boxIndex, CommandType action, StepEvent& event);
+    bool moveBox(int boxIndex, int distance, bool checkPath);
+    void pickItem(int boxIndex);
+    void activateSwitch(int boxIndex);
+    void sizeField();
+    void restoreField();
+    void resetBoxVMs();
+    void resolveMoves();
+    int findBoxAt(TilePos tile) const;
+    bool isPassable(TilePos tile) const;
+    int findObjectAt(TilePos tile, LevelObject::Type type) const;
+    void addObjectToGrid(int id);
+    void refreshObjectFlags(TilePos tile);
+
+    // Startzustand des Levels
+    std::vector<BoxState> startBoxes_;
+    std::vector<TileObject> startObjects_;
+    int startSelectedBox_ = 0;
+
+    // Aktueller Zustand
+    std::vector<BoxState> boxes_;
+    std::vector<TilePos> targets_;
+    std::vector<TileObject> objects_;
+    int selectedBox_ = 0;
+    int itemsCollected_ = 0;
+
+    // Inhalt jedes Feldes als Bitmaske, dazu die Indizes der Ziele und Objekte pro Feld
+    TileGrid tiles_;
+    SpatialGrid grid_;
+
+    Program program_;
+    ProgramVM vm_;
+
+    // Parallelbetrieb: ein Programm pro Box oder eines für alle, immer eine VM pro Box
+    bool parallel_ = false;
+    std::vector<Program> boxPrograms_;
+    std::vector<ProgramVM> boxVMs_;
+    std::vector<Intent> intents_;   // Wird in jedem Takt wiederverwendet
+};
+
+#endif //CODINI_SIMULATION_H
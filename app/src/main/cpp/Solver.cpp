@@ -0,0 +1,443 @@
+#include "Solver.h"
+
+#include "Simulation.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <unordered_map>
+
+namespace {
+
+constexpr int kMaxBlocks = 8;
+constexpr size_t kNoItem = std::numeric_limits<size_t>::max();
+
+struct Block {
+    bool isLoop;
+    int bodyLength;
+};
+
+// Syntaktischer Zustand eines Programmanfangs (offene Blöcke, Funktionen)
+struct Shape {
+    Block blocks[kMaxBlocks];
+    int depth = 0;
+    bool inFunction = false;
+    int functionBody = 0;
+    int functionCount = 0;
+    bool usesFunctions = false;
+    bool usesConditions = false;
+};
+
+struct Alphabet {
+    std::vector<CommandType> actions;
+    bool loops = false;
+    bool ifPath = false;
+    bool ifTarget = false;
+    bool functions = false;
+    bool bothTurns = false;  // Drehung nach links und nach rechts verfügbar
+};
+
+bool isActionCommand(CommandType type) {
+    switch (type) {
+        case CommandType::LOOP_START:
+        case CommandType::LOOP_END:
+        case CommandType::FUNCTION_DEF:
+        case CommandType::FUNCTION_CALL:
+        case CommandType::FUNCTION_END:
+        case CommandType::IF_PATH_AHEAD:
+        case CommandType::IF_TARGET_NEARBY:
+        case CommandType::IF_END:
+            return false;
+        default:
+            return true;
+    }
+}
+
+Alphabet makeAlphabet(const std::vector<CommandType>& types) {
+    Alphabet alphabet;
+    auto has = [&types](CommandType type) {
+        return std::find(types.begin(), types.end(), type) != types.end();
+    };
+    for (CommandType type : types) {
+        if (isActionCommand(type) &&
+            std::find(alphabet.actions.begin(), alphabet.actions.end(), type) ==
+            alphabet.actions.end()) {
+            alphabet.actions.push_back(type);
+        }
+    }
+    alphabet.loops = has(CommandType::LOOP_START);
+    alphabet.ifPath = has(CommandType::IF_PATH_AHEAD);
+    alphabet.ifTarget = has(CommandType::IF_TARGET_NEARBY);
+    alphabet.functions = has(CommandType::FUNCTION_DEF) && has(CommandType::FUNCTION_CALL);
+    alphabet.bothTurns = has(CommandType::TURN_LEFT) && has(CommandType::TURN_RIGHT);
+    return alphabet;
+}
+
+// Mindestanzahl Befehle, um alle offenen Blöcke gültig zu schließen
+int closersNeeded(const Shape& shape) {
+    int needed = 0;
+    for (int i = 0; i < shape.depth; i++) {
+        needed += shape.blocks[i].bodyLength == 0 ? 2 : 1;
+    }
+    if (shape.inFunction) {
+        needed += shape.functionBody == 0 ? 2 : 1;
+    }
+    return needed;
+}
+
+// Ein neuer Befehl zählt zum Rumpf des innersten offenen Blocks
+void countBody(Shape& shape) {
+    if (shape.depth > 0) {
+        shape.blocks[shape.depth - 1].bodyLength++;
+    } else if (shape.inFunction) {
+        shape.functionBody++;
+    }
+}
+
+bool isTurn(CommandType type) {
+    return type == CommandType::TURN_LEFT || type == CommandType::TURN_RIGHT;
+}
+
+/*!
+ * Ruft fn(command, nextShape) für jeden Befehl auf, der den Programmanfang gültig und kanonisch
+ * fortsetzt und sich mit den verbleibenden Befehlen noch abschließen lässt.
+ */
+template<typename Fn>
+void forEachCandidate(const Shape& shape, const std::vector<Command>& tokens, int remaining,
+                      const Alphabet& alphabet, const SolverOptions& options, Fn&& fn) {
+    auto offer = [&](const Command& command, const Shape& next) {
+        if (closersNeeded(next) <= remaining - 1) {
+            fn(command, next);
+        }
+    };
+
+    // Aktionen, sich aufhebende Drehungen (links/rechts, dreimal gleich) auslassen. Dreimal
+    // gleich ersetzt nur eine Drehung in die Gegenrichtung, ohne sie ist es die einzige Möglichkeit.
+    size_t count = tokens.size();
+    for (CommandType action : alphabet.actions) {
+        if (isTurn(action) && count > 0 && isTurn(tokens[count - 1].type)) {
+            if (tokens[count - 1].type != action) {
+                continue;
+            }
+            if (alphabet.bothTurns && count > 1 && tokens[count - 2].type == action) {
+                continue;
+            }
+        }
+        Shape next = shape;
+        countBody(next);
+        offer(Command{action}, next);
+    }
+
+    // Schleifen
+    if (alphabet.loops) {
+        if (shape.depth < std::min(options.maxNesting, kMaxBlocks)) {
+            for (int loopCount = 2; loopCount <= options.maxLoopCount; loopCount++) {
+                Shape next = shape;
+                countBody(next);
+                next.blocks[next.depth++] = Block{true, 0};
+                offer(Command{CommandType::LOOP_START, loopCount}, next);
+            }
+        }
+        if (shape.depth > 0 && shape.blocks[shape.depth - 1].isLoop &&
+            shape.blocks[shape.depth - 1].bodyLength > 0) {
+            Shape next = shape;
+            next.depth--;
+            offer(Command{CommandType::LOOP_END}, next);
+        }
+    }
+
+    // Bedingungen
+    if (alphabet.ifPath || alphabet.ifTarget) {
+        if (shape.depth < std::min(options.maxNesting, kMaxBlocks)) {
+            Shape next = shape;
+            countBody(next);
+            next.blocks[next.depth++] = Block{false, 0};
+            next.usesConditions = true;
+            if (alphabet.ifPath) offer(Command{CommandType::IF_PATH_AHEAD}, next);
+            if (alphabet.ifTarget) offer(Command{CommandType::IF_TARGET_NEARBY}, next);
+        }
+        if (shape.depth > 0 && !shape.blocks[shape.depth - 1].isLoop &&
+            shape.blocks[shape.depth - 1].bodyLength > 0) {
+            Shape next = shape;
+            next.depth--;
+            offer(Command{CommandType::IF_END}, next);
+        }
+    }
+
+    // Funktionen: nur auf oberster Ebene definieren, Nummern in Definitionsreihenfolge
+    if (alphabet.functions) {
+        if (!shape.inFunction && shape.depth == 0 && remaining >= 4) {
+            Shape next = shape;
+            next.inFunction = true;
+            next.functionBody = 0;
+            next.functionCount++;
+            next.usesFunctions = true;
+            offer(Command{CommandType::FUNCTION_DEF, 0, next.functionCount}, next);
+        }
+        if (shape.inFunction && shape.depth == 0 && shape.functionBody > 0) {
+            Shape next = shape;
+            next.inFunction = false;
+            offer(Command{CommandType::FUNCTION_END}, next);
+        }
+        for (int id = 1; id <= shape.functionCount; id++) {
+            Shape next = shape;
+            countBody(next);
+            offer(Command{CommandType::FUNCTION_CALL, 0, id}, next);
+        }
+    }
+}
+
+int distance(TilePos a, TilePos b) {
+    return std::abs(a.x - b.x) + std::abs(a.y - b.y);
+}
+
+/*!
+ * Untere Schranke für die noch nötigen Befehle (IDA*-Heuristik). Ohne Schleifen und Funktionen
+ * legt jede Aktion höchstens maxStep Felder zurück; mit ihnen kann schon ein Befehl reichen.
+ * Im Einzelbetrieb zählt der Weg der gesteuerten Box zum nächsten Ziel, im Parallelbetrieb
+ * der längste Weg, den ein Ziel bis zur nächsten Box hat.
+ */
+int lowerBound(const Simulation& simulation, const Alphabet& alphabet, bool parallel) {
+    const auto& boxes = simulation.getBoxes();
+    int nearest = -1;
+    if (!parallel) {
+        const TilePos box = boxes[simulation.getSelectedBoxIndex()].tile;
+        for (const auto& target : simulation.getTargets()) {
+            int d = distance(target, box);
+            if (nearest < 0 || d < nearest) {
+                nearest = d;
+            }
+        }
+    } else {
+        for (const auto& target : simulation.getTargets()) {
+            int closest = -1;
+            for (const auto& box : boxes) {
+                int d = distance(target, box.tile);
+                if (closest < 0 || d < closest) {
+                    closest = d;
+                }
+            }
+            nearest = std::max(nearest, closest);
+        }
+    }
+    if (nearest <= 0) {
+        return 0;
+    }
+    if (alphabet.loops || alphabet.functions) {
+        return 1;
+    }
+
+    int maxStep = 1;
+    for (CommandType action : alphabet.actions) {
+        if (action == CommandType::JUMP) maxStep = std::max(maxStep, 2);
+        if (action == CommandType::TELEPORT) maxStep = std::max(maxStep, 3);
+    }
+    return (nearest + maxStep - 1) / maxStep;
+}
+
+/*!
+ * Im Einzelbetrieb steuert das Programm nur eine Box. Ziele, auf denen keine der übrigen Boxen steht, muss sie
+ * alle gleichzeitig besetzen; bei mehr als einem solchen Ziel gibt es keine Lösung.
+ */
+bool isUnsolvableWithOneBox(const Simulation& simulation) {
+    const auto& boxes = simulation.getBoxes();
+    if (boxes.empty()) {
+        return true;
+    }
+    const TilePos selected = boxes[simulation.getSelectedBoxIndex()].tile;
+    int uncovered = 0;
+    for (const auto& target : simulation.getTargets()) {
+        // Auf dem Feld steht eine Box, die nicht vom Programm gesteuert wird
+        bool covered = target != selected && simulation.getTiles().has(target, Tile::BOX);
+        uncovered += covered ? 0 : 1;
+    }
+    return uncovered > 1;
+}
+
+struct Worker {
+    Simulation simulation;
+    std::unordered_map<uint64_t, int> transpositions;
+    std::vector<Command> tokens;
+    uint64_t nodes = 0;
+    bool aborted = false;  // Abgebrochene Teilbäume hinterlassen unvollständige Einträge
+};
+
+struct RootItem {
+    std::vector<Command> tokens;
+    Shape shape;
+    int remaining;
+};
+
+struct SearchState {
+    const Alphabet& alphabet;
+    const SolverOptions& options;
+    std::atomic<size_t> bestItem{kNoItem};
+};
+
+bool expand(SearchState& state, Worker& worker, const Shape& shape, int remaining, size_t item);
+
+bool searchFrom(SearchState& state, Worker& worker, const Shape& shape, int remaining, size_t item) {
+    if (item > state.bestItem.load(std::memory_order_relaxed)) {
+        worker.aborted = true; // Ein früherer Teilbaum hat schon eine Lösung
+        return false;
+    }
+    worker.nodes++;
+
+    // Abgeschlossene Programmanfänge ausprobieren
+    if (shape.depth == 0 && !shape.inFunction && !worker.tokens.empty()) {
+        Simulation& simulation = worker.simulation;
+        if (state.options.parallel) {
+            simulation.loadParallelPrograms({worker.tokens});
+        } else {
+            simulation.loadProgram(worker.tokens);
+        }
+        simulation.reset();
+        RunResult run = simulation.run(state.options.actionBudget);
+        if (run.solved) {
+            return true;
+        }
+
+        // Nach Bedingungen laufen die Boxen auseinander: eine Box beginnt die Fortsetzung, während
+        // eine andere noch im Anfang steckt. Der Zustand nach dem Anfang sagt dann nichts über die
+        // Fortsetzung aus.
+        if (state.options.parallel && shape.usesConditions) {
+            return remaining > 0 && expand(state, worker, shape, remaining, item);
+        }
+
+        // Nach einem Fehler oder aufgebrauchtem Budget läuft keine Fortsetzung mehr
+        if (run.faulted || run.actionsExecuted >= state.options.actionBudget) {
+            return false;
+        }
+
+        if (lowerBound(simulation, state.alphabet, state.options.parallel) > remaining) {
+            return false;
+        }
+
+        // Ohne Funktionen hängt die Fortsetzung nur vom Spielzustand ab
+        if (!shape.usesFunctions) {
+            auto inserted = worker.transpositions.emplace(simulation.stateHash(), remaining);
+            if (!inserted.second) {
+                if (inserted.first->second >= remaining) {
+                    return false;
+                }
+                inserted.first->second = remaining;
+            }
+        }
+    }
+
+    if (remaining == 0) {
+        return false;
+    }
+    return expand(state, worker, shape, remaining, item);
+}
+
+// Setzt den Programmanfang mit jedem Kandidaten fort, true sobald eine Lösung gefunden ist
+bool expand(SearchState& state, Worker& worker, const Shape& shape, int remaining, size_t item) {
+    bool found = false;
+    forEachCandidate(shape, worker.tokens, remaining, state.alphabet, state.options,
+                     [&](const Command& command, const Shape& next) {
+                         if (found) return;
+                         worker.tokens.push_back(command);
+                         if (searchFrom(state, worker, next, remaining - 1, item)) {
+                             found = true;
+                         } else {
+                             worker.tokens.pop_back();
+                         }
+                     });
+    return found;
+}
+
+// Sammelt alle gültigen Programmanfänge der Länge depth als parallele Arbeitspakete
+void collectRoots(const Shape& shape, std::vector<Command>& tokens, int remaining, int depth,
+                  const Alphabet& alphabet, const SolverOptions& options,
+                  std::vector<RootItem>& outItems) {
+    if (depth == 0 || remaining == 0) {
+        outItems.push_back(RootItem{tokens, shape, remaining});
+        return;
+    }
+    forEachCandidate(shape, tokens, remaining, alphabet, options,
+                     [&](const Command& command, const Shape& next) {
+                         tokens.push_back(command);
+                         collectRoots(next, tokens, remaining - 1, depth - 1,
+                                      alphabet, options, outItems);
+                         tokens.pop_back();
+                     });
+}
+
+} // namespace
+
+Solver::Solver(ThreadPool& pool, SolverOptions options) : pool_(pool), options_(options) {}
+
+SolverResult Solver::solve(const Level& level) {
+    return search(level, level.availableCommands);
+}
+
+SolverResult Solver::solve(const LevelDefinition& definition) {
+    return search(definition, definition.availableCommands);
+}
+
+SolverResult Solver::solve(const LevelView& view) {
+    auto commands = view.getAvailableCommands();
+    return search(view, std::vector<CommandType>(commands.begin(), commands.end()));
+}
+
+template<typename LevelT>
+SolverResult Solver::search(const LevelT& level, const std::vector<CommandType>& types) {
+    SolverResult result;
+    Alphabet alphabet = makeAlphabet(types);
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    for (unsigned i = 0; i < pool_.getWorkerCount(); i++) {
+        workers.push_back(std::make_unique<Worker>());
+        workers.back()->simulation.loadLevel(level);
+    }
+
+    if (!options_.parallel && isUnsolvableWithOneBox(workers.front()->simulation)) {
+        result.unsolvable = true;
+        return result;
+    }
+
+    for (int length = 1; length <= options_.maxLength && !result.found; length++) {
+        std::vector<RootItem> items;
+        std::vector<Command> tokens;
+        collectRoots(Shape(), tokens, length, std::min(2, length), alphabet, options_, items);
+
+        SearchState state{alphabet, options_};
+        std::vector<std::vector<Command>> solutions(items.size());
+        for (auto& worker : workers) {
+            worker->transpositions.clear();
+        }
+
+        pool_.parallelFor(items.size(), 1, [&](size_t begin, size_t end, unsigned index) {
+            Worker& worker = *workers[index];
+            for (size_t i = begin; i < end; i++) {
+                if (worker.aborted) {
+                    worker.transpositions.clear();
+                    worker.aborted = false;
+                }
+                worker.tokens = items[i].tokens;
+                if (searchFrom(state, worker, items[i].shape, items[i].remaining, i)) {
+                    solutions[i] = worker.tokens;
+
+                    // Kleinsten Index behalten, damit das Ergebnis nicht vom Scheduling abhängt
+                    size_t best = state.bestItem.load();
+                    while (i < best && !state.bestItem.compare_exchange_weak(best, i)) {
+                    }
+                }
+            }
+        });
+
+        result.searchedLength = length;
+        size_t best = state.bestItem.load();
+        if (best != kNoItem) {
+            result.found = true;
+            result.program = solutions[best];
+        }
+    }
+
+    for (const auto& worker : workers) {
+        result.nodesVisited += worker->nodes;
+    }
+    return result;
+}
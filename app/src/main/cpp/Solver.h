@@ -0,0 +1,69 @@
+#ifndef CODINI_SOLVER_H
+#define CODINI_SOLVER_H
+
+#include "Command.h"
+#include "LevelDefinitions.h"
+#include "LevelPack.h"
+#include "Model.h"
+#include "ThreadPool.h"
+#include <cstdint>
+#include <vector>
+
+struct SolverOptions {
+    int maxLength = 10;      // Längste untersuchte Programmlänge (in Befehlen)
+    int maxLoopCount = 8;    // Größte Wiederholungsanzahl für LOOP_START
+    int maxNesting = 3;      // Maximale Verschachtelung von Schleifen und Bedingungen
+    int actionBudget = 256;  // Aktionen pro Probelauf
+    bool parallel = false;   // Alle Boxen führen das Programm gleichzeitig aus
+};
+
+struct SolverResult {
+    bool found = false;
+    bool unsolvable = false;       // Nachweislich ohne Lösung, unabhängig von der Länge
+    std::vector<Command> program;  // Kürzeste gefundene Lösung
+    int searchedLength = 0;        // Bis zu dieser Länge wurde vollständig gesucht
+    uint64_t nodesVisited = 0;
+};
+
+/*!
+ * Sucht das kürzeste Programm, das ein Level löst. Die Suche vertieft die Programmlänge
+ * schrittweise (iterative deepening), die erste gefundene Lösung ist also optimal.
+ *
+ * Programme werden nur in kanonischer Form erzeugt (Funktionen vor ihrer Verwendung, keine
+ * sich aufhebenden Drehungen, keine leeren Blöcke). Für abgeschlossene Programmanfänge ohne
+ * Funktionen wird der Spielzustand gehasht; eine Transpositionstabelle verwirft Zustände, die
+ * schon mit mindestens gleich vielen verbleibenden Befehlen untersucht wurden. Die obersten
+ * beiden Suchebenen werden über den ThreadPool verteilt.
+ *
+ * Mit SolverOptions::parallel wird ein gemeinsames Programm für alle Boxen gesucht
+ * (Simulation::loadParallelPrograms). Nach Bedingungen können die Boxen dabei an verschiedenen
+ * Stellen des Programms stehen; solche Anfänge werden nur ausprobiert, aber nicht beschnitten.
+ */
+class Solver {
+public:
+    explicit Solver(ThreadPool& pool, SolverOptions options = {});
+
+    /*!
+     * Löst ein Level aus dem GameModel mit seinen availableCommands.
+     */
+    SolverResult solve(const Level& level);
+
+    /*!
+     * Löst eine Level-Definition mit ihren availableCommands.
+     */
+    SolverResult solve(const LevelDefinition& definition);
+
+    /*!
+     * Löst ein Level aus einem Level-Paket mit seinen availableCommands.
+     */
+    SolverResult solve(const LevelView& view);
+
+private:
+    template<typename LevelT>
+    SolverResult search(const LevelT& level, const std::vector<CommandType>& alphabet);
+
+    ThreadPool& pool_;
+    SolverOptions options_;
+};
+
+#endif //CODINI_SOLVER_H
@@ -0,0 +1,41 @@
+#include "SpatialGrid.h"
+
+void SpatialGrid::resize(int width, int height) {
+    width_ = std::max(width, 0);
+    height_ = std::max(height, 0);
+    for (size_t layer = 0; layer < static_cast<size_t>(Layer::COUNT); layer++) {
+        cells_[layer].assign(static_cast<size_t>(width_ * height_), {});
+        overflow_[layer].clear();
+    }
+}
+
+void SpatialGrid::clear(Layer layer) {
+    // Zellen nur leeren, damit ihr Speicher beim nächsten Level wiederverwendet wird
+    for (auto& cell : cells_[static_cast<size_t>(layer)]) {
+        cell.clear();
+    }
+    overflow_[static_cast<size_t>(layer)].clear();
+}
+
+std::vector<int>* SpatialGrid::cellFor(Layer layer, TilePos tile) {
+    if (tile.x < 0 || tile.x >= width_ || tile.y < 0 || tile.y >= height_) {
+        return nullptr;
+    }
+    return &cells_[static_cast<size_t>(layer)][static_cast<size_t>(tile.y * width_ + tile.x)];
+}
+
+void SpatialGrid::insert(Layer layer, int id, TilePos tile) {
+    std::vector<int>* cell = cellFor(layer, tile);
+    (cell ? *cell : overflow_[static_cast<size_t>(layer)]).push_back(id);
+}
+
+void SpatialGrid::remove(Layer layer, int id, TilePos tile) {
+    std::vector<int>* cell = cellFor(layer, tile);
+    std::vector<int>& entries = cell ? *cell : overflow_[static_cast<size_t>(layer)];
+    auto it = std::find(entries.begin(), entries.end(), id);
+    if (it != entries.end()) {
+        // Reihenfolge innerhalb einer Zelle spielt keine Rolle
+        *it = entries.back();
+        entries.pop_back();
+    }
+}
@@ -0,0 +1,78 @@
+#ifndef CODINI_SPATIAL_GRID_H
+#define CODINI_SPATIAL_GRID_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "TileGrid.h"
+
+/*!
+ * Gleichmäßiges Raster über das Spielfeld mit einer Zelle pro Feld. Jede Zelle merkt sich die
+ * Indizes der Ziele und Levelobjekte auf diesem Feld. Abfragen besuchen nur die Zellen um ein
+ * Feld, der Aufwand hängt also vom Radius ab und nicht von der Anzahl Objekte im Level.
+ *
+ * Die TileGrid-Bitmaske beantwortet, ob etwas auf einem Feld liegt; dieses Raster liefert,
+ * welches Objekt es ist. Felder außerhalb des Rasters landen in einer Überlaufliste, die jede
+ * Abfrage mit prüft.
+ */
+class SpatialGrid {
+public:
+    enum class Layer : uint8_t {
+        TARGET,
+        OBJECT,
+        COUNT
+    };
+
+    /*!
+     * Legt ein leeres Raster mit width × height Zellen an.
+     */
+    void resize(int width, int height);
+
+    /*!
+     * Entfernt alle Einträge einer Ebene.
+     */
+    void clear(Layer layer);
+
+    void insert(Layer layer, int id, TilePos tile);
+    void remove(Layer layer, int id, TilePos tile);
+
+    /*!
+     * Ruft fn(id) für jeden Eintrag einer Ebene auf, der höchstens radius Felder (in x und y)
+     * von center entfernt liegt. Einträge außerhalb des Rasters werden immer übergeben.
+     */
+    template<typename F>
+    void forEachNear(Layer layer, TilePos center, int radius, F&& fn) const {
+        const auto& cells = cells_[static_cast<size_t>(layer)];
+        if (!cells.empty()) {
+            int minX = std::max(center.x - radius, 0);
+            int maxX = std::min(center.x + radius, width_ - 1);
+            int minY = std::max(center.y - radius, 0);
+            int maxY = std::min(center.y + radius, height_ - 1);
+            for (int y = minY; y <= maxY; y++) {
+                for (int x = minX; x <= maxX; x++) {
+                    for (int id : cells[static_cast<size_t>(y * width_ + x)]) {
+                        fn(id);
+                    }
+                }
+            }
+        }
+        for (int id : overflow_[static_cast<size_t>(layer)]) {
+            fn(id);
+        }
+    }
+
+    int getWidth() const { return width_; }
+    int getHeight() const { return height_; }
+
+private:
+    // nullptr, wenn das Feld außerhalb liegt
+    std::vector<int>* cellFor(Layer layer, TilePos tile);
+
+    int width_ = 0;
+    int height_ = 0;
+    std::vector<std::vector<int>> cells_[static_cast<size_t>(Layer::COUNT)];
+    std::vector<int> overflow_[static_cast<size_t>(Layer::COUNT)];
+};
+
+#endif //CODINI_SPATIAL_GRID_H
@@ -0,0 +1,167 @@
+#include "SpriteBatch.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    constexpr float kDegreesToRadians = 3.14159265358979f / 180.0f;
+
+    uint64_t sortKey(const SpriteState& state) {
+        return static_cast<uint64_t>(state.layer) << 40
+               | static_cast<uint64_t>(state.blend) << 32
+               | state.texture;
+    }
+
+    uint32_t textureOf(uint64_t key) { return static_cast<uint32_t>(key); }
+    BlendMode blendOf(uint64_t key) { return static_cast<BlendMode>((key >> 32) & 0xff); }
+}
+
+SpriteBatch::SpriteBatch(GLBackend& backend, size_t capacity)
+        : backend_(backend), capacity_(std::min(std::max<size_t>(capacity, 1), kMaxCapacity)) {
+    queue_.reserve(capacity_);
+    quads_.reserve(capacity_ * 4);
+    upload_.resize(capacity_ * 4);
+
+    // Indizes sind für jedes Quad gleich aufgebaut und ändern sich nie
+    std::vector<uint16_t> indices(capacity_ * 6);
+    for (size_t i = 0; i < capacity_; i++) {
+        auto base = static_cast<uint16_t>(i * 4);
+        uint16_t* quad = &indices[i * 6];
+        quad[0] = base;
+        quad[1] = base + 1;
+        quad[2] = base + 2;
+        quad[3] = base;
+        quad[4] = base + 2;
+        quad[5] = base + 3;
+    }
+
+    vertexArray_ = backend_.createVertexArray();
+    backend_.bindVertexArray(vertexArray_);
+
+    vertexBuffer_ = backend_.createBuffer();
+    backend_.bindBuffer(BufferTarget::VERTEX, vertexBuffer_);
+    backend_.bufferData(BufferTarget::VERTEX, capacity_ * 4 * sizeof(SpriteVertex), nullptr,
+                        BufferUsage::STREAM);
+
+    indexBuffer_ = backend_.createBuffer();
+    backend_.bindBuffer(BufferTarget::INDEX, indexBuffer_);
+    backend_.bufferData(BufferTarget::INDEX, indices.size() * sizeof(uint16_t), indices.data(),
+                        BufferUsage::STATIC);
+
+    backend_.vertexAttribPointer(kPositionLocation, 2, AttribType::FLOAT, false,
+                                 sizeof(SpriteVertex), offsetof(SpriteVertex, x));
+    backend_.enableVertexAttribArray(kPositionLocation);
+    backend_.vertexAttribPointer(kUVLocation, 2, AttribType::FLOAT, false,
+                                 sizeof(SpriteVertex), offsetof(SpriteVertex, u));
+    backend_.enableVertexAttribArray(kUVLocation);
+    backend_.vertexAttribPointer(kColorLocation, 4, AttribType::UNSIGNED_BYTE, true,
+                                 sizeof(SpriteVertex), offsetof(SpriteVertex, color));
+    backend_.enableVertexAttribArray(kColorLocation);
+
+    backend_.bindVertexArray(0);
+}
+
+SpriteBatch::~SpriteBatch() {
+    backend_.deleteBuffer(indexBuffer_);
+    backend_.deleteBuffer(vertexBuffer_);
+    backend_.deleteVertexArray(vertexArray_);
+}
+
+void SpriteBatch::begin() {
+    queue_.clear();
+    quads_.clear();
+    drawCalls_ = 0;
+    spritesDrawn_ = 0;
+}
+
+void SpriteBatch::draw(const SpriteState& state, const Sprite& sprite) {
+    if (queue_.size() == capacity_) {
+        flush();
+    }
+
+    queue_.push_back({sortKey(state), static_cast<uint32_t>(queue_.size())});
+
+    float halfWidth = sprite.width * 0.5f;
+    float halfHeight = sprite.height * 0.5f;
+    float cosR = 1.0f;
+    float sinR = 0.0f;
+    if (sprite.rotation != 0.0f) {
+        cosR = std::cos(sprite.rotation * kDegreesToRadians);
+        sinR = std::sin(sprite.rotation * kDegreesToRadians);
+    }
+
+    // Ecken gegen den Uhrzeigersinn, beginnend oben rechts (wie das Quad in createModels)
+    const float cornersX[4] = {halfWidth, -halfWidth, -halfWidth, halfWidth};
+    const float cornersY[4] = {halfHeight, halfHeight, -halfHeight, -halfHeight};
+    const float u[4] = {sprite.u1, sprite.u0, sprite.u0, sprite.u1};
+    const float v[4] = {sprite.v0, sprite.v0, sprite.v1, sprite.v1};
+    for (int i = 0; i < 4; i++) {
+        quads_.push_back({
+            sprite.x + cornersX[i] * cosR - cornersY[i] * sinR,
+            sprite.y + cornersX[i] * sinR + cornersY[i] * cosR,
+            u[i], v[i],
+            sprite.color
+        });
+    }
+}
+
+void SpriteBatch::end() {
+    flush();
+}
+
+void SpriteBatch::flush() {
+    if (queue_.empty()) {
+        return;
+    }
+
+    std::sort(queue_.begin(), queue_.end(), [](const QueuedSprite& a, const QueuedSprite& b) {
+        return a.key != b.key ? a.key < b.key : a.index < b.index;
+    });
+    for (size_t i = 0; i < queue_.size(); i++) {
+        std::copy_n(&quads_[queue_[i].index * 4], 4, &upload_[i * 4]);
+    }
+
+    backend_.bindVertexArray(vertexArray_);
+    backend_.bindBuffer(BufferTarget::VERTEX, vertexBuffer_);
+    // Puffer verwerfen statt überschreiben, damit der Treiber nicht auf den letzten Frame wartet
+    backend_.bufferData(BufferTarget::VERTEX, capacity_ * 4 * sizeof(SpriteVertex), nullptr,
+                        BufferUsage::STREAM);
+    backend_.bufferSubData(BufferTarget::VERTEX, 0, queue_.size() * 4 * sizeof(SpriteVertex),
+                           upload_.data());
+
+    size_t runStart = 0;
+    bool first = true;
+    uint64_t previousKey = 0;
+    for (size_t i = 1; i <= queue_.size(); i++) {
+        if (i < queue_.size() && queue_[i].key == queue_[runStart].key) {
+            continue;
+        }
+
+        uint64_t key = queue_[runStart].key;
+        if (first || blendOf(key) != blendOf(previousKey)) {
+            backend_.setBlendMode(blendOf(key));
+        }
+        if (first || textureOf(key) != textureOf(previousKey)) {
+            backend_.bindTexture(textureOf(key));
+        }
+        backend_.drawTriangles((i - runStart) * 6, runStart * 6);
+        drawCalls_++;
+
+        first = false;
+        previousKey = key;
+        runStart = i;
+    }
+
+    backend_.bindVertexArray(0);
+
+    spritesDrawn_ += queue_.size();
+    queue_.clear();
+    quads_.clear();
+}
+
+uint32_t SpriteBatch::packColor(float r, float g, float b, float a) {
+    auto toByte = [](float value) {
+        return static_cast<uint32_t>(std::min(std::max(value, 0.0f), 1.0f) * 255.0f + 0.5f);
+    };
+    return toByte(r) | toByte(g) << 8 | toByte(b) << 16 | toByte(a) << 24;
+}
@@ -0,0 +1,96 @@
+#ifndef CODINI_SPRITE_BATCH_H
+#define CODINI_SPRITE_BATCH_H
+
+#include "GLBackend.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Ein texturiertes Rechteck in Weltkoordinaten
+struct Sprite {
+    float x, y;                 // Mittelpunkt
+    float width, height;
+    float rotation = 0.0f;      // Grad
+    float u0 = 0.0f, v0 = 0.0f; // Texturausschnitt
+    float u1 = 1.0f, v1 = 1.0f;
+    uint32_t color = 0xffffffff; // RGBA8, R im niedrigsten Byte
+};
+
+// Render-Zustand eines Sprites; Sprites mit gleichem Zustand landen im selben Draw-Call
+struct SpriteState {
+    uint32_t texture;
+    BlendMode blend = BlendMode::ALPHA;
+    uint8_t layer = 0;  // Niedrigere Ebenen werden zuerst gezeichnet
+};
+
+struct SpriteVertex {
+    float x, y;
+    float u, v;
+    uint32_t color;
+};
+
+/*!
+ * Sammelt die Sprites eines Frames und zeichnet sie mit möglichst wenigen Draw-Calls. Sprites
+ * werden nach Ebene, Blendmodus und Textur sortiert (innerhalb eines Zustands bleibt die
+ * Reihenfolge erhalten), in einem einzigen Upload in einen dauerhaften Vertex-Puffer geschrieben
+ * und pro Zustand mit einem drawTriangles gezeichnet. Der Indexpuffer ist statisch.
+ *
+ * Attribut-Locations: 0 = Position (vec2), 1 = UV (vec2), 2 = Farbe (normalisiertes RGBA8).
+ */
+class SpriteBatch {
+public:
+    static constexpr size_t kDefaultCapacity = 4096;
+    // 16-Bit-Indizes erlauben höchstens 65536 Vertices
+    static constexpr size_t kMaxCapacity = 65536 / 4;
+
+    static constexpr uint32_t kPositionLocation = 0;
+    static constexpr uint32_t kUVLocation = 1;
+    static constexpr uint32_t kColorLocation = 2;
+
+    explicit SpriteBatch(GLBackend& backend, size_t capacity = kDefaultCapacity);
+    ~SpriteBatch();
+
+    SpriteBatch(const SpriteBatch&) = delete;
+    SpriteBatch& operator=(const SpriteBatch&) = delete;
+
+    void begin();
+
+    /*!
+     * Merkt ein Sprite vor. Ist der Batch voll, wird vorher automatisch gezeichnet.
+     */
+    void draw(const SpriteState& state, const Sprite& sprite);
+
+    /*!
+     * Zeichnet alle vorgemerkten Sprites.
+     */
+    void end();
+
+    // Statistik seit dem letzten begin()
+    size_t getDrawCallCount() const { return drawCalls_; }
+    size_t getSpriteCount() const { return spritesDrawn_; }
+
+    static uint32_t packColor(float r, float g, float b, float a);
+
+private:
+    void flush();
+
+    GLBackend& backend_;
+    size_t capacity_;
+    uint32_t vertexArray_ = 0;
+    uint32_t vertexBuffer_ = 0;
+    uint32_t indexBuffer_ = 0;
+
+    // Vorgemerkte Sprites: Sortierschlüssel und vier fertige Vertices pro Sprite
+    struct QueuedSprite {
+        uint64_t key;
+        uint32_t index;
+    };
+    std::vector<QueuedSprite> queue_;
+    std::vector<SpriteVertex> quads_;
+    std::vector<SpriteVertex> upload_;
+
+    size_t drawCalls_ = 0;
+    size_t spritesDrawn_ = 0;
+};
+
+#endif //CODINI_SPRITE_BATCH_H
@@ -0,0 +1,52 @@
+#ifndef CODINI_SPSC_QUEUE_H
+#define CODINI_SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+/*!
+ * Sperrfreie Ringpuffer-Warteschlange für genau einen Erzeuger- und einen Verbraucher-Thread.
+ * Die Kapazität ist eine Zweierpotenz, alle Plätze werden beim Anlegen konstruiert; push und
+ * pop verschieben nur Elemente und allokieren nicht.
+ */
+template<typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    // Nur Erzeuger-Thread. @return false, wenn die Warteschlange voll ist
+    bool tryPush(T&& value) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+        slots_[tail & (Capacity - 1)] = std::move(value);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Nur Verbraucher-Thread. @return false, wenn die Warteschlange leer ist
+    bool tryPop(T& outValue) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        outValue = std::move(slots_[head & (Capacity - 1)]);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Nur als Hinweis gedacht, der Wert kann sofort veraltet sein
+    bool empty() const {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+private:
+    // Getrennte Cache-Zeilen, damit sich Erzeuger und Verbraucher nicht gegenseitig ausbremsen
+    alignas(64) std::atomic<size_t> head_{0};
+    alignas(64) std::atomic<size_t> tail_{0};
+    alignas(64) T slots_[Capacity];
+};
+
+#endif //CODINI_SPSC_QUEUE_H
@@ -0,0 +1,54 @@
+#include "StringTable.h"
+
+#include <mutex>
+
+StringTable::StringTable() {
+    names_.emplace_back();
+    ids_.emplace(names_.back(), kEmptyStringId);
+}
+
+StringTable& StringTable::global() {
+    static StringTable table;
+    return table;
+}
+
+StringId StringTable::intern(std::string_view text) {
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = ids_.find(text);
+        if (it != ids_.end()) {
+            return it->second;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    // Ein anderer Thread kann ihn inzwischen angelegt haben
+    auto it = ids_.find(text);
+    if (it != ids_.end()) {
+        return it->second;
+    }
+    auto id = static_cast<StringId>(names_.size());
+    names_.emplace_back(text);
+    ids_.emplace(names_.back(), id);
+    return id;
+}
+
+bool StringTable::find(std::string_view text, StringId& outId) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = ids_.find(text);
+    if (it == ids_.end()) {
+        return false;
+    }
+    outId = it->second;
+    return true;
+}
+
+std::string_view StringTable::name(StringId id) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return id < names_.size() ? std::string_view(names_[id]) : std::string_view();
+}
+
+size_t StringTable::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return names_.size();
+}
@@ -0,0 +1,73 @@
+#ifndef CODINI_STRING_TABLE_H
+#define CODINI_STRING_TABLE_H
+
+#include <cstdint>
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// Kleine Ganzzahl für eine internierte Zeichenkette, 0 steht für die leere Zeichenkette
+using StringId = uint32_t;
+constexpr StringId kEmptyStringId = 0;
+
+/*!
+ * Interniert Zeichenketten (Texturnamen, Pfade, Befehlsnamen) zu fortlaufenden StringIds.
+ * Gleiche Texte bekommen immer dieselbe Id, über name() kommt der Text zurück. Ids werden beim
+ * Laden vergeben; heiße Pfade (Rendern, Bewerten) vergleichen und hashen danach nur noch Ids.
+ *
+ * Einträge werden nie entfernt, die zurückgegebenen string_views bleiben gültig. Alle
+ * Methoden sind threadsicher, Lesezugriffe laufen parallel.
+ */
+class StringTable {
+public:
+    StringTable();
+
+    // Adressen der Einträge müssen stabil bleiben
+    StringTable(const StringTable&) = delete;
+    StringTable& operator=(const StringTable&) = delete;
+
+    /*!
+     * @return die gemeinsame Tabelle des Spiels
+     */
+    static StringTable& global();
+
+    /*!
+     * @return die Id zum Text, legt ihn bei Bedarf an
+     */
+    StringId intern(std::string_view text);
+
+    /*!
+     * @return die Id zum Text, false wenn er noch nicht interniert wurde
+     */
+    bool find(std::string_view text, StringId& outId) const;
+
+    /*!
+     * @return den Text zur Id, leer bei unbekannter Id
+     */
+    std::string_view name(StringId id) const;
+
+    size_t size() const;
+
+private:
+    mutable std::shared_mutex mutex_;
+    std::deque<std::string> names_;
+    std::unordered_map<std::string_view, StringId> ids_;
+};
+
+/*!
+ * Kurzform für StringTable::global().intern(text).
+ */
+inline StringId intern(std::string_view text) {
+    return StringTable::global().intern(text);
+}
+
+/*!
+ * Kurzform für StringTable::global().name(id).
+ */
+inline std::string_view internedName(StringId id) {
+    return StringTable::global().name(id);
+}
+
+#endif //CODINI_STRING_TABLE_H
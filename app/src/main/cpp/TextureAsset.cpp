@@ -1,20 +1,40 @@
 #include <android/imagedecoder.h>
 #include "TextureAsset.h"
-#include "AndroidOut.h"
+#include "Log.h"
+#include "TextureAtlas.h"
 #include "Utility.h"
 
+#include <cstring>
+
 std::shared_ptr<TextureAsset>
 TextureAsset::loadAsset(AAssetManager *assetManager, const std::string &assetPath) {
+    Image image;
+    if (!decodeAsset(assetManager, assetPath, image)) {
+        return nullptr;
+    }
+    return createFromImage(image);
+}
+
+bool TextureAsset::decodeAsset(AAssetManager *assetManager, const std::string &assetPath,
+                               Image &outImage) {
     // Get the image from asset manager
-    auto pAndroidRobotPng = AAssetManager_open(
+    auto pAsset = AAssetManager_open(
             assetManager,
             assetPath.c_str(),
             AASSET_MODE_BUFFER);
+    if (!pAsset) {
+        LOG_E("Missing texture asset {}", assetPath);
+        return false;
+    }
 
     // Make a decoder to turn it into a texture
     AImageDecoder *pAndroidDecoder = nullptr;
-    auto result = AImageDecoder_createFromAAsset(pAndroidRobotPng, &pAndroidDecoder);
-    assert(result == ANDROID_IMAGE_DECODER_SUCCESS);
+    auto result = AImageDecoder_createFromAAsset(pAsset, &pAndroidDecoder);
+    if (result != ANDROID_IMAGE_DECODER_SUCCESS) {
+        LOG_E("Failed to decode {}", assetPath);
+        AAsset_close(pAsset);
+        return false;
+    }
 
     // make sure we get 8 bits per channel out. RGBA order.
     AImageDecoder_setAndroidBitmapFormat(pAndroidDecoder, ANDROID_BITMAP_FORMAT_RGBA_8888);
@@ -29,14 +49,37 @@ TextureAsset::loadAsset(AAssetManager *assetManager, const std::string &assetPat
     auto stride = AImageDecoder_getMinimumStride(pAndroidDecoder);
 
     // Get the bitmap data of the image
-    auto upAndroidImageData = std::make_unique<std::vector<uint8_t>>(height * stride);
+    std::vector<uint8_t> imageData(height * stride);
     auto decodeResult = AImageDecoder_decodeImage(
             pAndroidDecoder,
-            upAndroidImageData->data(),
+            imageData.data(),
             stride,
-            upAndroidImageData->size());
-    assert(decodeResult == ANDROID_IMAGE_DECODER_SUCCESS);
+            imageData.size());
+
+    // cleanup helpers
+    AImageDecoder_delete(pAndroidDecoder);
+    AAsset_close(pAsset);
+
+    if (decodeResult != ANDROID_IMAGE_DECODER_SUCCESS) {
+        LOG_E("Failed to decode {}", assetPath);
+        return false;
+    }
 
+    outImage.width = width;
+    outImage.height = height;
+    if (stride == size_t(width) * 4) {
+        outImage.pixels = std::move(imageData);
+    } else {
+        // Zeilenauffüllung entfernen
+        outImage.pixels.resize(size_t(width) * height * 4);
+        for (int y = 0; y < height; y++) {
+            std::memcpy(&outImage.pixels[size_t(y) * width * 4], &imageData[y * stride], width * 4);
+        }
+    }
+    return true;
+}
+
+std::shared_ptr<TextureAsset> TextureAsset::createFromImage(const Image &image) {
     // Get an opengl texture
     GLuint textureId;
     glGenTextures(1, &textureId);
@@ -54,21 +97,17 @@ TextureAsset::loadAsset(AAssetManager *assetManager, const std::string &assetPat
             GL_TEXTURE_2D, // target
             0, // mip level
             GL_RGBA, // internal format, often advisable to use BGR
-            width, // width of the texture
-            height, // height of the texture
+            image.width, // width of the texture
+            image.height, // height of the texture
             0, // border (always 0)
             GL_RGBA, // format
             GL_UNSIGNED_BYTE, // type
-            upAndroidImageData->data() // Data to upload
+            image.pixels.data() // Data to upload
     );
 
     // generate mip levels. Not really needed for 2D, but good to do
     glGenerateMipmap(GL_TEXTURE_2D);
 
-    // cleanup helpers
-    AImageDecoder_delete(pAndroidDecoder);
-    AAsset_close(pAndroidRobotPng);
-
     // Create a shared pointer so it can be cleaned up easily/automatically
     return std::shared_ptr<TextureAsset>(new TextureAsset(textureId));
 }
@@ -77,4 +116,4 @@ TextureAsset::~TextureAsset() {
     // return texture resources
     glDeleteTextures(1, &textureID_);
     textureID_ = 0;
-}
\ No newline at end of file
+}
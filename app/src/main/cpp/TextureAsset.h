@@ -7,6 +7,8 @@
 #include <string>
 #include <vector>
 
+struct Image;
+
 class TextureAsset {
 public:
     /*!
@@ -18,6 +20,17 @@ public:
     static std::shared_ptr<TextureAsset>
     loadAsset(AAssetManager *assetManager, const std::string &assetPath);
 
+    /*!
+     * Decodes an image from the assets/ directory into RGBA8 without touching OpenGL
+     * @return false if the asset is missing or can't be decoded
+     */
+    static bool decodeAsset(AAssetManager *assetManager, const std::string &assetPath, Image &outImage);
+
+    /*!
+     * Uploads a decoded image as a mipmapped texture, must be called on the GL thread
+     */
+    static std::shared_ptr<TextureAsset> createFromImage(const Image &image);
+
     ~TextureAsset();
 
     /*!
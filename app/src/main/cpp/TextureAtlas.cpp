@@ -0,0 +1,139 @@
+#include "TextureAtlas.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+    int nextPowerOfTwo(int value) {
+        int result = 1;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+}
+
+const AtlasRegion* AtlasLayout::find(const std::string& name) const {
+    for (const auto& region : regions) {
+        if (region.name == name) {
+            return &region;
+        }
+    }
+    return nullptr;
+}
+
+bool AtlasPacker::pack(const std::vector<AtlasEntry>& entries, int maxSize, int padding,
+                       AtlasLayout& layout) {
+    // Höchste Bilder zuerst, bei gleicher Höhe nach Name, damit das Ergebnis stabil ist
+    std::vector<size_t> order(entries.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&entries](size_t a, size_t b) {
+        if (entries[a].height != entries[b].height) {
+            return entries[a].height > entries[b].height;
+        }
+        return entries[a].name < entries[b].name;
+    });
+
+    long long area = 0;
+    int widest = 1;
+    int tallest = 1;
+    for (const auto& entry : entries) {
+        int paddedWidth = entry.width + 2 * padding;
+        int paddedHeight = entry.height + 2 * padding;
+        area += static_cast<long long>(paddedWidth) * paddedHeight;
+        widest = std::max(widest, paddedWidth);
+        tallest = std::max(tallest, paddedHeight);
+    }
+
+    // Kleinster Atlas, in den die Fläche überhaupt passen kann
+    int width = nextPowerOfTwo(std::max(widest, static_cast<int>(std::ceil(std::sqrt(double(area))))));
+    int height = nextPowerOfTwo(std::max(tallest, static_cast<int>((area + width - 1) / width)));
+    while (width <= maxSize && height <= maxSize) {
+        if (tryPack(entries, order, width, height, padding, layout)) {
+            return true;
+        }
+        // Abwechselnd breiter und höher werden
+        if (width <= height) {
+            width *= 2;
+        } else {
+            height *= 2;
+        }
+    }
+    return false;
+}
+
+bool AtlasPacker::tryPack(const std::vector<AtlasEntry>& entries, const std::vector<size_t>& order,
+                          int width, int height, int padding, AtlasLayout& layout) {
+    layout.width = width;
+    layout.height = height;
+    layout.padding = padding;
+    layout.regions.assign(entries.size(), AtlasRegion{});
+
+    int shelfX = 0;
+    int shelfY = 0;
+    int shelfHeight = 0;
+    for (size_t index : order) {
+        const AtlasEntry& entry = entries[index];
+        int paddedWidth = entry.width + 2 * padding;
+        int paddedHeight = entry.height + 2 * padding;
+
+        if (shelfX + paddedWidth > width) {
+            // Neue Zeile
+            shelfY += shelfHeight;
+            shelfX = 0;
+            shelfHeight = 0;
+        }
+        if (paddedWidth > width || shelfY + paddedHeight > height) {
+            return false;
+        }
+
+        AtlasRegion& region = layout.regions[index];
+        region.name = entry.name;
+        region.x = shelfX + padding;
+        region.y = shelfY + padding;
+        region.width = entry.width;
+        region.height = entry.height;
+        region.u0 = float(region.x) / width;
+        region.v0 = float(region.y) / height;
+        region.u1 = float(region.x + region.width) / width;
+        region.v1 = float(region.y + region.height) / height;
+
+        shelfX += paddedWidth;
+        shelfHeight = std::max(shelfHeight, paddedHeight);
+    }
+    return true;
+}
+
+Image AtlasPacker::compose(const AtlasLayout& layout, const std::vector<const Image*>& images) {
+    Image atlas;
+    atlas.width = layout.width;
+    atlas.height = layout.height;
+    atlas.pixels.assign(size_t(layout.width) * layout.height * 4, 0);
+
+    const int padding = layout.padding;
+    for (size_t i = 0; i < layout.regions.size() && i < images.size(); i++) {
+        const AtlasRegion& region = layout.regions[i];
+        const Image* image = images[i];
+        if (!image || image->width != region.width || image->height != region.height
+            || region.width == 0 || region.height == 0) {
+            continue;
+        }
+
+        // Bild samt Rand kopieren, Randpixel werden aus der nächsten Bildkante genommen
+        for (int y = -padding; y < region.height + padding; y++) {
+            int sourceY = std::min(std::max(y, 0), region.height - 1);
+            uint8_t* row = &atlas.pixels[(size_t(region.y + y) * layout.width + region.x) * 4];
+            const uint8_t* sourceRow = &image->pixels[size_t(sourceY) * image->width * 4];
+
+            std::memcpy(row, sourceRow, size_t(region.width) * 4);
+            for (int x = 1; x <= padding; x++) {
+                std::memcpy(row - x * 4, sourceRow, 4);
+                std::memcpy(row + (region.width - 1 + x) * 4, sourceRow + (region.width - 1) * 4, 4);
+            }
+        }
+    }
+    return atlas;
+}
@@ -0,0 +1,69 @@
+#ifndef CODINI_TEXTURE_ATLAS_H
+#define CODINI_TEXTURE_ATLAS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Dekodiertes Bild, RGBA8 ohne Zeilenauffüllung, erste Zeile oben
+struct Image {
+    int width = 0;
+    int height = 0;
+    std::vector<uint8_t> pixels;
+};
+
+// Ein Bild, das in den Atlas soll
+struct AtlasEntry {
+    std::string name;
+    int width;
+    int height;
+};
+
+// Lage eines Bildes im Atlas, in Pixeln und als UV-Koordinaten
+struct AtlasRegion {
+    std::string name;
+    int x, y;
+    int width, height;
+    float u0, v0;
+    float u1, v1;
+};
+
+struct AtlasLayout {
+    int width = 0;
+    int height = 0;
+    int padding = 0;
+    std::vector<AtlasRegion> regions;  // Gleiche Reihenfolge wie die Einträge beim Packen
+
+    /*!
+     * @return die Region zum Namen oder nullptr
+     */
+    const AtlasRegion* find(const std::string& name) const;
+};
+
+/*!
+ * Packt Bilder zeilenweise (Shelf-Verfahren, nach Höhe sortiert) in einen möglichst kleinen Atlas
+ * mit Zweierpotenz-Kanten. Zwischen den Bildern bleibt ein Rand, der beim Zusammensetzen mit den
+ * Randpixeln aufgefüllt wird, damit lineare Filterung und Mipmaps nicht ins Nachbarbild bluten.
+ */
+class AtlasPacker {
+public:
+    static constexpr int kDefaultPadding = 2;
+
+    /*!
+     * @param maxSize größte erlaubte Kantenlänge (z.B. GL_MAX_TEXTURE_SIZE)
+     * @return false, wenn die Bilder nicht in maxSize x maxSize passen
+     */
+    static bool pack(const std::vector<AtlasEntry>& entries, int maxSize, int padding,
+                     AtlasLayout& layout);
+
+    /*!
+     * Setzt den Atlas zusammen. images[i] gehört zu layout.regions[i] und muss dessen Größe haben.
+     */
+    static Image compose(const AtlasLayout& layout, const std::vector<const Image*>& images);
+
+private:
+    static bool tryPack(const std::vector<AtlasEntry>& entries, const std::vector<size_t>& order,
+                        int width, int height, int padding, AtlasLayout& layout);
+};
+
+#endif //CODINI_TEXTURE_ATLAS_H
@@ -0,0 +1,115 @@
+#include "TextureCache.h"
+
+#include "Log.h"
+#include "ParticleSystem.h"
+
+TextureCache::TextureCache(AAssetManager* assetManager, AssetLoader& loader, int maxAtlasSize)
+        : assetManager_(assetManager), loader_(loader), maxAtlasSize_(maxAtlasSize) {}
+
+std::shared_ptr<TextureAsset> TextureCache::get(StringId name) {
+    auto it = textures_.find(name);
+    if (it == textures_.end()) {
+        // Auch fehlgeschlagene Ladeversuche merken, damit nicht jeder Frame neu dekodiert
+        std::string path(internedName(name));
+        it = textures_.emplace(name, TextureAsset::loadAsset(assetManager_, path)).first;
+    }
+    return it->second;
+}
+
+TextureRegion TextureCache::region(StringId name) {
+    TextureRegion result;
+    if (activeAtlas_) {
+        if (!activeAtlas_->handle.isDone()) {
+            // Atlas lädt noch, nicht nebenbei synchron dekodieren
+            result.texture = 0;
+            return result;
+        }
+        auto it = activeAtlas_->regionIndex.find(name);
+        if (activeAtlas_->texture && it != activeAtlas_->regionIndex.end()) {
+            const AtlasRegion& region = activeAtlas_->layout.regions[it->second];
+            result.texture = activeAtlas_->texture->getTextureID();
+            result.u0 = region.u0;
+            result.v0 = region.v0;
+            result.u1 = region.u1;
+            result.v1 = region.v1;
+            return result;
+        }
+    }
+
+    auto texture = get(name);
+    result.texture = texture ? texture->getTextureID() : 0;
+    return result;
+}
+
+AssetHandle TextureCache::preloadTheme(const Theme& theme) {
+    auto it = atlases_.find(theme.type);
+    if (it != atlases_.end()) {
+        return it->second.handle;
+    }
+
+    Atlas& atlas = atlases_[theme.type];
+    auto build = std::make_shared<AtlasBuild>();
+    AAssetManager* assetManager = assetManager_;
+    std::vector<StringId> names = atlasContents(theme);
+    int maxAtlasSize = maxAtlasSize_;
+    ThemeType type = theme.type;
+
+    atlas.handle = loader_.load(
+            [assetManager, names, maxAtlasSize, build]() {
+                return buildAtlas(assetManager, names, maxAtlasSize, *build);
+            },
+            [this, type, build]() {
+                // atlases_ wird nur auf dem Render-Thread verändert, die Map-Knoten bleiben stabil
+                Atlas& target = atlases_[type];
+                target.texture = TextureAsset::createFromImage(build->image);
+                target.layout = std::move(build->layout);
+                target.regionIndex = std::move(build->regionIndex);
+                build->image = Image{};
+            });
+    return atlas.handle;
+}
+
+void TextureCache::useTheme(const Theme& theme) {
+    preloadTheme(theme);
+    activeAtlas_ = &atlases_[theme.type];
+}
+
+std::vector<StringId> TextureCache::atlasContents(const Theme& theme) {
+    std::vector<StringId> names = {theme.backgroundTexture, theme.boxTexture, theme.targetTexture};
+    names.insert(names.end(), theme.decorativeElements.begin(), theme.decorativeElements.end());
+    for (size_t t = 0; t < static_cast<size_t>(ParticleTexture::COUNT); t++) {
+        names.push_back(particleTextureId(static_cast<ParticleTexture>(t)));
+    }
+    return names;
+}
+
+bool TextureCache::buildAtlas(AAssetManager* assetManager, const std::vector<StringId>& names,
+                              int maxAtlasSize, AtlasBuild& build) {
+    std::vector<AtlasEntry> entries;
+    std::vector<Image> images;
+    for (const auto& name : names) {
+        Image image;
+        std::string path(internedName(name));
+        if (build.regionIndex.count(name) || !TextureAsset::decodeAsset(assetManager, path, image)) {
+            continue;
+        }
+        build.regionIndex[name] = entries.size();
+        entries.push_back({path, image.width, image.height});
+        images.push_back(std::move(image));
+    }
+    if (entries.empty()) {
+        return false;
+    }
+
+    if (!AtlasPacker::pack(entries, maxAtlasSize, AtlasPacker::kDefaultPadding, build.layout)) {
+        LOG_W("Theme textures don't fit into a {} atlas", maxAtlasSize);
+        return false;
+    }
+
+    std::vector<const Image*> imagePointers;
+    for (const auto& image : images) {
+        imagePointers.push_back(&image);
+    }
+    build.image = AtlasPacker::compose(build.layout, imagePointers);
+    return true;
+}
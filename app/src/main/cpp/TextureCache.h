@@ -0,0 +1,92 @@
+#ifndef CODINI_TEXTURE_CACHE_H
+#define CODINI_TEXTURE_CACHE_H
+
+#include <android/asset_manager.h>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "AssetLoader.h"
+#include "Model.h"
+#include "StringTable.h"
+#include "TextureAsset.h"
+#include "TextureAtlas.h"
+
+// Texturausschnitt für ein Sprite
+struct TextureRegion {
+    uint32_t texture = 0;
+    float u0 = 0.0f, v0 = 0.0f;
+    float u1 = 1.0f, v1 = 1.0f;
+};
+
+/*!
+ * Lädt jede Textur genau einmal und baut pro Theme einen Atlas aus Hintergrund, Box, Ziel,
+ * Dekorationen und Partikeln. Solange ein Theme aktiv ist, liefern alle seine Bilder dieselbe
+ * GL-Textur, der SpriteBatch muss also nicht mehr zwischen Texturen wechseln. Bilder außerhalb
+ * des Atlas (oder wenn er nicht in maxAtlasSize passt) kommen als Einzeltextur aus dem Cache.
+ *
+ * Atlanten werden über den AssetLoader gebaut: Dekodieren und Packen auf dem Worker, nur der
+ * Upload auf dem Render-Thread. Solange der Atlas des aktiven Themes lädt, liefert region()
+ * Ausschnitte ohne Textur (texture == 0), die der Renderer überspringt.
+ */
+class TextureCache {
+public:
+    TextureCache(AAssetManager* assetManager, AssetLoader& loader, int maxAtlasSize = 2048);
+
+    /*!
+     * @return die Textur zum internierten Asset-Namen, nullptr wenn sie nicht geladen werden kann
+     */
+    std::shared_ptr<TextureAsset> get(StringId name);
+
+    /*!
+     * @return den Ausschnitt zum internierten Asset-Namen, bevorzugt aus dem Atlas des aktiven
+     *         Themes
+     */
+    TextureRegion region(StringId name);
+
+    /*!
+     * Startet den Bau des Atlas eines Themes im Hintergrund, falls er noch nicht existiert.
+     * @return Handle zum Abfragen des Ladezustands
+     */
+    AssetHandle preloadTheme(const Theme& theme);
+
+    /*!
+     * Aktiviert den Atlas eines Themes, lädt ihn bei Bedarf nach.
+     */
+    void useTheme(const Theme& theme);
+
+    /*!
+     * @return alle Bilder, die in den Atlas eines Themes gehören
+     */
+    static std::vector<StringId> atlasContents(const Theme& theme);
+
+private:
+    struct Atlas {
+        AssetHandle handle;
+        std::shared_ptr<TextureAsset> texture;  // nullptr, solange er lädt oder wenn er nicht passt
+        AtlasLayout layout;
+        std::unordered_map<StringId, size_t> regionIndex;
+    };
+
+    // Ergebnis des Workers, wird beim Upload in den Atlas übernommen
+    struct AtlasBuild {
+        AtlasLayout layout;
+        std::unordered_map<StringId, size_t> regionIndex;
+        Image image;
+    };
+
+    static bool buildAtlas(AAssetManager* assetManager, const std::vector<StringId>& names,
+                           int maxAtlasSize, AtlasBuild& build);
+
+    AAssetManager* assetManager_;
+    AssetLoader& loader_;
+    int maxAtlasSize_;
+    std::unordered_map<StringId, std::shared_ptr<TextureAsset>> textures_;
+    std::map<ThemeType, Atlas> atlases_;
+    const Atlas* activeAtlas_ = nullptr;
+};
+
+#endif //CODINI_TEXTURE_CACHE_H
@@ -0,0 +1,146 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(unsigned threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    for (unsigned i = 0; i < threadCount; i++) {
+        ranges_.push_back(std::make_unique<WorkRange>());
+    }
+
+    // Worker 0 ist der aufrufende Thread
+    for (unsigned i = 1; i < threadCount; i++) {
+        threads_.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(jobMutex_);
+        shuttingDown_ = true;
+    }
+    jobStart_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, size_t grain, const RangeFunction& fn) {
+    if (count == 0) {
+        return;
+    }
+
+    // Bereich gleichmäßig vorverteilen, den Rest regelt das Stehlen
+    const size_t workers = ranges_.size();
+    for (size_t i = 0; i < workers; i++) {
+        std::lock_guard<std::mutex> lock(ranges_[i]->mutex);
+        ranges_[i]->begin = count * i / workers;
+        ranges_[i]->end = count * (i + 1) / workers;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(jobMutex_);
+        job_ = &fn;
+        grain_ = std::max<size_t>(1, grain);
+        busyWorkers_ = static_cast<unsigned>(threads_.size());
+        generation_++;
+    }
+    jobStart_.notify_all();
+
+    runWorker(0);
+
+    std::unique_lock<std::mutex> lock(jobMutex_);
+    jobDone_.wait(lock, [this] { return busyWorkers_ == 0; });
+    job_ = nullptr;
+}
+
+void ThreadPool::workerLoop(unsigned worker) {
+    unsigned seenGeneration = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(jobMutex_);
+            jobStart_.wait(lock, [&] {
+                return shuttingDown_ || generation_ != seenGeneration;
+            });
+            if (shuttingDown_) {
+                return;
+            }
+            seenGeneration = generation_;
+        }
+
+        runWorker(worker);
+
+        std::lock_guard<std::mutex> lock(jobMutex_);
+        if (--busyWorkers_ == 0) {
+            jobDone_.notify_one();
+        }
+    }
+}
+
+void ThreadPool::runWorker(unsigned worker) {
+    size_t begin;
+    size_t end;
+    do {
+        while (takeChunk(worker, begin, end)) {
+            (*job_)(begin, end, worker);
+        }
+    } while (steal(worker));
+}
+
+bool ThreadPool::takeChunk(unsigned worker, size_t& begin, size_t& end) {
+    WorkRange& range = *ranges_[worker];
+    std::lock_guard<std::mutex> lock(range.mutex);
+    if (range.begin >= range.end) {
+        return false;
+    }
+    begin = range.begin;
+    end = std::min(range.end, range.begin + grain_);
+    range.begin = end;
+    return true;
+}
+
+bool ThreadPool::steal(unsigned thief) {
+    for (;;) {
+        // Opfer mit dem größten Restbereich suchen
+        size_t victim = ranges_.size();
+        size_t victimSize = 0;
+        for (size_t i = 0; i < ranges_.size(); i++) {
+            if (i == thief) {
+                continue;
+            }
+            std::lock_guard<std::mutex> lock(ranges_[i]->mutex);
+            size_t size = ranges_[i]->end - ranges_[i]->begin;
+            if (size > victimSize) {
+                victim = i;
+                victimSize = size;
+            }
+        }
+        if (victimSize == 0) {
+            return false; // Alles verteilt
+        }
+
+        // Hintere Hälfte übernehmen
+        size_t begin;
+        size_t end;
+        {
+            WorkRange& range = *ranges_[victim];
+            std::lock_guard<std::mutex> lock(range.mutex);
+            size_t remaining = range.end - range.begin;
+            if (remaining == 0) {
+                continue; // Inzwischen leer, neues Opfer suchen
+            }
+            end = range.end;
+            begin = range.end - (remaining - remaining / 2);
+            range.end = begin;
+        }
+
+        WorkRange& own = *ranges_[thief];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        own.begin = begin;
+        own.end = end;
+        return true;
+    }
+}
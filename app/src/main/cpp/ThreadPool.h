@@ -0,0 +1,70 @@
+#ifndef CODINI_THREAD_POOL_H
+#define CODINI_THREAD_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*!
+ * Thread-Pool mit Work-Stealing für Stapelverarbeitung (Bewertung, Solver, Benchmarks).
+ *
+ * parallelFor() verteilt einen Indexbereich gleichmäßig auf die Worker. Jeder Worker arbeitet
+ * seinen Bereich in kleinen Stücken von vorn ab; ist er fertig, stiehlt er die hintere Hälfte
+ * des größten verbleibenden Bereichs eines anderen Workers. Ungleich teure Aufgaben gleichen
+ * sich so aus, ohne dass pro Aufgabe Speicher allokiert wird.
+ */
+class ThreadPool {
+public:
+    // Arbeitsfunktion für den Bereich [begin, end) auf Worker worker
+    using RangeFunction = std::function<void(size_t begin, size_t end, unsigned worker)>;
+
+    /*!
+     * @param threadCount Anzahl Worker, 0 = Anzahl Hardware-Threads
+     */
+    explicit ThreadPool(unsigned threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /*!
+     * Führt fn für alle Indizes in [0, count) aus und kehrt zurück, wenn alles erledigt ist.
+     * Der aufrufende Thread arbeitet als Worker 0 mit.
+     *
+     * @param grain Größe der Stücke, die ein Worker auf einmal übernimmt
+     */
+    void parallelFor(size_t count, size_t grain, const RangeFunction& fn);
+
+    unsigned getWorkerCount() const { return static_cast<unsigned>(ranges_.size()); }
+
+private:
+    // Noch nicht abgearbeiteter Bereich eines Workers
+    struct alignas(64) WorkRange {
+        std::mutex mutex;
+        size_t begin = 0;
+        size_t end = 0;
+    };
+
+    void workerLoop(unsigned worker);
+    void runWorker(unsigned worker);
+    bool takeChunk(unsigned worker, size_t& begin, size_t& end);
+    bool steal(unsigned thief);
+
+    std::vector<std::unique_ptr<WorkRange>> ranges_;
+    std::vector<std::thread> threads_;
+
+    std::mutex jobMutex_;
+    std::condition_variable jobStart_;
+    std::condition_variable jobDone_;
+    const RangeFunction* job_ = nullptr;
+    size_t grain_ = 1;
+    unsigned generation_ = 0;
+    unsigned busyWorkers_ = 0;
+    bool shuttingDown_ = false;
+};
+
+#endif //CODINI_THREAD_POOL_H
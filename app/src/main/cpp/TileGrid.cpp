@@ -0,0 +1,36 @@
+#include "TileGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+Direction directionFromRotation(float degrees) {
+    long quarter = std::lround(degrees / 90.0f);
+    return static_cast<Direction>(((quarter % 4) + 4) % 4);
+}
+
+TilePos tileFromPosition(const Position& position) {
+    return {static_cast<int>(std::lround(position.x)), static_cast<int>(std::lround(position.y))};
+}
+
+uint16_t Tile::flagFor(LevelObject::Type type, bool isActive) {
+    switch (type) {
+        case LevelObject::Type::WALL: return WALL;
+        case LevelObject::Type::BRIDGE: return BRIDGE;
+        case LevelObject::Type::SWITCH: return SWITCH;
+        case LevelObject::Type::DOOR: return isActive ? DOOR_OPEN : DOOR;
+        case LevelObject::Type::ITEM: return ITEM;
+        case LevelObject::Type::TELEPORTER: return TELEPORTER;
+        case LevelObject::Type::OBSTACLE: return OBSTACLE;
+    }
+    return 0;
+}
+
+void TileGrid::resize(int width, int height) {
+    width_ = width > 0 ? width : 0;
+    height_ = height > 0 ? height : 0;
+    tiles_.assign(static_cast<size_t>(width_ * height_), 0);
+}
+
+void TileGrid::clear() {
+    std::fill(tiles_.begin(), tiles_.end(), 0);
+}
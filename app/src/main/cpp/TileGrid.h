@@ -0,0 +1,144 @@
+#ifndef CODINI_TILE_GRID_H
+#define CODINI_TILE_GRID_H
+
+#include <cstdint>
+#include <vector>
+
+#include "LevelDefinitions.h"
+#include "Model.h"
+
+// Blickrichtung einer Box, im Uhrzeigersinn ab +x (Rotation 0°, 90°, 180°, 270°)
+enum class Direction : uint8_t {
+    EAST,   // +x
+    SOUTH,  // +y
+    WEST,   // -x
+    NORTH   // -y
+};
+
+inline Direction turnLeft(Direction direction) {
+    return static_cast<Direction>((static_cast<uint8_t>(direction) + 3) & 3);
+}
+
+inline Direction turnRight(Direction direction) {
+    return static_cast<Direction>((static_cast<uint8_t>(direction) + 1) & 3);
+}
+
+inline int directionX(Direction direction) {
+    static constexpr int kX[] = {1, 0, -1, 0};
+    return kX[static_cast<uint8_t>(direction)];
+}
+
+inline int directionY(Direction direction) {
+    static constexpr int kY[] = {0, 1, 0, -1};
+    return kY[static_cast<uint8_t>(direction)];
+}
+
+/*!
+ * @return die Richtung zu einer Rotation in Grad, auf die nächste Vierteldrehung gerundet
+ */
+Direction directionFromRotation(float degrees);
+
+/*!
+ * @return die Rotation einer Richtung in Grad (0, 90, 180 oder 270), nur fürs Rendern
+ */
+inline float rotationOf(Direction direction) {
+    return 90.0f * static_cast<float>(static_cast<uint8_t>(direction));
+}
+
+// Feld im Spielfeld
+struct TilePos {
+    int x = 0;
+    int y = 0;
+
+    TilePos offset(Direction direction, int distance) const {
+        return {x + directionX(direction) * distance, y + directionY(direction) * distance};
+    }
+
+    bool operator==(const TilePos& other) const { return x == other.x && y == other.y; }
+    bool operator!=(const TilePos& other) const { return !(*this == other); }
+};
+
+/*!
+ * @return das Feld, auf das eine Position gerundet wird
+ */
+TilePos tileFromPosition(const Position& position);
+
+/*!
+ * @return die Position eines Feldes, nur fürs Rendern und Animieren
+ */
+inline Position positionOf(TilePos tile) {
+    return {static_cast<float>(tile.x), static_cast<float>(tile.y)};
+}
+
+// Inhalt eines Feldes als Bitmaske
+namespace Tile {
+    enum Flag : uint16_t {
+        WALL       = 1 << 0,
+        BRIDGE     = 1 << 1,
+        DOOR       = 1 << 2,  // Geschlossene Tür
+        DOOR_OPEN  = 1 << 3,  // Offene Tür
+        SWITCH     = 1 << 4,
+        ITEM       = 1 << 5,
+        TELEPORTER = 1 << 6,
+        OBSTACLE   = 1 << 7,
+        BOX        = 1 << 8,
+        TARGET     = 1 << 9
+    };
+
+    /*!
+     * @return das Bit zu einem Levelobjekt, für Türen abhängig davon, ob sie offen ist
+     */
+    uint16_t flagFor(LevelObject::Type type, bool isActive);
+}
+
+/*!
+ * Spielfeld als Raster ganzzahliger Felder mit einer Bitmaske pro Feld. Die Simulation hält
+ * hier fest, was auf jedem Feld liegt, damit Regeln wie "ist das Feld frei" oder "steht hier
+ * eine Box" ein einzelner Speicherzugriff sind. Felder außerhalb des Rasters sind leer.
+ */
+class TileGrid {
+public:
+    void resize(int width, int height);
+
+    /*!
+     * Löscht alle Bits, die Größe bleibt.
+     */
+    void clear();
+
+    int getWidth() const { return width_; }
+    int getHeight() const { return height_; }
+
+    bool contains(TilePos tile) const {
+        return tile.x >= 0 && tile.x < width_ && tile.y >= 0 && tile.y < height_;
+    }
+
+    uint16_t flags(TilePos tile) const {
+        return contains(tile) ? tiles_[index(tile)] : 0;
+    }
+
+    bool has(TilePos tile, uint16_t mask) const { return (flags(tile) & mask) != 0; }
+
+    void set(TilePos tile, uint16_t mask) {
+        if (contains(tile)) tiles_[index(tile)] |= mask;
+    }
+
+    void unset(TilePos tile, uint16_t mask) {
+        if (contains(tile)) tiles_[index(tile)] &= static_cast<uint16_t>(~mask);
+    }
+
+    /*!
+     * @return true, wenn eine Wand, ein Hindernis, eine geschlossene Tür oder eine Box im Feld ist
+     */
+    bool isBlocked(TilePos tile) const {
+        return has(tile, Tile::WALL | Tile::OBSTACLE | Tile::DOOR | Tile::BOX);
+    }
+
+private:
+    size_t index(TilePos tile) const { return static_cast<size_t>(tile.y * width_ + tile.x); }
+
+    int width_ = 0;
+    int height_ = 0;
+    std::vector<uint16_t> tiles_;
+};
+
+#endif //CODINI_TILE_GRID_H
@@ -0,0 +1,143 @@
+#include "Tween.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    constexpr int kSamples = 256;  // Stützstellen pro Kurve, dazu der Endpunkt
+
+    float easeOutBack(float t) {
+        const float c1 = 1.70158f;
+        const float c3 = c1 + 1.0f;
+        float u = t - 1.0f;
+        return 1.0f + c3 * u * u * u + c1 * u * u;
+    }
+
+    float evaluate(Easing easing, float t) {
+        switch (easing) {
+            case Easing::LINEAR:
+                return t;
+            case Easing::IN_OUT_QUAD:
+                return t < 0.5f ? 2.0f * t * t : -1.0f + (4.0f - 2.0f * t) * t;
+            case Easing::OUT_QUAD:
+                return 1.0f - (1.0f - t) * (1.0f - t);
+            case Easing::OUT_BACK:
+                return easeOutBack(t);
+            case Easing::IN_EXPO:
+                return std::exp2(10.0f * t - 10.0f);
+            case Easing::OUT_EXPO:
+                return 1.0f - std::exp2(-10.0f * t);
+            case Easing::IN_OUT_EXPO:
+                return t < 0.5f ? std::exp2(20.0f * t - 10.0f) / 2.0f
+                                : (2.0f - std::exp2(-20.0f * t + 10.0f)) / 2.0f;
+            case Easing::JUMP_ARC: {
+                // Höhe folgt dem überschwingenden Vorwärtsweg, die Landung wird weicher
+                float height = std::sin(easeOutBack(t) * static_cast<float>(M_PI));
+                return 1.0f - (1.0f - height) * (1.0f - height);
+            }
+            case Easing::COUNT:
+                break;
+        }
+        return t;
+    }
+
+    struct EasingTables {
+        float values[static_cast<size_t>(Easing::COUNT)][kSamples + 1];
+
+        EasingTables() {
+            for (size_t curve = 0; curve < static_cast<size_t>(Easing::COUNT); curve++) {
+                auto easing = static_cast<Easing>(curve);
+                for (int i = 0; i <= kSamples; i++) {
+                    values[curve][i] = evaluate(easing, static_cast<float>(i) / kSamples);
+                }
+                // Exponentialkurven erreichen 0 bzw. 1 nur asymptotisch, der Bogen endet am Boden
+                values[curve][0] = 0.0f;
+                values[curve][kSamples] = easing == Easing::JUMP_ARC ? 0.0f : 1.0f;
+            }
+        }
+    };
+
+    const EasingTables& easingTables() {
+        static const EasingTables tables;
+        return tables;
+    }
+}
+
+float ease(Easing easing, float t) {
+    const float* table = easingTables().values[static_cast<size_t>(easing)];
+    float x = std::min(std::max(t, 0.0f), 1.0f) * kSamples;
+    int i = std::min(static_cast<int>(x), kSamples - 1);
+    float fraction = x - static_cast<float>(i);
+    return table[i] + (table[i + 1] - table[i]) * fraction;
+}
+
+TweenSystem::TweenSystem() {
+    tracks_.reserve(kCapacity);
+    cues_.reserve(kCapacity);
+    easingTables();
+}
+
+bool TweenSystem::animate(uint16_t object, TweenProperty property, float from, float to,
+                          float duration, Easing easing, float delay, TweenCue cue) {
+    if (tracks_.size() == kCapacity) {
+        return false;
+    }
+    tracks_.push_back({object, property, easing, cue, from, to, -delay,
+                       duration > 0.0f ? 1.0f / duration : 0.0f});
+    return true;
+}
+
+void TweenSystem::update(float deltaTime, GameObject* objects, size_t count) {
+    cues_.clear();
+
+    // Fertige Spuren beim Durchlauf nach vorne zusammenschieben, die Reihenfolge bleibt erhalten
+    size_t kept = 0;
+    for (size_t i = 0; i < tracks_.size(); i++) {
+        TweenTrack track = tracks_[i];
+        if (track.object >= count) {
+            continue;
+        }
+
+        track.time += deltaTime;
+        if (track.time < 0.0f) {
+            tracks_[kept++] = track;
+            continue;
+        }
+
+        float progress = track.inverseDuration > 0.0f
+                         ? std::min(track.time * track.inverseDuration, 1.0f) : 1.0f;
+        float value = track.from + (track.to - track.from) * ease(track.easing, progress);
+        set(objects[track.object], track.property, value);
+
+        bool finished = progress >= 1.0f;
+        if (track.cue != TweenCue::NONE) {
+            cues_.push_back({track.object, track.cue, progress, finished});
+        }
+        if (!finished) {
+            tracks_[kept++] = track;
+        }
+    }
+    tracks_.resize(kept);
+}
+
+void TweenSystem::clear() {
+    tracks_.clear();
+    cues_.clear();
+}
+
+bool TweenSystem::isAnimating(uint16_t object) const {
+    return std::any_of(tracks_.begin(), tracks_.end(), [object](const TweenTrack& track) {
+        return track.object == object;
+    });
+}
+
+void TweenSystem::set(GameObject& object, TweenProperty property, float value) {
+    switch (property) {
+        case TweenProperty::POSITION_X: object.position.x = value; break;
+        case TweenProperty::POSITION_Y: object.position.y = value; break;
+        case TweenProperty::POSITION_Z: object.position.z = value; break;
+        case TweenProperty::ROTATION: object.rotation = value; break;
+        case TweenProperty::SCALE: object.scale = value; break;
+        case TweenProperty::ALPHA: object.alpha = value; break;
+    }
+}
@@ -0,0 +1,115 @@
+#ifndef CODINI_TWEEN_H
+#define CODINI_TWEEN_H
+
+#include "Model.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Easing-Kurven, alle bilden 0..1 auf einen Wert ab, der bei 0 beginnt
+enum class Easing : uint8_t {
+    LINEAR,
+    IN_OUT_QUAD,
+    OUT_QUAD,
+    OUT_BACK,       // Schießt leicht über das Ziel hinaus
+    IN_EXPO,
+    OUT_EXPO,
+    IN_OUT_EXPO,
+    JUMP_ARC,       // 0 -> 1 -> 0, Höhe eines Sprungs über OUT_BACK
+    COUNT
+};
+
+/*!
+ * @return den Kurvenwert an der Stelle t (0..1) aus der vorberechneten Tabelle, linear
+ *         zwischen den Stützstellen interpoliert. Die Endpunkte sind exakt.
+ */
+float ease(Easing easing, float t);
+
+// Animierbare Eigenschaft eines GameObject
+enum class TweenProperty : uint8_t {
+    POSITION_X,
+    POSITION_Y,
+    POSITION_Z,
+    ROTATION,
+    SCALE,
+    ALPHA
+};
+
+// Ereignis, das eine Spur während ihres Laufs meldet, ausgewertet vom Aufrufer (Partikel, Sounds)
+enum class TweenCue : uint8_t {
+    NONE,
+    JUMP_DUST,
+    TELEPORT_TRAIL,
+    TELEPORT_ARRIVE
+};
+
+/*!
+ * Eine Spur animiert eine Eigenschaft eines Objekts von from nach to. Reine Daten: das Objekt
+ * ist ein Index in das bei update() übergebene Array, keine Referenz.
+ */
+struct TweenTrack {
+    uint16_t object;
+    TweenProperty property;
+    Easing easing;
+    TweenCue cue;
+    float from;
+    float to;
+    float time;             // Sekunden seit Start, negativ während der Verzögerung
+    float inverseDuration;  // 0 = Sprung direkt auf to
+};
+
+struct TweenCueEvent {
+    uint16_t object;
+    TweenCue cue;
+    float progress;         // Fortschritt der Spur (0..1) nach diesem Schritt
+    bool finished;
+};
+
+/*!
+ * Pool für Animationsspuren mit fester Kapazität. Beliebig viele Spuren laufen gleichzeitig, auch
+ * auf verschiedenen Objekten; update() bearbeitet alle in einer Schleife und allokiert nach dem
+ * Konstruktor nichts mehr. Laufen zwei Spuren auf derselben Eigenschaft, gewinnt die später
+ * hinzugefügte, fertige Spuren werden ohne Änderung der Reihenfolge entfernt.
+ */
+class TweenSystem {
+public:
+    static constexpr size_t kCapacity = 256;
+
+    TweenSystem();
+
+    /*!
+     * Startet eine Spur nach delay Sekunden. Vor dem Start wird die Eigenschaft nicht verändert.
+     * @return false, wenn der Pool voll ist; die Spur entfällt dann
+     */
+    bool animate(uint16_t object, TweenProperty property, float from, float to, float duration,
+                 Easing easing, float delay = 0.0f, TweenCue cue = TweenCue::NONE);
+
+    /*!
+     * Schreibt alle gestarteten Spuren in objects. Spuren auf Objekten außerhalb von count
+     * werden verworfen. Gemeldete Ereignisse stehen danach in getCues().
+     */
+    void update(float deltaTime, GameObject* objects, size_t count);
+
+    const std::vector<TweenCueEvent>& getCues() const { return cues_; }
+
+    /*!
+     * Bricht alle Spuren ab, die Eigenschaften bleiben auf ihrem aktuellen Wert.
+     */
+    void clear();
+
+    bool empty() const { return tracks_.empty(); }
+    size_t size() const { return tracks_.size(); }
+
+    /*!
+     * @return ob für das Objekt noch eine Spur läuft oder wartet
+     */
+    bool isAnimating(uint16_t object) const;
+
+    static void set(GameObject& object, TweenProperty property, float value);
+
+private:
+    std::vector<TweenTrack> tracks_;
+    std::vector<TweenCueEvent> cues_;
+};
+
+#endif //CODINI_TWEEN_H
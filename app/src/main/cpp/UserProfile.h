@@ -0,0 +1,23 @@
+#ifndef CODINI_USER_PROFILE_H
+#define CODINI_USER_PROFILE_H
+
+#include <ctime>
+#include <map>
+#include <string>
+
+struct UserProgress {
+    int currentLevel;
+    int totalScore;
+    std::map<int, int> levelScores;  // Level-Nummer -> Punkte
+    std::map<int, int> levelStars;   // Level-Nummer -> Anzahl Sterne (1-3)
+    std::time_t lastPlayTime;
+};
+
+struct UserProfile {
+    std::string username;
+    std::string passwordHash;  // SHA-256 Hash wird verwendet
+    UserProgress progress;
+    bool isLoggedIn;           // Nur zur Laufzeit, wird nicht gespeichert
+};
+
+#endif //CODINI_USER_PROFILE_H
@@ -0,0 +1,32 @@
+#include "UserRegistry.h"
+
+#include <functional>
+#include <vector>
+
+size_t UserRegistry::shardIndex(std::string_view username) {
+    // Obere Bits, die unteren nimmt die Tabelle im Shard für ihre Buckets
+    size_t hash = std::hash<std::string_view>()(username);
+    return (hash >> (sizeof(size_t) * 8 - 8)) % kShardCount;
+}
+
+void UserRegistry::reset(std::map<std::string, UserProfile> users) {
+    std::vector<Table> tables(kShardCount);
+    for (auto& user : users) {
+        auto entry = std::make_shared<Entry>(std::make_shared<const UserProfile>(std::move(user.second)));
+        std::string_view key = entry->username;
+        tables[shardIndex(key)].emplace(key, std::move(entry));
+    }
+
+    for (size_t i = 0; i < kShardCount; i++) {
+        std::lock_guard<std::mutex> lock(shards_[i].writeMutex);
+        std::atomic_store(&shards_[i].table, std::shared_ptr<const Table>(
+                std::make_shared<Table>(std::move(tables[i]))));
+    }
+    size_.store(users.size(), std::memory_order_relaxed);
+}
+
+UserRegistry::Handle UserRegistry::find(std::string_view username) const {
+    std::shared_ptr<const Table> table = std::atomic_load(&shards_[shardIndex(username)].table);
+    auto it = table->find(username);
+    return it != table->end() ? Handle(it->second) : Handle();
+}
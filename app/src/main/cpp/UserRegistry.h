@@ -0,0 +1,172 @@
+#ifndef CODINI_USER_REGISTRY_H
+#define CODINI_USER_REGISTRY_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+#include "UserProfile.h"
+
+/*!
+ * Threadsicheres Verzeichnis aller Benutzerprofile (Klassenzimmer-Modus: viele Anmeldungen auf
+ * einem Gerät, ein Sync-Thread schreibt Punkte, die Bestenliste liest).
+ *
+ * Lesen nach dem RCU-Prinzip: Jedes Profil ist ein unveränderlicher Stand hinter einem
+ * shared_ptr. Leser holen sich den aktuellen Stand ohne Sperre und behalten ihn, solange sie
+ * ihn brauchen; Schreiber kopieren ihn, ändern die Kopie und veröffentlichen sie atomar. Der
+ * alte Stand verschwindet, wenn der letzte Leser ihn loslässt.
+ *
+ * Die Namenstabelle ist auf kShardCount Teile verteilt, die ebenso ersetzt statt geändert
+ * werden. Schreiber sperren nur ihren Teil bzw. ihr Profil, Leser nie.
+ *
+ * Handles bleiben gültig, egal was sonst eingefügt wird.
+ */
+class UserRegistry {
+    struct Entry {
+        explicit Entry(std::shared_ptr<const UserProfile> initial)
+                : username(initial->username), profile(std::move(initial)) {}
+
+        const std::string username;
+        std::mutex writeMutex;                         // Serialisiert Schreiber dieses Profils
+        std::shared_ptr<const UserProfile> profile;    // Nur über std::atomic_load/atomic_store
+    };
+
+public:
+    static constexpr size_t kShardCount = 16;
+
+    /*!
+     * Stabiler Verweis auf einen Benutzer.
+     */
+    class Handle {
+    public:
+        Handle() = default;
+
+        bool isValid() const { return entry_ != nullptr; }
+        const std::string& getUsername() const { return entry_->username; }
+
+        /*!
+         * @return den aktuellen Stand; er ändert sich nicht mehr, auch wenn jemand schreibt
+         */
+        std::shared_ptr<const UserProfile> read() const {
+            return std::atomic_load(&entry_->profile);
+        }
+
+        bool operator==(const Handle& other) const { return entry_ == other.entry_; }
+
+    private:
+        friend class UserRegistry;
+        explicit Handle(std::shared_ptr<Entry> entry) : entry_(std::move(entry)) {}
+
+        std::shared_ptr<Entry> entry_;
+    };
+
+    /*!
+     * Ersetzt alle Profile, z.B. nach dem Laden aus dem ProgressStore.
+     */
+    void reset(std::map<std::string, UserProfile> users);
+
+    /*!
+     * @return ein ungültiges Handle, wenn es den Namen schon gibt
+     */
+    Handle insert(const UserProfile& profile) {
+        return insert(profile, [](const UserProfile&) {});
+    }
+
+    /*!
+     * Wie insert(profile), published(const UserProfile&) läuft aber noch unter der Schreibsperre
+     * des neuen Profils, siehe update. Nur aufgerufen, wenn das Profil eingefügt wurde.
+     */
+    template<typename Published>
+    Handle insert(const UserProfile& profile, Published&& published) {
+        Shard& shard = shards_[shardIndex(profile.username)];
+        std::lock_guard<std::mutex> lock(shard.writeMutex);
+
+        std::shared_ptr<const Table> current = std::atomic_load(&shard.table);
+        if (current->count(profile.username) != 0) {
+            return Handle();
+        }
+
+        // Kopieren statt ändern: Leser der alten Tabelle laufen ungestört weiter. Das Profil ist
+        // gesperrt, bis published fertig ist, damit kein update ihm zuvorkommt.
+        auto entry = std::make_shared<Entry>(std::make_shared<const UserProfile>(profile));
+        std::lock_guard<std::mutex> entryLock(entry->writeMutex);
+        auto next = std::make_shared<Table>(*current);
+        next->emplace(std::string_view(entry->username), entry);
+        std::atomic_store(&shard.table, std::shared_ptr<const Table>(std::move(next)));
+        size_.fetch_add(1, std::memory_order_relaxed);
+        published(*entry->profile);
+        return Handle(std::move(entry));
+    }
+
+    Handle find(std::string_view username) const;
+
+    /*!
+     * Ändert ein Profil: mutate bekommt eine Kopie des aktuellen Stands, danach wird die Kopie
+     * veröffentlicht. Der Name darf nicht geändert werden.
+     * @return den neuen Stand
+     */
+    template<typename Mutate>
+    std::shared_ptr<const UserProfile> update(const Handle& handle, Mutate&& mutate) {
+        return update(handle, std::forward<Mutate>(mutate), [](const UserProfile&) {});
+    }
+
+    /*!
+     * Wie update(handle, mutate), danach läuft published(const UserProfile&) mit dem neuen Stand
+     * noch unter der Schreibsperre des Profils. Was dort nachgezogen wird (Bestenliste,
+     * Speicher), sieht die Stände eines Profils so in derselben Reihenfolge wie die Registry.
+     * published darf die Registry nicht ändern.
+     */
+    template<typename Mutate, typename Published>
+    std::shared_ptr<const UserProfile> update(const Handle& handle, Mutate&& mutate,
+                                              Published&& published) {
+        Entry& entry = *handle.entry_;
+        std::lock_guard<std::mutex> lock(entry.writeMutex);
+        auto next = std::make_shared<UserProfile>(*std::atomic_load(&entry.profile));
+        mutate(*next);
+        next->username = entry.username;
+        std::shared_ptr<const UserProfile> result = std::move(next);
+        std::atomic_store(&entry.profile, result);
+        published(*result);
+        return result;
+    }
+
+    /*!
+     * Ruft visit(const UserProfile&) für jeden Benutzer auf, ohne Sperre. Gleichzeitige
+     * Änderungen sind je Profil entweder ganz oder gar nicht zu sehen.
+     */
+    template<typename Visit>
+    void forEach(Visit&& visit) const {
+        for (const Shard& shard : shards_) {
+            std::shared_ptr<const Table> table = std::atomic_load(&shard.table);
+            for (const auto& entry : *table) {
+                std::shared_ptr<const UserProfile> profile = std::atomic_load(&entry.second->profile);
+                visit(*profile);
+            }
+        }
+    }
+
+    size_t size() const { return size_.load(std::memory_order_relaxed); }
+
+private:
+    // Schlüssel zeigen auf Entry::username, der so lange lebt wie der Eintrag
+    using Table = std::unordered_map<std::string_view, std::shared_ptr<Entry>>;
+
+    struct alignas(64) Shard {
+        std::mutex writeMutex;
+        std::shared_ptr<const Table> table = std::make_shared<const Table>();  // atomic_load/store
+    };
+
+    static size_t shardIndex(std::string_view username);
+
+    std::array<Shard, kShardCount> shards_;
+    std::atomic<size_t> size_{0};
+};
+
+#endif //CODINI_USER_REGISTRY_H
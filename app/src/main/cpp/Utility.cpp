@@ -1,15 +1,15 @@
 #include "Utility.h"
-#include "AndroidOut.h"
+#include "Log.h"
 
 #include <GLES3/gl3.h>
 
-#define CHECK_ERROR(e) case e: aout << "GL Error: "#e << std::endl; break;
+#define CHECK_ERROR(e) case e: LOG_E("GL Error: "#e); break;
 
 bool Utility::checkAndLogGlError(bool alwaysLog) {
     GLenum error = glGetError();
     if (error == GL_NO_ERROR) {
         if (alwaysLog) {
-            aout << "No GL error" << std::endl;
+            LOG_D("No GL error");
         }
         return true;
     } else {
@@ -20,7 +20,7 @@ bool Utility::checkAndLogGlError(bool alwaysLog) {
             CHECK_ERROR(GL_INVALID_FRAMEBUFFER_OPERATION);
             CHECK_ERROR(GL_OUT_OF_MEMORY);
             default:
-                aout << "Unknown GL error: " << error << std::endl;
+                LOG_E("Unknown GL error: {}", error);
         }
         return false;
     }
@@ -0,0 +1,76 @@
+#include "WavDecoder.h"
+
+#include <cstring>
+
+namespace {
+    uint16_t readU16(const uint8_t* data) {
+        return static_cast<uint16_t>(data[0] | data[1] << 8);
+    }
+
+    uint32_t readU32(const uint8_t* data) {
+        return static_cast<uint32_t>(data[0]) | static_cast<uint32_t>(data[1]) << 8
+               | static_cast<uint32_t>(data[2]) << 16 | static_cast<uint32_t>(data[3]) << 24;
+    }
+
+    constexpr uint16_t kFormatPCM = 1;
+}
+
+bool decodeWav(const uint8_t* data, size_t size, Sound& outSound) {
+    if (size < 12 || std::memcmp(data, "RIFF", 4) != 0 || std::memcmp(data + 8, "WAVE", 4) != 0) {
+        return false;
+    }
+
+    uint16_t channels = 0;
+    uint16_t bitsPerSample = 0;
+    uint32_t sampleRate = 0;
+    bool haveFormat = false;
+
+    // Chunks durchlaufen, unbekannte (LIST, fact, ...) überspringen
+    size_t offset = 12;
+    while (offset + 8 <= size) {
+        const uint8_t* chunk = data + offset;
+        uint32_t chunkSize = readU32(chunk + 4);
+        const uint8_t* body = chunk + 8;
+        size_t available = size - offset - 8;
+
+        if (std::memcmp(chunk, "fmt ", 4) == 0) {
+            if (chunkSize < 16 || available < 16) {
+                return false;
+            }
+            uint16_t format = readU16(body);
+            channels = readU16(body + 2);
+            sampleRate = readU32(body + 4);
+            bitsPerSample = readU16(body + 14);
+            if (format != kFormatPCM || channels < 1 || channels > 2
+                || (bitsPerSample != 8 && bitsPerSample != 16) || sampleRate == 0) {
+                return false;
+            }
+            haveFormat = true;
+        } else if (std::memcmp(chunk, "data", 4) == 0) {
+            if (!haveFormat) {
+                return false;
+            }
+            // Abgeschnittene Dateien bis zum vorhandenen Ende lesen
+            size_t bytes = chunkSize < available ? chunkSize : available;
+            size_t bytesPerSample = bitsPerSample / 8;
+            size_t sampleCount = bytes / bytesPerSample / channels * channels;
+
+            outSound.sampleRate = static_cast<int>(sampleRate);
+            outSound.channels = channels;
+            outSound.samples.resize(sampleCount);
+            for (size_t i = 0; i < sampleCount; i++) {
+                if (bitsPerSample == 16) {
+                    outSound.samples[i] = static_cast<int16_t>(readU16(body + i * 2));
+                } else {
+                    // 8 Bit ist vorzeichenlos mit Nullpunkt 128
+                    outSound.samples[i] = static_cast<int16_t>((body[i] - 128) << 8);
+                }
+            }
+            return true;
+        }
+
+        // Chunks sind auf gerade Längen aufgefüllt
+        offset += 8 + static_cast<size_t>(chunkSize) + (chunkSize & 1u);
+    }
+    return false;
+}
@@ -0,0 +1,23 @@
+#ifndef CODINI_WAV_DECODER_H
+#define CODINI_WAV_DECODER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Dekodierter Sound, 16-Bit-PCM, Kanäle verschränkt
+struct Sound {
+    int sampleRate = 0;
+    int channels = 0;
+    std::vector<int16_t> samples;
+
+    size_t getFrameCount() const { return channels > 0 ? samples.size() / channels : 0; }
+};
+
+/*!
+ * Dekodiert eine WAV-Datei (RIFF, unkomprimiertes PCM mit 8 oder 16 Bit, ein oder zwei Kanäle).
+ * @return false bei anderen Formaten oder beschädigten Daten
+ */
+bool decodeWav(const uint8_t* data, size_t size, Sound& outSound);
+
+#endif //CODINI_WAV_DECODER_H
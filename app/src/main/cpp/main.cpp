@@ -1,7 +1,7 @@
 #include <jni.h>
 
-#include "AndroidOut.h"
 #include "Game.h"
+#include "Log.h"
 
 #include <game-activity/GameActivity.cpp>
 #include <game-text-input/gametextinput.cpp>
@@ -27,8 +27,11 @@ void handle_cmd(android_app *pApp, int32_t cmd) {
             if (pApp->userData) {
                 auto *pGame = reinterpret_cast<Game *>(pApp->userData);
                 pApp->userData = nullptr;
+                pGame->flushProgress();
                 delete pGame;
             }
+            // Der Prozess kann danach ohne Vorwarnung enden, gepufferte Logzeilen jetzt schreiben
+            Logger::global().flush();
             break;
         default:
             break;
@@ -55,7 +58,7 @@ bool motion_event_filter_func(const GameActivityMotionEvent *motionEvent) {
  */
 void android_main(struct android_app *pApp) {
     // Can be removed, useful to ensure your code is running
-    aout << "Welcome to android_main" << std::endl;
+    LOG_I("Welcome to android_main");
 
     // Register an event handler for Android events
     pApp->onAppCmd = handle_cmd;
@@ -84,7 +87,7 @@ void android_main(struct android_app *pApp) {
                     done = true;
                     break;
                 case ALOOPER_EVENT_ERROR:
-                    aout << "ALooper_pollOnce returned an error" << std::endl;
+                    LOG_E("ALooper_pollOnce returned an error");
                     break;
                 case ALOOPER_POLL_CALLBACK:
                     break;
@@ -98,18 +101,23 @@ void android_main(struct android_app *pApp) {
         // Spielzustand aktualisieren wenn Game-Instanz existiert
         if (pApp->userData) {
             auto *pGame = reinterpret_cast<Game *>(pApp->userData);
+
+            // Gesammelte Touch-Ereignisse vor dem Frame an das Spiel geben
+            if (auto *inputBuffer = android_app_swap_input_buffers(pApp)) {
+                for (uint64_t i = 0; i < inputBuffer->motionEventsCount; i++) {
+                    pGame->handleInput(&inputBuffer->motionEvents[i]);
+                }
+                android_app_clear_motion_events(inputBuffer);
+            }
             
-            // Delta-Zeit für Animation und Spiellogik berechnen
-            static auto lastFrameTime = std::chrono::high_resolution_clock::now();
-            auto currentTime = std::chrono::high_resolution_clock::now();
-            float deltaTime = std::chrono::duration<float>(currentTime - lastFrameTime).count();
+            // Vergangene Echtzeit messen, die Simulation läuft davon unabhängig in festen Schritten
+            static auto lastFrameTime = std::chrono::steady_clock::now();
+            auto currentTime = std::chrono::steady_clock::now();
+            float frameSeconds = std::chrono::duration<float>(currentTime - lastFrameTime).count();
             lastFrameTime = currentTime;
 
-            // Spiellogik aktualisieren
-            pGame->update(deltaTime);
-
-            // Frame rendern
-            pGame->render();
+            // Feste Simulationsschritte ausführen und interpoliert rendern
+            pGame->runFrame(frameSeconds);
         }
     } while (!pApp->destroyRequested);
 }
@@ -117,7 +125,7 @@ void android_main(struct android_app *pApp) {
 // JNI fonksiyonları MainActivity için
 JNIEXPORT void JNICALL
 Java_com_example_codini_MainActivity_nativeInit(JNIEnv *env, jobject thiz) {
-    aout << "Native init called" << std::endl;
+    LOG_I("Native init called");
 }
 
 JNIEXPORT void JNICALL
@@ -127,24 +135,32 @@ Java_com_example_codini_MainActivity_nativeRender(JNIEnv *env, jobject thiz) {
 
 JNIEXPORT void JNICALL
 Java_com_example_codini_MainActivity_nativeOnSurfaceCreated(JNIEnv *env, jobject thiz) {
-    aout << "Surface created" << std::endl;
+    LOG_I("Surface created");
 }
 
 JNIEXPORT void JNICALL
 Java_com_example_codini_MainActivity_nativeOnSurfaceChanged(JNIEnv *env, jobject thiz, jint width, jint height) {
-    aout << "Surface changed: " << width << "x" << height << std::endl;
+    LOG_I("Surface changed: {}x{}", width, height);
 }
 
 JNIEXPORT void JNICALL
 Java_com_example_codini_MainActivity_nativeOnTouch(JNIEnv *env, jobject thiz, jfloat x, jfloat y) {
-    aout << "Touch event: " << x << ", " << y << std::endl;
+    LOG_V("Touch event: {}, {}", x, y);
 }
 
 JNIEXPORT void JNICALL
 Java_com_example_codini_MainActivity_executeCommand(JNIEnv *env, jobject thiz, jstring command) {
     const char *commandStr = env->GetStringUTFChars(command, nullptr);
-    aout << "Execute command: " << commandStr << std::endl;
+    // Ab hier nur noch der Befehlstyp, der Text wird nicht weitergereicht
+    Command parsed{CommandType::MOVE_FORWARD};
+    bool known = parseCommand(commandStr, parsed);
     env->ReleaseStringUTFChars(command, commandStr);
+
+    if (known) {
+        LOG_D("Execute command: {}", commandName(parsed.type));
+    } else {
+        LOG_W("Unknown command");
+    }
 }
 
 }
\ No newline at end of file
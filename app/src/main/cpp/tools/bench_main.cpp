@@ -0,0 +1,383 @@
+// Misst die heißen Pfade des Spielkerns: Interpreter, Partikel, Kollisionsabfragen, Laden von
+// Leveln und Punktewertung. Jeder Wert ist die beste Zeit pro Operation aus mehreren Durchläufen,
+// kleiner ist besser.
+//
+// Aufruf: codini_bench [--baseline Datei] [--save Datei] [--tolerance Anteil] [--filter Text]
+//                      [--levels Paket]
+// Ausgabe: CSV auf stdout (name,unit,value,baseline,change,status), Fortschritt auf stderr.
+// Die Ausgabe eines Laufs dient direkt als Baseline für spätere Läufe, --save schreibt sie
+// zusätzlich in eine Datei. Endcode 1, wenn ein Wert mehr als tolerance (Standard 0.25) über der
+// Baseline liegt.
+//
+// Die Werte gelten nur für den Rechner, auf dem sie gemessen wurden, deshalb liegt keine
+// Baseline im Repository. Im Build-Verzeichnis vor einer Änderung
+//     cmake --build . --target codini_bench_baseline
+// und danach
+//     cmake --build . --target codini_bench_check
+
+#include "Grader.h"
+#include "LevelPack.h"
+#include "ParticleBuffer.h"
+#include "Random.h"
+#include "Simulation.h"
+#include "SpatialGrid.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Bester von mehreren Durchläufen, damit Takthochlauf und Störungen nicht mitgemessen werden
+template<typename Function>
+double bestOf(int runs, Function&& function) {
+    double best = 1e30;
+    for (int run = 0; run < runs; run++) {
+        Clock::time_point start = Clock::now();
+        function();
+        best = std::min(best, secondsSince(start));
+    }
+    return best;
+}
+
+struct BenchResult {
+    std::string name;
+    const char* unit;
+    double value;
+};
+
+class Bench {
+public:
+    explicit Bench(std::string filter) : filter_(std::move(filter)) {}
+
+    bool wants(const std::string& name) const {
+        return filter_.empty() || name.find(filter_) != std::string::npos;
+    }
+
+    void add(const std::string& name, const char* unit, double value) {
+        std::fprintf(stderr, "%-36s %12.2f %s\n", name.c_str(), value, unit);
+        results_.push_back({name, unit, value});
+    }
+
+    const std::vector<BenchResult>& getResults() const { return results_; }
+
+private:
+    std::string filter_;
+    std::vector<BenchResult> results_;
+};
+
+volatile uint64_t sink = 0;
+
+// Programme mit vielen Schleifendurchläufen, die Box bleibt auf dem Feld und erreicht kein Ziel
+void benchInterpreter(Bench& bench) {
+    const struct {
+        const char* name;
+        const char* program;
+    } programs[] = {
+        {"turns", "LOOP_START:999 LOOP_START:50 TURN_LEFT TURN_RIGHT LOOP_END LOOP_END"},
+        {"moves", "LOOP_START:999 LOOP_START:50 MOVE_FORWARD MOVE_BACKWARD LOOP_END LOOP_END"},
+        {"nested", "LOOP_START:999 LOOP_START:99 TURN_LEFT LOOP_END MOVE_FORWARD MOVE_BACKWARD LOOP_END"},
+        {"calls", "FUNCTION_DEF:1 IF_PATH_AHEAD MOVE_FORWARD MOVE_BACKWARD IF_END TURN_LEFT "
+                  "FUNCTION_END LOOP_START:999 LOOP_START:30 FUNCTION_CALL:1 LOOP_END LOOP_END"},
+    };
+
+    GameModel model;
+    Level level = model.createLevel(1);
+    Simulation simulation;
+    simulation.loadLevel(level);
+    for (const auto& entry : programs) {
+        std::string name = std::string("interpreter/") + entry.name;
+        if (!bench.wants(name)) {
+            continue;
+        }
+        std::vector<Command> program;
+        if (!parseProgram(entry.program, program) || !simulation.loadProgram(program)) {
+            std::fprintf(stderr, "%s: Programm ungültig\n", name.c_str());
+            continue;
+        }
+        int actions = 0;
+        double seconds = bestOf(5, [&] {
+            simulation.reset();
+            actions = simulation.run(1 << 24).actionsExecuted;
+        });
+        sink = sink + simulation.stateHash();
+        bench.add(name, "ns/action", seconds * 1e9 / std::max(actions, 1));
+    }
+}
+
+void benchParticles(Bench& bench) {
+    const float deltaTime = 1.0f / 60.0f;
+    for (size_t count : {256, 1024, 4096, 16384}) {
+        std::string name = "particles/update_" + std::to_string(count);
+        if (!bench.wants(name)) {
+            continue;
+        }
+
+        // Lange Lebenszeit, damit die Anzahl während der Messung konstant bleibt
+        FastRandom random(count);
+        ParticleBuffer buffer;
+        buffer.reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            buffer.push(Particle{{random.range(0.f, 8.f), random.range(0.f, 8.f)},
+                                 {random.range(-1.f, 1.f), random.range(-1.f, 1.f)},
+                                 0.0f, random.range(-90.f, 90.f), 1.0f, 1e6f, 1e6f,
+                                 {1.0f, 1.0f, 1.0f}, 1.0f});
+        }
+        const int frames = static_cast<int>(std::max<size_t>(1, (1 << 22) / count));
+        double seconds = bestOf(5, [&] {
+            for (int frame = 0; frame < frames; frame++) {
+                updateParticles(buffer, deltaTime);
+            }
+        });
+        sink = sink + buffer.size();
+        bench.add(name, "ns/particle", seconds * 1e9 / (static_cast<double>(frames) * count));
+    }
+}
+
+// Abfragen im Radius 1 um zufällige Felder, das Raster ist so groß, dass die Dichte gleich bleibt
+void benchCollision(Bench& bench) {
+    for (int count : {16, 256, 4096}) {
+        std::string name = "collision/query_" + std::to_string(count);
+        if (!bench.wants(name)) {
+            continue;
+        }
+
+        int side = 9;
+        while (side * side < count * 2) {
+            side *= 2;
+        }
+        FastRandom random(static_cast<uint64_t>(count));
+        SpatialGrid grid;
+        grid.resize(side, side);
+        for (int id = 0; id < count; id++) {
+            grid.insert(SpatialGrid::Layer::OBJECT, id,
+                        TilePos{random.rangeInt(0, side - 1), random.rangeInt(0, side - 1)});
+        }
+        std::vector<TilePos> centers(4096);
+        for (auto& center : centers) {
+            center = TilePos{random.rangeInt(0, side - 1), random.rangeInt(0, side - 1)};
+        }
+
+        const int rounds = 64;
+        double seconds = bestOf(5, [&] {
+            uint64_t found = 0;
+            for (int round = 0; round < rounds; round++) {
+                for (const auto& center : centers) {
+                    grid.forEachNear(SpatialGrid::Layer::OBJECT, center, 1,
+                                     [&found](int id) { found += static_cast<uint64_t>(id); });
+                }
+            }
+            sink = sink + found;
+        });
+        bench.add(name, "ns/query", seconds * 1e9 / (static_cast<double>(rounds) * centers.size()));
+    }
+}
+
+void benchLevelLoad(Bench& bench, const std::string& packPath) {
+    if (bench.wants("level/create_and_load")) {
+        GameModel model;
+        Simulation simulation;
+        const int rounds = 1000;
+        double seconds = bestOf(5, [&] {
+            for (int round = 0; round < rounds; round++) {
+                Level level = model.createLevel(round % 3 + 1, static_cast<uint64_t>(round));
+                simulation.loadLevel(level);
+            }
+        });
+        sink = sink + simulation.stateHash();
+        bench.add("level/create_and_load", "us/level", seconds * 1e6 / rounds);
+    }
+
+    if (bench.wants("level/pack_open")) {
+        LevelPack pack;
+        std::string error;
+        const int rounds = 200;
+        bool opened = true;
+        double seconds = bestOf(5, [&] {
+            for (int round = 0; round < rounds && opened; round++) {
+                opened = pack.openFile(packPath, &error);
+            }
+        });
+        if (opened) {
+            bench.add("level/pack_open", "us/open", seconds * 1e6 / rounds);
+        } else {
+            std::fprintf(stderr, "%s: %s\n", packPath.c_str(), error.c_str());
+        }
+    }
+
+    if (bench.wants("level/pack_load")) {
+        LevelPack pack;
+        std::string error;
+        if (!pack.openFile(packPath, &error)) {
+            std::fprintf(stderr, "%s: %s\n", packPath.c_str(), error.c_str());
+            return;
+        }
+        std::vector<int> numbers = pack.getLevelNumbers();
+        Simulation simulation;
+        const int rounds = 1000;
+        double seconds = bestOf(5, [&] {
+            for (int round = 0; round < rounds; round++) {
+                LevelView view;
+                if (pack.find(numbers[static_cast<size_t>(round) % numbers.size()], view)) {
+                    simulation.loadLevel(view);
+                }
+            }
+        });
+        sink = sink + simulation.stateHash();
+        bench.add("level/pack_load", "us/level", seconds * 1e6 / rounds);
+    }
+}
+
+void benchScoring(Bench& bench) {
+    GameModel model;
+    Level level = model.createLevel(2);
+
+    if (bench.wants("score/solution")) {
+        const int rounds = 1 << 20;
+        double seconds = bestOf(5, [&] {
+            int total = 0;
+            for (int round = 0; round < rounds; round++) {
+                total += GameModel::scoreSolution(level, round & 15, static_cast<float>(round & 63)).score;
+            }
+            sink = sink + static_cast<uint64_t>(total);
+        });
+        bench.add("score/solution", "ns/score", seconds * 1e9 / rounds);
+    }
+
+    // Bewertung ganzer Einreichungen auf einem Thread: übersetzen, ausführen, werten
+    if (bench.wants("score/grade")) {
+        const char* solutions[] = {
+            "LOOP_START:3 MOVE_FORWARD LOOP_END TURN_RIGHT LOOP_START:3 MOVE_FORWARD LOOP_END",
+            "MOVE_FORWARD TURN_LEFT MOVE_FORWARD",
+            "LOOP_START:4 MOVE_FORWARD LOOP_END",
+        };
+        std::vector<Submission> submissions;
+        for (int i = 0; i < 3000; i++) {
+            Submission submission{i % 3 + 1, {}};
+            parseProgram(solutions[i % 3], submission.program);
+            submissions.push_back(std::move(submission));
+        }
+        ThreadPool pool(1);
+        Grader grader(pool);
+        double seconds = bestOf(5, [&] {
+            sink = sink + grader.grade(submissions).size();
+        });
+        bench.add("score/grade", "us/submission", seconds * 1e6 / submissions.size());
+    }
+}
+
+bool readBaseline(const std::string& path, std::map<std::string, double>& outValues) {
+    std::ifstream file(path);
+    if (!file) {
+        return false;
+    }
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream stream(line);
+        std::string name;
+        std::string unit;
+        std::string value;
+        if (!std::getline(stream, name, ',') || !std::getline(stream, unit, ',') ||
+            !std::getline(stream, value, ',') || name == "name") {
+            continue;
+        }
+        outValues[name] = std::atof(value.c_str());
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string baselinePath;
+    std::string savePath;
+    std::string filter;
+    std::string packPath = CODINI_LEVEL_PACK;
+    double tolerance = 0.25;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+            baselinePath = argv[++i];
+        } else if (std::strcmp(argv[i], "--save") == 0 && i + 1 < argc) {
+            savePath = argv[++i];
+        } else if (std::strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc) {
+            tolerance = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (std::strcmp(argv[i], "--levels") == 0 && i + 1 < argc) {
+            packPath = argv[++i];
+        } else {
+            std::fprintf(stderr, "Aufruf: %s [--baseline Datei] [--save Datei] [--tolerance Anteil] "
+                                 "[--filter Text] [--levels Paket]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    std::map<std::string, double> baseline;
+    if (!baselinePath.empty() && !readBaseline(baselinePath, baseline)) {
+        std::fprintf(stderr, "Baseline kann nicht gelesen werden: %s\n", baselinePath.c_str());
+        return 2;
+    }
+
+    Bench bench(filter);
+    benchInterpreter(bench);
+    benchParticles(bench);
+    benchCollision(bench);
+    benchLevelLoad(bench, packPath);
+    benchScoring(bench);
+
+    if (!savePath.empty()) {
+        std::ofstream file(savePath);
+        file << "name,unit,value,baseline,change,status\n";
+        char line[160];
+        for (const auto& result : bench.getResults()) {
+            std::snprintf(line, sizeof(line), "%s,%s,%.4f,,,\n", result.name.c_str(), result.unit,
+                          result.value);
+            file << line;
+        }
+        if (!file) {
+            std::fprintf(stderr, "Baseline kann nicht geschrieben werden: %s\n", savePath.c_str());
+            return 2;
+        }
+    }
+
+    int regressions = 0;
+    std::printf("name,unit,value,baseline,change,status\n");
+    for (const auto& result : bench.getResults()) {
+        auto reference = baseline.find(result.name);
+        if (reference == baseline.end() || reference->second <= 0.0) {
+            std::printf("%s,%s,%.4f,,,%s\n", result.name.c_str(), result.unit, result.value,
+                        baseline.empty() ? "" : "new");
+            continue;
+        }
+        double change = result.value / reference->second - 1.0;
+        const char* status = "ok";
+        if (change > tolerance) {
+            status = "regression";
+            regressions++;
+        } else if (change < -tolerance) {
+            status = "faster";
+        }
+        std::printf("%s,%s,%.4f,%.4f,%+.3f,%s\n", result.name.c_str(), result.unit, result.value,
+                    reference->second, change, status);
+    }
+
+    if (!baseline.empty()) {
+        std::fprintf(stderr, "%d von %zu Werten mehr als %.0f%% langsamer als die Baseline\n",
+                     regressions, bench.getResults().size(), tolerance * 100.0);
+    }
+    return regressions > 0 ? 1 : 0;
+}
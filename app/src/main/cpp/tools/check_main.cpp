@@ -0,0 +1,659 @@
+// Host-Prüfungen für den Spielkern: Regeln und Grenzfälle, die ohne Gerät nachprüfbar sein
+// sollen. Läuft über ctest (Test codini_check) oder direkt.
+//
+// Aufruf: codini_check [--filter Text]
+// Ausgabe: eine Zeile pro Prüfgruppe auf stdout, Fehler mit Datei und Zeile auf stderr.
+// Endcode 1, wenn eine Prüfung fehlschlägt.
+
+#include "Command.h"
+#include "Grader.h"
+#include "Leaderboard.h"
+#include "Profiler.h"
+#include "ProgressStore.h"
+#include "Random.h"
+#include "RecordingGLBackend.h"
+#include "Simulation.h"
+#include "Solver.h"
+#include "SpriteBatch.h"
+
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <set>
+#include <string>
+#include <sys/resource.h>
+#include <thread>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+#define CHECK(condition)                                                                \
+    do {                                                                                \
+        if (!(condition)) {                                                             \
+            std::fprintf(stderr, "%s:%d: Prüfung fehlgeschlagen: %s\n", __FILE__, __LINE__, \
+                         #condition);                                                   \
+            failures++;                                                                 \
+        }                                                                               \
+    } while (false)
+
+std::vector<Command> program(const char* text) {
+    std::vector<Command> commands;
+    if (!parseProgram(text, commands)) {
+        std::fprintf(stderr, "Unbekannter Befehl in: %s\n", text);
+        failures++;
+    }
+    return commands;
+}
+
+// Box im Testlevel: Feld und Blickrichtung in Grad (0 = +x, 90 = +y)
+struct BoxSpec {
+    int x, y;
+    float rotation;
+};
+
+// Level nur aus Boxen und einem unerreichbaren Ziel, damit kein Programm versehentlich gewinnt
+Level makeLevel(const std::vector<BoxSpec>& boxes) {
+    Level level;
+    for (const BoxSpec& spec : boxes) {
+        GameObject box{Position{static_cast<float>(spec.x), static_cast<float>(spec.y)},
+                       1.0f, 1.0f, false, false};
+        box.rotation = spec.rotation;
+        level.boxes.push_back(box);
+    }
+    level.targets.push_back({Position{8.0f, 8.0f}, 0.5f, 0.5f, true, false});
+    return level;
+}
+
+// Führt einen einzelnen Befehl mit der ersten Box aus
+StepEvent stepOnce(const std::vector<BoxSpec>& boxes, const char* command) {
+    Simulation simulation;
+    simulation.loadLevel(makeLevel(boxes));
+    StepEvent event{};
+    CHECK(simulation.loadProgram(program(command)));
+    CHECK(simulation.step(&event));
+    return event;
+}
+
+// Ein Takt im Parallelbetrieb, alle Boxen gehen einen Schritt vorwärts
+std::vector<StepEvent> moveAllOnce(const std::vector<BoxSpec>& boxes) {
+    Simulation simulation;
+    simulation.loadLevel(makeLevel(boxes));
+    std::vector<StepEvent> events;
+    CHECK(simulation.loadParallelPrograms({program("MOVE_FORWARD")}));
+    CHECK(simulation.stepRound(&events) == static_cast<int>(boxes.size()));
+    CHECK(events.size() == boxes.size());
+    return events;
+}
+
+// Verschachtelte Schleifen um einen leeren Rumpf erzeugen nie eine Aktion, die VM muss trotzdem
+// zurückkehren statt den Aufrufer festzuhalten
+void checkVmControlLimit() {
+    GameModel model;
+    Simulation simulation;
+    simulation.loadLevel(model.createLevel(1));
+    CHECK(simulation.loadProgram(program(
+            "LOOP_START:999 LOOP_START:999 LOOP_START:999 LOOP_START:999 IF_PATH_AHEAD IF_END "
+            "LOOP_END LOOP_END LOOP_END LOOP_END")));
+    RunResult result = simulation.run();
+    CHECK(result.faulted);
+    CHECK(!result.solved);
+    CHECK(result.actionsExecuted == 0);
+
+    // Lange, aber endliche Strecken ohne Aktion bleiben erlaubt
+    CHECK(simulation.loadProgram(program("LOOP_START:999 IF_TARGET_NEARBY IF_END LOOP_END TURN_LEFT")));
+    result = simulation.run();
+    CHECK(!result.faulted);
+    CHECK(result.actionsExecuted == 1);
+}
+
+// Funktionsnummern jenseits von int16 dürfen beim Auflösen nicht auf eine andere Nummer fallen
+void checkVmFunctionIds() {
+    Program compiled;
+    // 70000 ergibt abgeschnitten 4464
+    CHECK(!ProgramCompiler::compile(program(
+            "FUNCTION_CALL:70000 FUNCTION_DEF:4464 TURN_LEFT FUNCTION_END"), compiled));
+    CHECK(!compiled.error.empty());
+
+    GameModel model;
+    Simulation simulation;
+    simulation.loadLevel(model.createLevel(1));
+    CHECK(simulation.loadProgram(program(
+            "FUNCTION_CALL:70000 FUNCTION_DEF:4464 TURN_LEFT FUNCTION_END "
+            "FUNCTION_DEF:70000 MOVE_FORWARD FUNCTION_END")));
+    CHECK(simulation.step());
+    CHECK(simulation.getBoxes()[0].tile == (TilePos{1, 0}));
+}
+
+// Sprung und Teleport landen nur auf freien Feldern im Spielfeld, übersprungene Felder zählen nicht
+void checkJumpLanding() {
+    StepEvent event = stepOnce({{0, 0, 0.0f}, {1, 0, 0.0f}}, "JUMP");
+    CHECK(event.moved);
+    CHECK(event.to == (TilePos{2, 0}));
+
+    event = stepOnce({{0, 0, 0.0f}, {2, 0, 0.0f}}, "JUMP");
+    CHECK(!event.moved);
+    CHECK(event.to == (TilePos{0, 0}));
+
+    event = stepOnce({{7, 0, 0.0f}}, "JUMP");
+    CHECK(!event.moved);
+
+    event = stepOnce({{5, 0, 0.0f}}, "TELEPORT");
+    CHECK(event.moved);
+    CHECK(event.to == (TilePos{8, 0}));
+
+    event = stepOnce({{6, 0, 0.0f}}, "TELEPORT");
+    CHECK(!event.moved);
+}
+
+// Zwei Boxen wollen auf dasselbe Feld, die mit dem kleineren Index zieht
+void checkParallelSameTarget() {
+    std::vector<StepEvent> events = moveAllOnce({{0, 0, 90.0f}, {0, 2, 270.0f}});
+    CHECK(events[0].moved && events[0].to == (TilePos{0, 1}));
+    CHECK(!events[1].moved && events[1].to == (TilePos{0, 2}));
+}
+
+// Zwei Boxen, die ihre Felder tauschen wollen, bleiben beide stehen
+void checkParallelSwap() {
+    std::vector<StepEvent> events = moveAllOnce({{0, 0, 0.0f}, {1, 0, 180.0f}});
+    CHECK(!events[0].moved && !events[1].moved);
+}
+
+// Eine Box darf auf ein Feld, dessen Box im selben Takt wegzieht, auch im Kreis. Steht die
+// vorderste Box still, bleibt die ganze Reihe stehen.
+void checkParallelTrainAndRing() {
+    std::vector<StepEvent> events = moveAllOnce({{0, 0, 0.0f}, {1, 0, 0.0f}});
+    CHECK(events[0].moved && events[0].to == (TilePos{1, 0}));
+    CHECK(events[1].moved && events[1].to == (TilePos{2, 0}));
+
+    events = moveAllOnce({{0, 0, 0.0f}, {1, 0, 90.0f}, {1, 1, 180.0f}, {0, 1, 270.0f}});
+    for (const StepEvent& event : events) {
+        CHECK(event.moved);
+    }
+    CHECK(events[0].to == (TilePos{1, 0}) && events[3].to == (TilePos{0, 0}));
+
+    events = moveAllOnce({{7, 0, 0.0f}, {8, 0, 0.0f}});
+    CHECK(!events[0].moved && !events[1].moved);
+}
+
+// Ein gemeinsames Programm löst Level 2 nur, wenn alle Boxen es gleichzeitig ausführen
+void checkGraderParallel() {
+    ThreadPool pool(1);
+    Grader grader(pool);
+    Submission serial{2, program("LOOP_START:4 MOVE_FORWARD LOOP_END")};
+    Submission parallel = serial;
+    parallel.parallel = true;
+    std::vector<GradeResult> results = grader.grade({serial, parallel});
+    CHECK(results[0].compiled && !results[0].solved);
+    CHECK(results[1].compiled && results[1].solved);
+    CHECK(results[1].completion.timeSpent == Simulation::secondsFor(4));
+}
+
+// Im Einzelbetrieb ist Level 2 nachweislich unlösbar, parallel reicht eine Schleife
+void checkSolverParallel() {
+    ThreadPool pool(1);
+    GameModel model;
+    Level level = model.createLevel(2);
+    CHECK(Solver(pool).solve(level).unsolvable);
+
+    SolverOptions options;
+    options.parallel = true;
+    SolverResult result = Solver(pool, options).solve(level);
+    CHECK(result.found);
+    CHECK(result.program.size() == 3);
+}
+
+// Mit nur einer Drehrichtung braucht die Gegenrichtung drei gleiche Drehungen, die Suche darf
+// sie nicht als überflüssig verwerfen
+void checkSolverSingleTurn() {
+    ThreadPool pool(1);
+    for (int targetY : {2, 4}) {
+        Level level = makeLevel({{0, 3, 0.0f}});
+        level.targets[0] = {Position{0.0f, static_cast<float>(targetY)}, 0.5f, 0.5f, true, false};
+        level.availableCommands = {CommandType::MOVE_FORWARD, CommandType::TURN_LEFT};
+        SolverResult result = Solver(pool).solve(level);
+        CHECK(result.found);
+        CHECK(result.program.size() == 2 || result.program.size() == 4);
+    }
+}
+
+// Aufgezeichnete Aufrufe eines Typs in Reihenfolge
+std::vector<GLCommand> recorded(const RecordingGLBackend& backend, GLCall call) {
+    std::vector<GLCommand> result;
+    for (const GLCommand& command : backend.getCommands()) {
+        if (command.call == call) {
+            result.push_back(command);
+        }
+    }
+    return result;
+}
+
+// Sprites über mehrere Texturen, Blendmodi und Ebenen: ein Draw-Call pro Zustand, sortiert nach
+// Ebene, Blendmodus und Textur, je Flush ein Verwerfen des Puffers und ein Upload
+void checkSpriteBatch() {
+    RecordingGLBackend backend;
+    SpriteBatch batch(backend, 8);
+    uint32_t vertexBuffer = recorded(backend, GLCall::CREATE_BUFFER).front().a;
+
+    const SpriteState states[] = {
+        {2, BlendMode::ALPHA, 1},
+        {1, BlendMode::ALPHA, 0},
+        {2, BlendMode::ADDITIVE, 0},
+        {1, BlendMode::ALPHA, 0},
+        {2, BlendMode::ALPHA, 1},
+        {3, BlendMode::ALPHA, 0},
+    };
+    backend.clearCommands();
+    batch.begin();
+    for (size_t i = 0; i < 6; i++) {
+        // Die x-Koordinate merkt sich die Reihenfolge beim Vormerken
+        batch.draw(states[i], Sprite{static_cast<float>(i), 0.0f, 1.0f, 1.0f});
+    }
+    batch.end();
+
+    CHECK(batch.getDrawCallCount() == 4);
+    CHECK(batch.getSpriteCount() == 6);
+    CHECK(backend.count(GLCall::BUFFER_DATA) == 1);
+    CHECK(backend.count(GLCall::BUFFER_SUB_DATA) == 1);
+    std::vector<GLCommand> orphans = recorded(backend, GLCall::BUFFER_DATA);
+    CHECK(orphans[0].a == static_cast<uint32_t>(BufferTarget::VERTEX) && orphans[0].d == 0);
+
+    // Ebene 0: Alpha mit Textur 1 und 3, dann additiv; danach Ebene 1
+    std::vector<GLCommand> draws = recorded(backend, GLCall::DRAW_TRIANGLES);
+    CHECK(draws.size() == 4);
+    const size_t expectedDraws[][2] = {{12, 0}, {6, 12}, {6, 18}, {12, 24}};
+    for (size_t i = 0; i < draws.size() && i < 4; i++) {
+        CHECK(draws[i].c == expectedDraws[i][0] && draws[i].d == expectedDraws[i][1]);
+    }
+
+    // Gleiche Textur in aufeinanderfolgenden Zuständen wird nicht neu gebunden
+    std::vector<GLCommand> textures = recorded(backend, GLCall::BIND_TEXTURE);
+    CHECK(textures.size() == 3 && textures[0].a == 1 && textures[1].a == 3 && textures[2].a == 2);
+    CHECK(backend.count(GLCall::SET_BLEND_MODE) == 3);
+
+    // Innerhalb eines Zustands bleibt die Reihenfolge beim Vormerken erhalten
+    const std::vector<uint8_t>& contents = backend.getBufferContents(vertexBuffer);
+    const float expectedOrder[] = {1, 3, 5, 2, 0, 4};
+    CHECK(contents.size() >= 6 * 4 * sizeof(SpriteVertex));
+    for (size_t i = 0; i < 6 && contents.size() >= 6 * 4 * sizeof(SpriteVertex); i++) {
+        SpriteVertex vertex;
+        std::memcpy(&vertex, contents.data() + i * 4 * sizeof(SpriteVertex), sizeof(vertex));
+        CHECK(vertex.x - 0.5f == expectedOrder[i]);
+    }
+
+    // Voller Batch zeichnet vorher automatisch, jeder Flush verwirft und lädt genau einmal
+    SpriteBatch small(backend, 4);
+    backend.clearCommands();
+    small.begin();
+    for (int i = 0; i < 6; i++) {
+        small.draw(states[1], Sprite{0.0f, 0.0f, 1.0f, 1.0f});
+    }
+    small.end();
+    CHECK(small.getDrawCallCount() == 2);
+    CHECK(backend.count(GLCall::BUFFER_DATA) == 2);
+    CHECK(backend.count(GLCall::BUFFER_SUB_DATA) == 2);
+}
+
+// Sync-Threads ändern Profile über GameModel::updateUser: Bestenliste und Speicher sehen danach
+// denselben Stand wie die Registry
+void checkUpdateUserFromThreads() {
+    char pattern[] = "/tmp/codini_check_XXXXXX";
+    const char* directory = mkdtemp(pattern);
+    CHECK(directory != nullptr);
+    if (!directory) {
+        return;
+    }
+
+    const char* names[] = {"anna", "ben"};
+    {
+        GameModel model;
+        CHECK(model.openProgressStore(directory));
+        for (const char* name : names) {
+            CHECK(model.registerUser(name, "geheim"));
+        }
+
+        // Ein Thread pro Benutzer
+        std::vector<std::thread> threads;
+        for (const char* name : names) {
+            threads.emplace_back([&model, name] {
+                UserRegistry::Handle user = model.findUser(name);
+                for (int i = 0; i < 200; i++) {
+                    model.updateUser(user, [&](UserProfile& profile) {
+                        profile.progress.totalScore += 1;
+                        profile.progress.levelScores[1 + i % 4] = i;
+                    });
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        std::vector<LeaderboardEntry> top = model.getLeaderboard().top(2);
+        CHECK(top.size() == 2);
+        for (const LeaderboardEntry& entry : top) {
+            CHECK(entry.score == 200);
+            CHECK(entry.score == model.findUser(entry.username).read()->progress.totalScore);
+        }
+        CHECK(model.getLeaderboard().topForLevel(4, 1).front().score == 199);
+        model.flushProgress();
+    }
+
+    GameModel reopened;
+    CHECK(reopened.openProgressStore(directory));
+    for (const char* name : names) {
+        UserRegistry::Handle user = reopened.findUser(name);
+        CHECK(user.isValid() && user.read()->progress.totalScore == 200);
+    }
+    std::filesystem::remove_all(directory);
+}
+
+// Mehrere Sync-Threads auf denselben Profilen: die Bestenliste darf keinen älteren Stand
+// behalten, wenn zwei Änderungen desselben Profils sich überholen
+void checkUpdateUserContention() {
+    GameModel model;
+    const char* names[] = {"carla", "dana"};
+    for (const char* name : names) {
+        CHECK(model.registerUser(name, "geheim"));
+    }
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&model, &names] {
+            for (int i = 0; i < 500; i++) {
+                for (const char* name : names) {
+                    model.updateUser(model.findUser(name), [](UserProfile& profile) {
+                        profile.progress.totalScore += 1;
+                        profile.progress.levelScores[1] = profile.progress.totalScore;
+                    });
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (const LeaderboardEntry& entry : model.getLeaderboard().top(2)) {
+        CHECK(entry.score == 2000);
+    }
+    for (const LeaderboardEntry& entry : model.getLeaderboard().topForLevel(1, 2)) {
+        CHECK(entry.score == 2000);
+    }
+}
+
+UserProfile scoredProfile(const std::string& username, int total, int level1) {
+    UserProfile profile;
+    profile.username = username;
+    profile.progress = UserProgress{1, total, {{1, level1}}, {}, 0};
+    return profile;
+}
+
+// Ein nur teilweise geschriebener Logeintrag (hier per Dateigrößen-Limit erzwungen) wird wieder
+// abgeschnitten, spätere Einträge bleiben beim nächsten Öffnen erhalten
+void checkStoreTornAppend() {
+    char pattern[] = "/tmp/codini_check_XXXXXX";
+    const char* directory = mkdtemp(pattern);
+    CHECK(directory != nullptr);
+    if (!directory) {
+        return;
+    }
+
+    std::map<std::string, UserProfile> users;
+    {
+        ProgressStore store;
+        CHECK(store.open(directory, users));
+        CHECK(store.appendProfile(scoredProfile("anna", 10, 10)));
+        size_t goodBytes = store.getWalBytes();
+
+        rlimit previous{};
+        getrlimit(RLIMIT_FSIZE, &previous);
+        rlimit limited = previous;
+        limited.rlim_cur = goodBytes + 16;
+        auto previousHandler = std::signal(SIGXFSZ, SIG_IGN);
+        setrlimit(RLIMIT_FSIZE, &limited);
+        bool appended = store.appendProfile(scoredProfile(std::string(4096, 'x'), 20, 20));
+        setrlimit(RLIMIT_FSIZE, &previous);
+        std::signal(SIGXFSZ, previousHandler);
+
+        CHECK(!appended);
+        CHECK(store.getWalBytes() == goodBytes);
+        CHECK(std::filesystem::file_size(std::string(directory) + "/progress.wal") == goodBytes);
+        CHECK(store.appendProfile(scoredProfile("ben", 30, 30)));
+    }
+
+    ProgressStore reopened;
+    users.clear();
+    CHECK(reopened.open(directory, users));
+    CHECK(users.size() == 2);
+    CHECK(users.count("anna") == 1 && users.count("ben") == 1);
+    reopened.close();
+    std::filesystem::remove_all(directory);
+}
+
+// Erwartete Rangliste: höhere Punkte zuerst, bei Gleichstand alphabetisch
+struct ReferenceBoard {
+    std::set<std::pair<int, std::string>> order;  // (-Punkte, Name)
+    std::map<std::string, int> scores;
+
+    void set(const std::string& username, int score) {
+        auto it = scores.find(username);
+        if (it != scores.end()) {
+            order.erase({-it->second, username});
+        }
+        scores[username] = score;
+        order.insert({-score, username});
+    }
+
+    int rankOf(const std::string& username) const {
+        auto it = scores.find(username);
+        if (it == scores.end()) {
+            return 0;
+        }
+        int better = 0;
+        for (const auto& entry : order) {
+            better += -entry.first > it->second ? 1 : 0;
+        }
+        return better + 1;
+    }
+
+    bool matchesTop(const std::vector<LeaderboardEntry>& top, size_t count) const {
+        if (top.size() != std::min(count, order.size())) {
+            return false;
+        }
+        auto it = order.begin();
+        for (const LeaderboardEntry& entry : top) {
+            if (entry.username != it->second || entry.score != -it->first ||
+                entry.rank != rankOf(entry.username)) {
+                return false;
+            }
+            ++it;
+        }
+        return true;
+    }
+};
+
+// Zufällige Änderungen mit vielen Gleichständen, nach jeder Änderung gegen std::set geprüft
+void checkLeaderboardFuzz() {
+    Leaderboard board;
+    ReferenceBoard total;
+    ReferenceBoard level;
+    FastRandom random(7);
+    for (int i = 0; i < 3000; i++) {
+        std::string username = "s" + std::to_string(random.rangeInt(0, 59));
+        int score = random.rangeInt(0, 25);
+        int levelScore = random.rangeInt(0, 25);
+        board.update(scoredProfile(username, score, levelScore), 1);
+        total.set(username, score);
+        level.set(username, levelScore);
+
+        size_t count = static_cast<size_t>(random.rangeInt(0, 70));
+        CHECK(total.matchesTop(board.top(count), count));
+        CHECK(level.matchesTop(board.topForLevel(1, count), count));
+        CHECK(board.rankOf(username) == total.rankOf(username));
+        CHECK(board.rankForLevel(1, username) == level.rankOf(username));
+    }
+    CHECK(board.size() == total.scores.size());
+    CHECK(board.rankOf("niemand") == 0);
+}
+
+// Eine Klasse von 500 Schülern: jeder Rang gegen Abzählen aller besseren Punktzahlen
+void checkLeaderboardClass() {
+    Leaderboard board;
+    FastRandom random(11);
+    std::vector<UserProfile> profiles;
+    for (int i = 0; i < 500; i++) {
+        profiles.push_back(scoredProfile("schueler" + std::to_string(i), random.rangeInt(0, 1000),
+                                         random.rangeInt(0, 300)));
+        board.update(profiles.back(), 1);
+    }
+
+    for (const UserProfile& profile : profiles) {
+        int betterTotal = 0;
+        int betterLevel = 0;
+        for (const UserProfile& other : profiles) {
+            betterTotal += other.progress.totalScore > profile.progress.totalScore ? 1 : 0;
+            betterLevel += other.progress.levelScores.at(1) > profile.progress.levelScores.at(1) ? 1 : 0;
+        }
+        CHECK(board.rankOf(profile.username) == betterTotal + 1);
+        CHECK(board.rankForLevel(1, profile.username) == betterLevel + 1);
+    }
+
+    std::vector<LeaderboardEntry> top = board.top(500);
+    CHECK(top.size() == 500);
+    for (size_t i = 1; i < top.size(); i++) {
+        CHECK(top[i - 1].score > top[i].score ||
+              (top[i - 1].score == top[i].score && top[i - 1].username < top[i].username));
+    }
+}
+
+// Ausgeschaltet ab Werk; beendete Threads geben ihren Puffer an den nächsten Thread weiter
+void checkProfilerRings() {
+    Profiler profiler;
+    CHECK(!profiler.isEnabled());
+
+    for (int i = 0; i < 3; i++) {
+        std::thread([&profiler] { profiler.record("check", 1, 2); }).join();
+    }
+    std::vector<ProfileEvent> events = profiler.collect();
+    CHECK(events.size() == 3);
+    for (const ProfileEvent& event : events) {
+        CHECK(event.threadId == events.front().threadId);
+    }
+
+    // Lebende Threads haben weiter jeder einen eigenen Puffer
+    profiler.record("check", 3, 4);
+    std::thread([&profiler] { profiler.record("check", 5, 6); }).join();
+    events = profiler.collect();
+    CHECK(events.size() == 5);
+    CHECK(events[3].threadId != events[4].threadId);
+}
+
+// Level über das 9x9-Feld hinaus vergrößern das Spielfeld, ein kleineres Level danach verkleinert es
+void checkLargeLevel() {
+    Level level = makeLevel({{12, 12, 0.0f}});
+    level.targets[0].position = Position{13.0f, 12.0f};
+    Simulation simulation;
+    simulation.loadLevel(level);
+    CHECK(simulation.getTiles().getWidth() == 14);
+    CHECK(simulation.getTiles().getHeight() == 13);
+    CHECK(simulation.isValidPosition(TilePos{13, 12}));
+    CHECK(!simulation.isValidPosition(TilePos{14, 12}));
+    CHECK(!simulation.isValidPosition(TilePos{13, 13}));
+    CHECK(simulation.loadProgram(program("MOVE_FORWARD")));
+    RunResult result = simulation.run();
+    CHECK(result.solved);
+
+    // Am Rand des vergrößerten Feldes bleibt die Box stehen
+    CHECK(simulation.loadProgram(program("MOVE_FORWARD MOVE_FORWARD")));
+    simulation.reset();
+    StepEvent event{};
+    CHECK(simulation.step(&event));
+    CHECK(simulation.step(&event));
+    CHECK(!event.moved);
+
+    simulation.loadLevel(makeLevel({{0, 0, 0.0f}}));
+    CHECK(simulation.getTiles().getWidth() == Simulation::FIELD_WIDTH + 1);
+    CHECK(!simulation.isValidPosition(TilePos{Simulation::FIELD_WIDTH + 1, 0}));
+}
+
+// Level neu laden (Zurücksetzen im Editor) darf ein angehaltenes Programm nicht neu starten
+void checkLoadLevelKeepsProgramHalted() {
+    GameModel model;
+    Level level = model.createLevel(1);
+    Simulation simulation;
+    simulation.loadLevel(level);
+    CHECK(simulation.loadProgram(program("MOVE_FORWARD MOVE_FORWARD")));
+    CHECK(simulation.step());
+    simulation.stopProgram();
+    simulation.loadLevel(level);
+    CHECK(!simulation.isRunning());
+    CHECK(!simulation.step());
+
+    // Auch ohne vorheriges Anhalten und im Parallelbetrieb
+    CHECK(simulation.loadParallelPrograms({program("MOVE_FORWARD")}));
+    simulation.loadLevel(model.createLevel(2));
+    CHECK(!simulation.isRunning());
+    CHECK(simulation.stepRound() == 0);
+
+    // reset() startet das Programm dagegen von vorn
+    simulation.reset();
+    CHECK(simulation.isRunning());
+}
+
+struct CheckCase {
+    const char* name;
+    void (*run)();
+};
+
+const CheckCase kCases[] = {
+    {"vm/control_limit", checkVmControlLimit},
+    {"vm/function_ids", checkVmFunctionIds},
+    {"simulation/jump_landing", checkJumpLanding},
+    {"simulation/large_level", checkLargeLevel},
+    {"simulation/load_level_halts", checkLoadLevelKeepsProgramHalted},
+    {"parallel/same_target", checkParallelSameTarget},
+    {"parallel/swap", checkParallelSwap},
+    {"parallel/train_ring", checkParallelTrainAndRing},
+    {"grader/parallel", checkGraderParallel},
+    {"solver/parallel", checkSolverParallel},
+    {"solver/single_turn", checkSolverSingleTurn},
+    {"render/sprite_batch", checkSpriteBatch},
+    {"model/update_user_threads", checkUpdateUserFromThreads},
+    {"model/update_user_contention", checkUpdateUserContention},
+    {"store/torn_append", checkStoreTornAppend},
+    {"leaderboard/fuzz", checkLeaderboardFuzz},
+    {"leaderboard/class_of_500", checkLeaderboardClass},
+    {"profiler/rings", checkProfilerRings},
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string filter;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            filter = argv[++i];
+        } else {
+            std::fprintf(stderr, "Aufruf: %s [--filter Text]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    int run = 0;
+    for (const CheckCase& check : kCases) {
+        if (!filter.empty() && std::string(check.name).find(filter) == std::string::npos) {
+            continue;
+        }
+        int before = failures;
+        check.run();
+        run++;
+        std::printf("%-32s %s\n", check.name, failures == before ? "ok" : "FEHLER");
+    }
+    std::printf("%d Prüfgruppen, %d Fehler\n", run, failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,100 @@
+// Kommandozeilen-Bewerter für eingereichte Codini-Programme.
+//
+// Eingabe: eine Lösung pro Zeile, "<Level> <Befehle...>", z.B.
+//     1 LOOP_START:3 MOVE_FORWARD LOOP_END TURN_RIGHT
+// Ein "P" direkt nach der Levelnummer lässt alle Boxen das Programm gleichzeitig ausführen:
+//     2P LOOP_START:4 MOVE_FORWARD LOOP_END
+// Leere Zeilen und Zeilen mit '#' am Anfang werden übersprungen.
+//
+// Aufruf: codini_grade [--threads N] [Datei]   (ohne Datei wird stdin gelesen)
+// Ausgabe: CSV auf stdout, Zusammenfassung auf stderr.
+
+#include "Grader.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+int main(int argc, char** argv) {
+    unsigned threads = 0;
+    const char* inputPath = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = static_cast<unsigned>(std::atoi(argv[++i]));
+        } else if (argv[i][0] == '-' && argv[i][1] != '\0') {
+            std::fprintf(stderr, "Aufruf: %s [--threads N] [Datei]\n", argv[0]);
+            return 2;
+        } else {
+            inputPath = argv[i];
+        }
+    }
+
+    std::ifstream file;
+    if (inputPath && std::strcmp(inputPath, "-") != 0) {
+        file.open(inputPath);
+        if (!file) {
+            std::fprintf(stderr, "Datei kann nicht gelesen werden: %s\n", inputPath);
+            return 1;
+        }
+    }
+    std::istream& input = file.is_open() ? static_cast<std::istream&>(file) : std::cin;
+
+    // Lösungen einlesen
+    std::vector<Submission> submissions;
+    std::vector<bool> parsed;
+    std::string line;
+    while (std::getline(input, line)) {
+        size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#') {
+            continue;
+        }
+
+        std::istringstream stream(line);
+        Submission submission{0, {}};
+        std::string program;
+        bool ok = static_cast<bool>(stream >> submission.levelNumber);
+        if (ok && stream.peek() == 'P') {
+            stream.get();
+            submission.parallel = true;
+        }
+        std::getline(stream, program);
+        if (!ok || !parseProgram(program, submission.program)) {
+            ok = false;
+            submission.program.clear();
+        }
+        parsed.push_back(ok);
+        submissions.push_back(std::move(submission));
+    }
+
+    ThreadPool pool(threads);
+    Grader grader(pool);
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<GradeResult> results = grader.grade(submissions);
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("index,level,parallel,valid,solved,score,stars,commands,time,optimal\n");
+    size_t solved = 0;
+    for (size_t i = 0; i < results.size(); i++) {
+        const GradeResult& result = results[i];
+        const LevelCompletion& completion = result.completion;
+        bool valid = parsed[i] && result.compiled;
+        solved += result.solved ? 1 : 0;
+        std::printf("%zu,%d,%d,%d,%d,%d,%d,%d,%.1f,%d\n",
+                    i, submissions[i].levelNumber, submissions[i].parallel ? 1 : 0,
+                    valid ? 1 : 0, result.solved ? 1 : 0,
+                    completion.score, completion.stars, completion.commandsUsed,
+                    completion.timeSpent, completion.isOptimalSolution ? 1 : 0);
+    }
+
+    std::fprintf(stderr, "%zu Lösungen bewertet, %zu gelöst, %.3f s mit %u Threads (%.0f/s)\n",
+                 results.size(), solved, elapsed, pool.getWorkerCount(),
+                 elapsed > 0 ? results.size() / elapsed : 0.0);
+    return 0;
+}
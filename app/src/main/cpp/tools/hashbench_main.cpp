@@ -0,0 +1,84 @@
+// Misst SHA-256 und den Passwort-Hash (PBKDF2) für jede verfügbare Implementierung und schlägt
+// eine Iterationszahl vor, die in das Latenzbudget einer Anmeldung passt.
+//
+// Aufruf: codini_hashbench [--budget-ms N]
+// Auf dem Tablet mit der Host-Toolchain des NDK übersetzen und dort ausführen, die Werte vom
+// Entwicklungsrechner sind nicht übertragbar.
+
+#include "PasswordHash.h"
+#include "Sha256.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Bester von mehreren Durchläufen, damit Takthochlauf und Störungen nicht mitgemessen werden
+template<typename Function>
+double bestOf(int runs, Function&& function) {
+    double best = 1e30;
+    for (int run = 0; run < runs; run++) {
+        Clock::time_point start = Clock::now();
+        function();
+        best = std::min(best, secondsSince(start));
+    }
+    return best;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    double budgetMs = 250.0;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--budget-ms") == 0 && i + 1 < argc) {
+            budgetMs = std::atof(argv[++i]);
+        } else {
+            std::fprintf(stderr, "Aufruf: %s [--budget-ms N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    const Sha256::Backend detected = Sha256::getBackend();
+    std::printf("Erkannt: %s\n\n", Sha256::backendName(detected));
+
+    std::vector<uint8_t> data(4 << 20, 0x5a);
+    const uint32_t probeIterations = 20000;
+    const char password[] = "parola";
+    const uint8_t salt[16] = {};
+    volatile uint8_t sink = 0;
+
+    for (Sha256::Backend backend : {Sha256::Backend::PORTABLE, Sha256::Backend::SHA_NI,
+                                    Sha256::Backend::ARMV8}) {
+        if (!Sha256::setBackend(backend)) {
+            continue;
+        }
+        double hashSeconds = bestOf(5, [&] {
+            sink = sink + Sha256::hash(data.data(), data.size())[0];
+        });
+        double kdfSeconds = bestOf(5, [&] {
+            sink = sink + pbkdf2Sha256(password, sizeof(password) - 1, salt, sizeof(salt),
+                                       probeIterations)[0];
+        });
+
+        double perIterationUs = kdfSeconds * 1e6 / probeIterations;
+        auto budgetIterations = static_cast<unsigned long>(budgetMs * 1000.0 / perIterationUs);
+        std::printf("%-9s SHA-256 %7.1f MB/s   PBKDF2 %.3f us/Iteration   %.1f ms bei %u\n"
+                    "          Budget %.0f ms: bis %lu Iterationen\n",
+                    Sha256::backendName(backend), data.size() / hashSeconds / 1e6,
+                    perIterationUs, perIterationUs * kDefaultPasswordIterations / 1000.0,
+                    kDefaultPasswordIterations, budgetMs, budgetIterations);
+    }
+
+    Sha256::setBackend(detected);
+    return 0;
+}
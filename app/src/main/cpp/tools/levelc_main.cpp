@@ -0,0 +1,61 @@
+// Übersetzt Level aus der Textquelle in ein binäres Level-Paket (Format in LevelPack.h).
+//
+// Aufruf: codini_levelc <Quelle.txt> <Ausgabe.pack>
+// Das geschriebene Paket wird anschließend wieder geöffnet und Level für Level geprüft.
+
+#include "LevelPack.h"
+#include "LevelPackBuilder.h"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        std::fprintf(stderr, "Aufruf: %s <Quelle.txt> <Ausgabe.pack>\n", argv[0]);
+        return 2;
+    }
+
+    std::ifstream source(argv[1]);
+    if (!source) {
+        std::fprintf(stderr, "Datei kann nicht gelesen werden: %s\n", argv[1]);
+        return 1;
+    }
+
+    std::vector<LevelDefinition> levels;
+    std::vector<uint8_t> pack;
+    std::string error;
+    if (!parseLevelSource(source, levels, error)) {
+        std::fprintf(stderr, "%s:%s\n", argv[1], error.c_str());
+        return 1;
+    }
+    if (!buildLevelPack(levels, pack, error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+
+    std::ofstream output(argv[2], std::ios::binary | std::ios::trunc);
+    output.write(reinterpret_cast<const char*>(pack.data()), static_cast<std::streamsize>(pack.size()));
+    output.close();
+    if (!output) {
+        std::fprintf(stderr, "Datei kann nicht geschrieben werden: %s\n", argv[2]);
+        return 1;
+    }
+
+    // Gegenprobe über denselben Lesepfad wie im Spiel
+    LevelPack reader;
+    if (!reader.openFile(argv[2], &error)) {
+        std::fprintf(stderr, "%s: %s\n", argv[2], error.c_str());
+        return 1;
+    }
+    for (const auto& level : levels) {
+        LevelView view;
+        if (!reader.find(level.levelNumber, view)) {
+            std::fprintf(stderr, "Level %d fehlt im Paket\n", level.levelNumber);
+            return 1;
+        }
+    }
+
+    std::printf("%zu Level, %zu Bytes -> %s\n", levels.size(), pack.size(), argv[2]);
+    return 0;
+}
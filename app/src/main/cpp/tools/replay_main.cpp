@@ -0,0 +1,147 @@
+// Rechnet aufgezeichnete Spielsitzungen (last_session.crpl aus dem App-Speicher) ohne Grafik
+// nach und meldet die erste Abweichung von der Aufzeichnung.
+//
+// Aufruf: codini_replay [--repeat N] Datei...
+//         codini_replay --record [--parallel] Datei Level "Befehle..."
+// Mit --repeat wird jede Aufzeichnung N-mal nachgerechnet und der Durchsatz ausgegeben.
+// --record schreibt eine Sitzung, in der das Programm einmal bis zum Ende läuft, z.B. als
+// Referenz für Regressionstests; mit --parallel führen alle Boxen das Programm gleichzeitig aus.
+// Endcode 1, wenn eine Aufzeichnung abweicht oder unlesbar ist.
+
+#include "ReplayLog.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+int record(const char* path, int levelNumber, const char* programText, bool parallel) {
+    std::vector<Command> program;
+    if (!parseProgram(programText, program)) {
+        std::fprintf(stderr, "Unbekannter Befehl in: %s\n", programText);
+        return 2;
+    }
+
+    GameModel model;
+    Level level = model.createLevel(levelNumber, GameModel::kDefaultLevelSeed);
+    if (level.boxes.empty()) {
+        std::fprintf(stderr, "Unbekanntes Level: %d\n", levelNumber);
+        return 2;
+    }
+
+    // Ein Befehl pro Schritt eingeben, danach im Spieltakt ausführen
+    const int rate = 60;
+    const uint64_t stepsPerAction = static_cast<uint64_t>(rate * Simulation::kSecondsPerAction);
+    ReplayRecorder recorder;
+    recorder.begin(rate);
+    uint64_t tick = 0;
+    recorder.levelStarted(tick, levelNumber, GameModel::kDefaultLevelSeed);
+    for (const auto& command : program) {
+        recorder.commandAdded(++tick, command);
+    }
+
+    Simulation simulation;
+    simulation.loadLevel(level);
+    bool loaded = parallel ? simulation.loadParallelPrograms({program})
+                           : simulation.loadProgram(program);
+    if (!loaded) {
+        std::fprintf(stderr, "Programm ungültig: %s\n", simulation.getProgram().error.c_str());
+        return 1;
+    }
+    recorder.executionStarted(++tick, parallel);
+    RunResult result = simulation.run();
+    tick += result.rounds * stepsPerAction;
+    if (result.solved) {
+        recorder.levelCompleted(tick, result.actionsExecuted, simulation.stateHash());
+    } else {
+        recorder.executionStopped(tick, result.actionsExecuted);
+    }
+
+    std::string error;
+    if (!recorder.save(path, &error)) {
+        std::fprintf(stderr, "%s: %s\n", path, error.c_str());
+        return 1;
+    }
+    std::printf("%s: %zu Ereignisse, %zu Byte, %d Aktionen in %d Takten, %s\n", path,
+                recorder.getEventCount(), recorder.serialize().size(), result.actionsExecuted,
+                result.rounds, result.solved ? "gelöst" : "nicht gelöst");
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int repeat = 1;
+    std::vector<const char*> paths;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+            repeat = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--record") == 0 && i + 3 < argc) {
+            bool parallel = std::strcmp(argv[i + 1], "--parallel") == 0;
+            if (parallel && i + 4 >= argc) {
+                break;
+            }
+            int first = parallel ? i + 2 : i + 1;
+            return record(argv[first], std::atoi(argv[first + 1]), argv[first + 2], parallel);
+        } else if (argv[i][0] == '-') {
+            std::fprintf(stderr, "Aufruf: %s [--repeat N] Datei...\n"
+                                 "       %s --record [--parallel] Datei Level \"Befehle...\"\n",
+                         argv[0], argv[0]);
+            return 2;
+        } else {
+            paths.push_back(argv[i]);
+        }
+    }
+    if (paths.empty()) {
+        std::fprintf(stderr, "Aufruf: %s [--repeat N] Datei...\n", argv[0]);
+        return 2;
+    }
+
+    bool allConsistent = true;
+    ReplayPlayer player;
+    for (const char* path : paths) {
+        Replay replay;
+        std::string error;
+        if (!loadReplay(path, replay, &error)) {
+            std::fprintf(stderr, "%s: %s\n", path, error.c_str());
+            allConsistent = false;
+            continue;
+        }
+
+        ReplayResult result;
+        auto start = std::chrono::steady_clock::now();
+        for (int run = 0; run < repeat; run++) {
+            result = player.play(replay);
+        }
+        double seconds = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start).count();
+
+        double sessionSeconds = static_cast<double>(result.lastTick) / replay.stepsPerSecond;
+        std::printf("%s: %zu Ereignisse, %.1f s Spielzeit, %llu Aktionen, Endzustand %016llx\n",
+                    path, replay.events.size(), sessionSeconds,
+                    static_cast<unsigned long long>(result.actionsSimulated),
+                    static_cast<unsigned long long>(result.finalStateHash));
+        for (const auto& completion : result.completions) {
+            std::printf("    Level %d geschafft nach %d Aktionen%s\n", completion.levelNumber,
+                        completion.actionsExecuted,
+                        completion.solved && completion.hashMatches ? "" : "  <-- ABWEICHUNG");
+        }
+        if (!result.consistent) {
+            std::printf("    ABWEICHUNG %s\n", result.divergence.c_str());
+            allConsistent = false;
+        }
+        if (repeat > 1) {
+            std::printf("    %d Durchläufe in %.3f s, %.0f Sitzungen/s, %.0f Aktionen/s\n",
+                        repeat, seconds, repeat / seconds,
+                        static_cast<double>(result.actionsSimulated) * repeat / seconds);
+        }
+    }
+
+    return allConsistent ? 0 : 1;
+}
@@ -0,0 +1,137 @@
+// Ermittelt für alle Level die kürzeste Lösung und vergleicht sie mit den eingetragenen Werten
+// (Level::optimalCommandCount im GameModel, LevelCriteria::maxCommands im Level-Paket).
+//
+// Aufruf: codini_solve [--threads N] [--max-length N] [--levels Paket] [--parallel] [--strict]
+// Mit --parallel wird ein gemeinsames Programm für alle Boxen gesucht. Level aus dem GameModel
+// mit mehreren Boxen werden immer parallel gelöst, so wie das Spiel sie ausführt.
+// Mit --strict endet das Programm mit Code 1, wenn ein eingetragener Wert nicht stimmt.
+
+#include "Solver.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace {
+
+std::string formatProgram(const std::vector<Command>& program) {
+    std::string text;
+    for (const auto& command : program) {
+        if (!text.empty()) text += ' ';
+        text += commandName(command.type);
+        if (command.type == CommandType::LOOP_START) {
+            text += ':' + std::to_string(command.loopCount);
+        } else if (command.type == CommandType::FUNCTION_DEF ||
+                   command.type == CommandType::FUNCTION_CALL) {
+            text += ':' + std::to_string(command.functionId);
+        }
+    }
+    return text;
+}
+
+// Gibt das Ergebnis aus, true wenn der eingetragene Wert zur gefundenen Lösung passt.
+// Ein Optimum muss genau stimmen, ein Maximum darf nicht unter dem Optimum liegen.
+bool report(const char* source, int levelNumber, const SolverResult& result,
+            const char* field, int configured, bool isUpperBound, double seconds) {
+    bool matches;
+    if (result.found) {
+        int optimum = static_cast<int>(result.program.size());
+        matches = isUpperBound ? configured >= optimum : configured == optimum;
+        std::printf("%s %d: optimal %d, %s %d%s (%.2f s, %llu Knoten)\n    %s\n",
+                    source, levelNumber, optimum, field, configured,
+                    matches ? "" : "  <-- ABWEICHUNG", seconds,
+                    static_cast<unsigned long long>(result.nodesVisited),
+                    formatProgram(result.program).c_str());
+    } else if (result.unsolvable) {
+        matches = false;
+        std::printf("%s %d: unlösbar, %s %d  <-- ABWEICHUNG\n",
+                    source, levelNumber, field, configured);
+    } else {
+        matches = false;
+        std::printf("%s %d: keine Lösung bis Länge %d, %s %d  <-- ABWEICHUNG (%.2f s, %llu Knoten)\n",
+                    source, levelNumber, result.searchedLength, field, configured, seconds,
+                    static_cast<unsigned long long>(result.nodesVisited));
+    }
+    return matches;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    unsigned threads = 0;
+    bool strict = false;
+    std::string packPath = CODINI_LEVEL_PACK;
+    SolverOptions options;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = static_cast<unsigned>(std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--max-length") == 0 && i + 1 < argc) {
+            options.maxLength = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--levels") == 0 && i + 1 < argc) {
+            packPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--parallel") == 0) {
+            options.parallel = true;
+        } else if (std::strcmp(argv[i], "--strict") == 0) {
+            strict = true;
+        } else {
+            std::fprintf(stderr, "Aufruf: %s [--threads N] [--max-length N] [--levels Paket] [--parallel] "
+                         "[--strict]\n",
+                         argv[0]);
+            return 2;
+        }
+    }
+
+    ThreadPool pool(threads);
+    Solver solver(pool, options);
+    SolverOptions parallelOptions = options;
+    parallelOptions.parallel = true;
+    Solver parallelSolver(pool, parallelOptions);
+    bool allMatch = true;
+
+    auto timed = [](auto&& fn) {
+        auto start = std::chrono::steady_clock::now();
+        SolverResult result = fn();
+        double seconds = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start).count();
+        return std::make_pair(result, seconds);
+    };
+
+    // Level aus dem GameModel, maßgeblich für die Sterne
+    GameModel model;
+    for (int levelNumber = 1; ; levelNumber++) {
+        Level level = model.createLevel(levelNumber);
+        if (level.boxes.empty()) {
+            break;
+        }
+        // Das Spiel führt Level mit mehreren Boxen im Parallelbetrieb aus (Game::startCodeExecution)
+        bool parallel = level.boxes.size() > 1;
+        auto solved = timed([&] { return (parallel ? parallelSolver : solver).solve(level); });
+        const char* source = parallel ? "GameModel parallel" : "GameModel";
+        allMatch &= report(source, levelNumber, solved.first,
+                           "optimalCommandCount", level.optimalCommandCount, false, solved.second);
+    }
+
+    // Level aus dem Level-Paket
+    LevelPack pack;
+    std::string error;
+    if (!pack.openFile(packPath, &error)) {
+        std::fprintf(stderr, "%s: %s\n", packPath.c_str(), error.c_str());
+        return 1;
+    }
+    for (int levelNumber : pack.getLevelNumbers()) {
+        LevelView view;
+        if (!pack.find(levelNumber, view)) {
+            std::printf("LevelPack %d: ungültiger Eintrag  <-- ABWEICHUNG\n", levelNumber);
+            allMatch = false;
+            continue;
+        }
+        auto solved = timed([&] { return solver.solve(view); });
+        allMatch &= report("LevelPack", levelNumber, solved.first,
+                           "maxCommands", view.getMaxCommands(), true, solved.second);
+    }
+
+    return strict && !allMatch ? 1 : 0;
+}